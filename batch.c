@@ -0,0 +1,170 @@
+/****************************************************************************************************
+ * Name: batch.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements non-interactive generation of many mazes at once on a pool of worker threads.*
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for mkdir() under -std=c99
+#include <stdio.h> // for the type "FILE *" and printf(), snprintf(), fopen(), and fclose()
+#include <stdlib.h> // for malloc() and free()
+#include <stdint.h> // for the type "uint64_t"
+#include <stdbool.h> // for the type "bool"
+#include <pthread.h> // for the type "pthread_t" and pthread_create(), pthread_join(), and the mutex functions
+#include <sys/stat.h> // for mkdir()
+#include "shared.h" // for macros, error_check(), status_check(), and seconds_now()
+#include "rng.h" // for "struct rng", rng_seed(), and rng_below()
+#include "generation.h" // for init_generation() and "struct generation_context"
+#include "cache.h" // for draw_cached_maze()
+#include "batch.h" // for "struct batch_job"
+#include "stats.h" // for "struct generation_stats", stats_clear(), stats_merge(), stats_report(), and macros
+
+/* Object-Like Macros */
+#define MAX_PATH 4096
+
+/* Structures */
+// Work shared by the pool: the job, the next maze to hand out, and the running totals of cells and
+// of mazes copied from the cache.
+struct batch_queue
+{
+    const struct batch_job *job;
+    int next;
+    uint64_t cells;
+    int cached;
+    struct generation_stats stats; // every maze's, added together
+    pthread_mutex_t lock;
+};
+
+/* Internal Function Prototypes */
+void *generate_mazes(void *argument);
+
+/******************************************************************************************************
+ * run_batch():    Purpose: Generates a batch of mazes into a directory with no prompts, handing      *
+ *                          whole mazes to a pool of worker threads, then prints the throughput.      *
+ *                 Parameters: const struct batch_job *job --> what to generate, and where            *
+ *                 Return value: none                                                                 *
+ *                 Side effects: - creates the directory if it does not exist                         *
+ *                               - creates or overwrites job->count maze files                        *
+ *                               - starts and joins up to job->threads threads                        *
+ *                               - prints to stdout                                                   *
+ *                               - terminates program if a file cannot be written, or a thread      *
+ *                                 cannot be started                                                  *
+ ******************************************************************************************************/
+void run_batch(const struct batch_job *job)
+// Requires <stdio.h> for printf(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <pthread.h> for pthread_create(), pthread_join(), and the mutex functions,
+//  requires <sys/stat.h> for mkdir(),
+//  requires "shared.h" for error_check() and seconds_now(),
+//  requires "batch.h" for "struct batch_job",
+//  requires "stats.h" for stats_clear(), stats_report(), and macros,
+//  & requires generate_mazes()
+{
+    // Variable declarations:
+    struct batch_queue queue;
+    pthread_t *workers;
+    int threads = job->threads < 1 ? 1 : job->threads > job->count ? job->count : job->threads;
+    double start, elapsed;
+
+    // The directory may already exist, in which case its files are overwritten:
+    (void) mkdir(job->directory, 0777);
+
+    queue.job = job;
+    queue.next = 0;
+    queue.cells = 0;
+    queue.cached = 0;
+    stats_clear(&queue.stats);
+    error_check("pthread_mutex_init()", 0, pthread_mutex_init(&queue.lock, NULL), NULL);
+    workers = malloc((size_t) threads * sizeof(pthread_t));
+    error_check("malloc()", 1, workers != NULL, NULL);
+
+    // Each worker takes the next maze off the queue until none are left:
+    start = seconds_now();
+    for (int k = 0; k < threads; k++)
+        error_check("pthread_create()", 0, pthread_create(&workers[k], NULL, generate_mazes, &queue), NULL);
+    for (int k = 0; k < threads; k++)
+        (void) pthread_join(workers[k], NULL);
+    elapsed = seconds_now() - start;
+    (void) pthread_mutex_destroy(&queue.lock);
+
+    (void) printf("Generated %d mazes (%llu cells) in %s on %d thread%s in %.3f s\n", job->count,
+                  (unsigned long long) queue.cells, job->directory, threads, threads == 1 ? "" : "s", elapsed);
+    (void) printf("%.1f mazes/s, %.0f cells/s\n", job->count / elapsed, queue.cells / elapsed);
+    if (job->cache.directory != NULL)
+        (void) printf("%d of them copied from the cache in %s\n", queue.cached, job->cache.directory);
+    if (job->stats_format != STATS_NONE)
+        stats_report(stdout, &queue.stats, job->stats_format);
+
+    free(workers);
+    return;
+}
+
+
+/***********************************************************************************************************
+ * generate_mazes():    Purpose: Worker thread: generates and writes mazes from the queue until it is      *
+ *                               empty. Maze k is named "maze_<k>.txt" and generated from seed             *
+ *                               job->seed + k, as are its dimensions.                                     *
+ *                      Parameters: void *argument --> the shared "struct batch_queue"                     *
+ *                      Return value: void * --> NULL                                                      *
+ *                      Side effects: - creates or overwrites maze files                                   *
+ *                                    - modifies the queue (under its lock)                                *
+ *                                    - terminates program if a file cannot be written                     *
+ ***********************************************************************************************************/
+void *generate_mazes(void *argument)
+// Requires <stdio.h> for the type "FILE *" and snprintf(), fopen(), and fclose(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <pthread.h> for the mutex functions,
+//  requires "shared.h" for error_check() and status_check(),
+//  requires "rng.h" for "struct rng", rng_seed(), and rng_below(),
+//  requires <stdbool.h> for the type "bool",
+//  requires "generation.h" for init_generation() and "struct generation_context",
+//  requires "cache.h" for draw_cached_maze(),
+//  requires "batch.h" for "struct batch_job",
+//  & requires "stats.h" for stats_merge()
+{
+    // Variable declarations:
+    struct batch_queue *queue = argument;
+    const struct batch_job *job = queue->job;
+    struct generation_context context;
+    struct rng dimensions;
+    char path[MAX_PATH];
+    FILE *maze_file;
+    int k, x, y, range = job->max_dimension - job->min_dimension + 1;
+    uint64_t seed;
+    bool cached;
+
+    for (;;)
+    {
+        (void) pthread_mutex_lock(&queue->lock);
+        k = queue->next < job->count ? queue->next++ : -1;
+        (void) pthread_mutex_unlock(&queue->lock);
+        if (k < 0)
+            break;
+
+        // Dimensions come from a generator of their own, so that the maze itself is exactly
+        //  the one "new --seed" makes at that size:
+        seed = job->seed + (uint64_t) k;
+        rng_seed(&dimensions, seed);
+        x = job->min_dimension + (int) rng_below(&dimensions, range);
+        y = job->min_dimension + (int) rng_below(&dimensions, range);
+
+        (void) snprintf(path, sizeof(path), "%s/maze_%d.txt", job->directory, k);
+        maze_file = fopen(path, "w+");
+        error_check("fopen()", 1, maze_file != NULL, maze_file);
+        init_generation(&context, seed);
+        context.algorithm = job->algorithm;
+        context.threads = 1; // the pool already keeps every thread busy
+        context.encoding = job->encoding;
+        status_check(draw_cached_maze(maze_file, y, x, &context, &job->cache, &cached), maze_file);
+        error_check("fclose()", 0, fclose(maze_file), NULL);
+
+        (void) pthread_mutex_lock(&queue->lock);
+        queue->cells += (uint64_t) x * y;
+        queue->cached += cached;
+        stats_merge(&queue->stats, &context.stats);
+        (void) pthread_mutex_unlock(&queue->lock);
+    }
+
+    return NULL;
+}
+
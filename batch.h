@@ -0,0 +1,37 @@
+/****************************************************************************************************
+ * Name: batch.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for batch.c                                                                 *
+ ****************************************************************************************************/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h> // for the type "uint64_t"
+#include "cache.h" // for "struct maze_cache"
+
+/* Object-Like Macros */
+#define MAX_BATCH 100000000 // most mazes one batch may generate
+
+/* Structures */
+// A night's worth of mazes: maze k is generated from seed seed + k, so any one of them can be
+// re-created with "new --seed", and its width and height are drawn from that seed as well.
+struct batch_job
+{
+    int count;
+    int min_dimension; // smallest width or height
+    int max_dimension; // largest width or height
+    uint64_t seed; // seed of the first maze
+    const char *directory; // where the maze files are written
+    int algorithm; // one of the ALGORITHM_ macros (see generation.h)
+    int threads; // worker threads; each generates whole mazes
+    int encoding; // one of the ENCODING_ macros (see maze_file.h)
+    int stats_format; // one of the STATS_ macros (see stats.h): how to report the mazes' statistics, if at all
+    struct maze_cache cache; // where mazes already generated are copied from, and new ones kept
+};
+
+/* Function Prototypes */
+void run_batch(const struct batch_job *job);
+
+#endif
@@ -0,0 +1,481 @@
+/****************************************************************************************************
+ * Name: bench.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Benchmark executable: times generation, reading, solving, and rendering across a        *
+ *          sweep of maze sizes with fixed seeds, and prints the results as JSON, optionally        *
+ *          compared against a baseline.                                                            *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for setenv() and sysconf() under -std=c99
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <stdio.h> // for the type "FILE *" and printf(), fprintf(), tmpfile(), fopen(), fgets(), fclose(), and rewind()
+#include <stdlib.h> // for malloc(), free(), qsort(), strtoull(), strtod(), and setenv()
+#include <string.h> // for strcmp() and memset()
+#include <stdint.h> // for the type "uint64_t"
+#include <unistd.h> // for sysconf()
+#include "shared.h" // for macros, error_check(), status_check(), seconds_now(), percentile(), and compare_times()
+#include "generation.h" // for init_generation(), draw_maze(), "struct generation_context", and macros
+#include "maze_file.h" // for map_maze(), release_maze(), and "struct maze_header"
+#include "solver.h" // for solve_maze(), "struct solution", and macros
+#include "render.h" // for the incremental renderer, "struct renderer", "struct player_map", and macros
+
+/* Object-Like Macros */
+#define DEFAULT_TRIALS 5
+#define DEFAULT_MAX_SIZE 3162 // the sweep stops here unless told otherwise; a few seconds a stage at most
+#define DEFAULT_SEED 20211219
+#define DEFAULT_TOLERANCE 10.0 // percent by which a median may exceed the baseline's before it fails
+#define MAX_TRIALS 1000
+#define TRIAL_SECONDS 0.05 // each trial repeats a quick stage until it lasts at least about this long
+#define MAX_REPETITIONS 1000000
+#define SWEEP_LENGTH 9
+#define MAX_STAGE 32 // longest stage name, with its terminator
+#define MAX_LINE 512 // longest line of a baseline file
+#define MAX_BASELINE 1024 // results a baseline file may hold
+#define BENCH_ROWS "50" // terminal the render stage draws for, when not run in a terminal
+#define BENCH_COLUMNS "200"
+// Stages, in the order they run at each size (the generation stages are numbered as the ALGORITHM_ macros are):
+#define STAGE_GENERATE_CLASSIC 0
+#define STAGE_GENERATE_TILED 1
+#define STAGE_GENERATE_STREAMING 2
+#define STAGE_GENERATE_BACKTRACKER 3
+#define STAGE_GENERATE_KRUSKAL 4
+#define STAGE_GENERATE_PRIM 5
+#define STAGE_GENERATE_WILSON 6
+#define STAGE_READ 7
+#define STAGE_SOLVE_BFS 8
+#define STAGE_SOLVE_ASTAR 9
+#define STAGE_SOLVE_BIDIRECTIONAL 10
+#define STAGE_RENDER 11
+#define STAGE_COUNT 12
+
+/* Structures */
+struct bench_options
+{
+    int trials;
+    int max_size;
+    uint64_t seed;
+    const char *baseline_filename; // NULL when there is nothing to compare against
+    double tolerance; // percent
+    int threads; // for the tiled generation stage
+};
+
+// One maze of the size under test, generated once (with the classic algorithm) for the stages that
+//  read, solve, or draw a maze; the generation stages write theirs to the scratch file instead.
+struct bench_fixture
+{
+    int size;
+    FILE *maze_file;
+    FILE *scratch;
+    char *maze;
+    struct maze_header header;
+    size_t mapped_length;
+    uint64_t checksum; // accumulated from the stages' work so that none of it can be optimized away
+};
+
+struct baseline_entry
+{
+    char stage[MAX_STAGE];
+    int size;
+    double median;
+};
+
+struct baseline
+{
+    struct baseline_entry entries[MAX_BASELINE];
+    int count;
+};
+
+/* Function Prototypes */
+bool parse_options(int argc, char **argv, struct bench_options *options);
+void open_fixture(struct bench_fixture *fixture, int size, uint64_t seed);
+void close_fixture(struct bench_fixture *fixture);
+void run_stage(int stage, struct bench_fixture *fixture, const struct bench_options *options);
+void load_baseline(const char *filename, struct baseline *baseline);
+double find_baseline(const struct baseline *baseline, const char *stage, int size);
+
+/*************************************************************************************************************
+ * main():    Purpose: Runs every stage at every size of the sweep, printing a JSON document with one        *
+ *                     result a line, and compares each median against a saved baseline if given one.        *
+ *            Parameters: int argc, char **argv                                                              *
+ *            Return value: int --> 0, or 1 if any stage regressed beyond the tolerance, or 2 on misuse      *
+ *            Side effects: - prints to stdout (the results) and stderr (the verdict)                        *
+ *                          - creates and deletes temporary files                                            *
+ *                          - sets LINES and COLUMNS if they are unset                                       *
+ *                          - terminates program on a file or memory error                                   *
+ *************************************************************************************************************/
+int main(int argc, char **argv)
+// Requires <stdio.h> for printf() and fprintf(),
+//  requires <stdlib.h> for malloc(), free(), qsort(), and setenv(),
+//  requires <unistd.h> for sysconf(),
+//  requires "shared.h" for error_check(), seconds_now(), percentile(), and compare_times(),
+//  & requires parse_options(), open_fixture(), close_fixture(), run_stage(), load_baseline(), and
+//    find_baseline()
+{
+    // Variable declarations:
+    const char *stage_names[STAGE_COUNT] = {"generate:classic", "generate:tiled", "generate:streaming",
+                                            "generate:backtracker", "generate:kruskal", "generate:prim",
+                                            "generate:wilson", "read", "solve:bfs", "solve:astar",
+                                            "solve:bidirectional", "render"};
+    const int sweep[SWEEP_LENGTH] = {10, 32, 100, 316, 1000, 3162, 10000, 31623, MAX_DIMENSION};
+    struct bench_options options;
+    struct bench_fixture fixture;
+    struct baseline *baseline = NULL;
+    double *times, start, elapsed, reference, change;
+    int sizes[SWEEP_LENGTH + 1], size_count = 0, repetitions, regressions = 0;
+    uint64_t cells;
+    bool first = true;
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    options.threads = processors < 1 ? 1 : (int) processors;
+    if (!parse_options(argc, argv, &options))
+    {
+        (void) printf("Usage: \"<program_filename> [options]\"\n"
+                      "Options:\n"
+                      "\t--trials <number>: timed trials of each stage at each size (default: %d)\n"
+                      "\t--max-size <number>: largest width and height in the sweep, %d to %d (default: %d)\n"
+                      "\t--seed <number>: seed every maze is generated from (default: %d)\n"
+                      "\t--baseline <filename>: compare against results saved from an earlier run, and fail if\n"
+                      "\t                       any median is slower by more than the tolerance\n"
+                      "\t--tolerance <percent>: allowed slowdown against the baseline (default: %.0f)\n",
+                      DEFAULT_TRIALS, MIN_DIMENSION, MAX_DIMENSION, DEFAULT_MAX_SIZE, DEFAULT_SEED,
+                      DEFAULT_TOLERANCE);
+        return 2;
+    }
+
+    if (options.baseline_filename != NULL)
+    {
+        baseline = malloc(sizeof(struct baseline));
+        error_check("malloc()", 1, baseline != NULL, NULL);
+        load_baseline(options.baseline_filename, baseline);
+    }
+
+    // Sizes grow by about the square root of ten, so that cells grow tenfold, up to the largest asked for:
+    for (int k = 0; k < SWEEP_LENGTH && sweep[k] < options.max_size; k++)
+        sizes[size_count++] = sweep[k];
+    sizes[size_count++] = options.max_size;
+
+    // The render stage draws the window a terminal of this size would show:
+    (void) setenv("LINES", BENCH_ROWS, 0);
+    (void) setenv("COLUMNS", BENCH_COLUMNS, 0);
+
+    times = malloc((size_t) options.trials * sizeof(double));
+    error_check("malloc()", 1, times != NULL, NULL);
+
+    fixture.checksum = 0;
+    (void) printf("{\"seed\": %llu, \"trials\": %d, \"threads\": %d, \"results\": [\n",
+                  (unsigned long long) options.seed, options.trials, options.threads);
+    for (int s = 0; s < size_count; s++)
+    {
+        open_fixture(&fixture, sizes[s], options.seed);
+        cells = (uint64_t) sizes[s] * sizes[s];
+
+        for (int stage = 0; stage < STAGE_COUNT; stage++)
+        {
+            // The first run warms the caches and the allocator, and is not counted. Stages that take too
+            //  little time to measure one run at a time are repeated within each trial, as often as the
+            //  first run says will fill it:
+            start = seconds_now();
+            run_stage(stage, &fixture, &options);
+            elapsed = seconds_now() - start;
+            repetitions = elapsed * MAX_REPETITIONS < TRIAL_SECONDS ? MAX_REPETITIONS
+                          : elapsed >= TRIAL_SECONDS ? 1 : (int) (TRIAL_SECONDS / elapsed);
+            for (int t = 0; t < options.trials; t++)
+            {
+                start = seconds_now();
+                for (int k = 0; k < repetitions; k++)
+                    run_stage(stage, &fixture, &options);
+                times[t] = (seconds_now() - start) / repetitions;
+            }
+            qsort(times, (size_t) options.trials, sizeof(double), compare_times);
+
+            (void) printf("%s  {\"stage\": \"%s\", \"size\": %d, \"cells\": %llu, \"repetitions\": %d, "
+                          "\"median_s\": %.9f, \"p95_s\": %.9f, \"cells_per_s\": %.0f", first ? "" : ",\n",
+                          stage_names[stage], sizes[s], (unsigned long long) cells, repetitions,
+                          percentile(times, options.trials, 0.5), percentile(times, options.trials, 0.95),
+                          cells / percentile(times, options.trials, 0.5));
+            first = false;
+
+            // A stage the baseline does not know about is reported, but cannot regress:
+            reference = baseline == NULL ? -1 : find_baseline(baseline, stage_names[stage], sizes[s]);
+            if (reference > 0)
+            {
+                change = percentile(times, options.trials, 0.5) / reference - 1;
+                (void) printf(", \"baseline_median_s\": %.9f, \"change_percent\": %.1f", reference, change * 100);
+                if (change * 100 > options.tolerance)
+                {
+                    (void) fprintf(stderr, "%s at %dx%d: %.1f%% slower than the baseline\n", stage_names[stage],
+                                   sizes[s], sizes[s], change * 100);
+                    regressions++;
+                }
+            }
+            (void) printf("}");
+            (void) fflush(stdout);
+        }
+        close_fixture(&fixture);
+    }
+    (void) printf("\n], \"checksum\": %llu, \"regressions\": %d}\n", (unsigned long long) fixture.checksum,
+                  regressions);
+
+    if (baseline != NULL)
+        (void) fprintf(stderr, "%d of %d results slower than the baseline by more than %.1f%%\n", regressions,
+                       size_count * STAGE_COUNT, options.tolerance);
+    free(times);
+    free(baseline);
+    return regressions > 0 ? 1 : 0;
+}
+
+
+/**************************************************************************************************************
+ * parse_options():    Purpose: Reads the command-line options, filling in defaults for any not given.        *
+ *                     Parameters: int argc, char **argv                                                      *
+ *                                 struct bench_options *options --> where to store the options               *
+ *                     Return value: bool --> false if an option is unknown, incomplete, or out of range      *
+ *                     Side effects: modifies *options                                                        *
+ **************************************************************************************************************/
+bool parse_options(int argc, char **argv, struct bench_options *options)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdlib.h> for strtoull() and strtod(),
+//  requires <string.h> for strcmp(),
+//  & requires "shared.h" for macros
+{
+    // Variable declarations:
+    unsigned long long number;
+    char *end;
+
+    options->trials = DEFAULT_TRIALS;
+    options->max_size = DEFAULT_MAX_SIZE;
+    options->seed = DEFAULT_SEED;
+    options->baseline_filename = NULL;
+    options->tolerance = DEFAULT_TOLERANCE;
+
+    for (int k = 1; k < argc; k++)
+    {
+        if (k + 1 >= argc)
+            return false;
+        if (strcmp(argv[k], "--baseline") == 0)
+        {
+            options->baseline_filename = argv[++k];
+            continue;
+        }
+        if (strcmp(argv[k], "--tolerance") == 0)
+        {
+            options->tolerance = strtod(argv[++k], &end);
+            if (*end != '\0' || end == argv[k] || options->tolerance < 0)
+                return false;
+            continue;
+        }
+
+        // The rest take whole numbers:
+        number = strtoull(argv[k + 1], &end, 10);
+        if (*end != '\0' || end == argv[k + 1] || argv[k + 1][0] == '-')
+            return false;
+        if (strcmp(argv[k], "--trials") == 0 && number >= 1 && number <= MAX_TRIALS)
+            options->trials = (int) number;
+        else if (strcmp(argv[k], "--max-size") == 0 && number >= MIN_DIMENSION && number <= MAX_DIMENSION)
+            options->max_size = (int) number;
+        else if (strcmp(argv[k], "--seed") == 0)
+            options->seed = number;
+        else
+            return false;
+        k++;
+    }
+
+    return true;
+}
+
+
+/********************************************************************************************************************
+ * open_fixture():    Purpose: Generates the classic maze of the given size that the reading, solving, and          *
+ *                             rendering stages share, maps it, and opens the generation stages' scratch file.      *
+ *                    Parameters: struct bench_fixture *fixture --> the fixture to fill in                          *
+ *                                int size --> the width and height of the maze                                     *
+ *                                uint64_t seed --> the seed to generate it from                                    *
+ *                    Return value: none                                                                            *
+ *                    Side effects: - modifies *fixture, except for its checksum                                    *
+ *                                  - creates temporary files                                                       *
+ *                                  - maps or allocates memory                                                      *
+ *                                  - terminates program on a file error                                            *
+ ********************************************************************************************************************/
+void open_fixture(struct bench_fixture *fixture, int size, uint64_t seed)
+// Requires <stdio.h> for tmpfile() and rewind(),
+//  requires "shared.h" for error_check() and status_check(),
+//  requires "generation.h" for init_generation(), draw_maze(), and "struct generation_context",
+//  & requires "maze_file.h" for map_maze()
+{
+    // Variable declarations:
+    struct generation_context context;
+
+    fixture->size = size;
+    fixture->maze_file = tmpfile();
+    error_check("fopen()", 1, fixture->maze_file != NULL, NULL);
+    fixture->scratch = tmpfile();
+    error_check("fopen()", 1, fixture->scratch != NULL, fixture->maze_file);
+
+    init_generation(&context, seed);
+    status_check(draw_maze(fixture->maze_file, size, size, &context), fixture->maze_file);
+    rewind(fixture->maze_file);
+    status_check(map_maze(fixture->maze_file, &fixture->header, &fixture->maze, &fixture->mapped_length),
+                 fixture->maze_file);
+    return;
+}
+
+
+/**************************************************************************************************************
+ * close_fixture():    Purpose: Releases the fixture's maze and closes (so deletes) its temporary files.      *
+ *                     Parameters: struct bench_fixture *fixture --> the fixture to close                     *
+ *                     Return value: none                                                                     *
+ *                     Side effects: - unmaps or frees memory                                                 *
+ *                                   - closes files                                                           *
+ **************************************************************************************************************/
+void close_fixture(struct bench_fixture *fixture)
+// Requires <stdio.h> for fclose(),
+//  & requires "maze_file.h" for release_maze()
+{
+    release_maze(fixture->maze, &fixture->header, fixture->mapped_length);
+    (void) fclose(fixture->maze_file);
+    (void) fclose(fixture->scratch);
+    return;
+}
+
+
+/*******************************************************************************************************************
+ * run_stage():    Purpose: Runs one stage once on the fixture's size. Generation always starts from the same      *
+ *                          seed, so every run does the same work: writing the maze the game would write to        *
+ *                          the scratch file. Reading maps the fixture's file and touches every cell, as           *
+ *                          playing or solving it would; rendering sets up the player's screen on the whole        *
+ *                          maze revealed and draws the first frame, without sending it to the terminal.           *
+ *                 Parameters: int stage --> one of the STAGE_ macros                                              *
+ *                             struct bench_fixture *fixture --> the maze of the size under test                   *
+ *                             const struct bench_options *options --> the seed and threads                        *
+ *                 Return value: none                                                                              *
+ *                 Side effects: - modifies fixture->checksum                                                      *
+ *                               - overwrites the scratch file                                                     *
+ *                               - terminates program on a file or memory error                                    *
+ *******************************************************************************************************************/
+void run_stage(int stage, struct bench_fixture *fixture, const struct bench_options *options)
+// Requires <stdio.h> for rewind(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "shared.h" for macros, error_check(), and status_check(),
+//  requires "generation.h" for init_generation(), draw_maze(), "struct generation_context", and macros,
+//  requires "maze_file.h" for map_maze(), release_maze(), and "struct maze_header",
+//  requires "solver.h" for solve_maze(), "struct solution", and macros,
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <string.h> for memset(),
+//  & requires "render.h" for init_renderer(), render_reset(), render_map(), free_renderer(), "struct renderer",
+//    "struct player_map", and macros
+{
+    // Variable declarations:
+    struct generation_context context;
+    struct maze_header header;
+    struct solution solution;
+    struct renderer renderer;
+    struct player_map map;
+    size_t mapped_length, words = CELL_WORDS(fixture->size * (size_t) fixture->size);
+    uint64_t cells = (uint64_t) fixture->size * fixture->size, walls = 0;
+    char *maze;
+
+    switch (stage)
+    {
+        case STAGE_GENERATE_CLASSIC:
+        case STAGE_GENERATE_TILED:
+        case STAGE_GENERATE_STREAMING:
+        case STAGE_GENERATE_BACKTRACKER:
+        case STAGE_GENERATE_KRUSKAL:
+        case STAGE_GENERATE_PRIM:
+        case STAGE_GENERATE_WILSON:
+            rewind(fixture->scratch);
+            init_generation(&context, options->seed);
+            context.algorithm = stage;
+            context.threads = options->threads;
+            status_check(draw_maze(fixture->scratch, fixture->size, fixture->size, &context), fixture->scratch);
+            fixture->checksum += context.seed;
+            break;
+        case STAGE_READ:
+            rewind(fixture->maze_file);
+            status_check(map_maze(fixture->maze_file, &header, &maze, &mapped_length), fixture->maze_file);
+            for (uint64_t k = 0; k < cells; k++)
+                walls += maze[k] == WALL;
+            release_maze(maze, &header, mapped_length);
+            fixture->checksum += walls;
+            break;
+        case STAGE_SOLVE_BFS:
+        case STAGE_SOLVE_ASTAR:
+        case STAGE_SOLVE_BIDIRECTIONAL:
+            solve_maze(fixture->maze, &fixture->header, stage == STAGE_SOLVE_BFS ? SOLVER_BFS
+                       : stage == STAGE_SOLVE_ASTAR ? SOLVER_ASTAR : SOLVER_BIDIRECTIONAL, &solution);
+            fixture->checksum += solution.path_length;
+            break;
+        case STAGE_RENDER:
+            // Every cell revealed, and none of the bits past the last:
+            map.maze = fixture->maze;
+            map.revealed = malloc(words * sizeof(uint64_t));
+            error_check("malloc()", 1, map.revealed != NULL, fixture->maze_file);
+            (void) memset(map.revealed, 0xFF, words * sizeof(uint64_t));
+            if (cells % 64 != 0)
+                map.revealed[words - 1] = ((uint64_t) 1 << (cells % 64)) - 1;
+            map.y_dimension = fixture->size;
+            map.x_dimension = fixture->size;
+            map.player_y = (int) fixture->header.start_y;
+            map.player_x = (int) fixture->header.start_x;
+            init_renderer(&renderer, fixture->size, fixture->size);
+            render_reset(&renderer, &map);
+            render_map(&renderer, &map, map.player_y, map.player_x);
+            fixture->checksum += renderer.length;
+            free_renderer(&renderer);
+            free(map.revealed);
+            break;
+    }
+
+    return;
+}
+
+
+/***************************************************************************************************************
+ * load_baseline():    Purpose: Reads the stage, size, and median of each result from a file this program      *
+ *                              wrote earlier. Lines that are not results are skipped.                         *
+ *                     Parameters: const char *filename --> the saved results                                  *
+ *                                 struct baseline *baseline --> where to store them                           *
+ *                     Return value: none                                                                      *
+ *                     Side effects: - modifies *baseline                                                      *
+ *                                   - terminates program if the file cannot be opened                         *
+ ***************************************************************************************************************/
+void load_baseline(const char *filename, struct baseline *baseline)
+// Requires <stdio.h> for the type "FILE *" and fopen(), fgets(), sscanf(), and fclose(),
+//  & requires "shared.h" for error_check()
+{
+    // Variable declarations:
+    FILE *baseline_file = fopen(filename, "r");
+    char line[MAX_LINE];
+    struct baseline_entry *entry;
+
+    error_check("fopen()", 1, baseline_file != NULL, NULL);
+    baseline->count = 0;
+    while (baseline->count < MAX_BASELINE && fgets(line, sizeof(line), baseline_file) != NULL)
+    {
+        entry = &baseline->entries[baseline->count];
+        if (sscanf(line, " {\"stage\": \"%31[^\"]\", \"size\": %d, \"cells\": %*[0-9], \"repetitions\": %*d, "
+                   "\"median_s\": %lf", entry->stage, &entry->size, &entry->median) == 3)
+            baseline->count++;
+    }
+    (void) fclose(baseline_file);
+    return;
+}
+
+
+/***********************************************************************************************************
+ * find_baseline():    Purpose: Looks up the baseline's median for a stage at a size.                      *
+ *                     Parameters: const struct baseline *baseline --> the saved results                   *
+ *                                 const char *stage --> the stage's name                                  *
+ *                                 int size --> the width and height of the maze                           *
+ *                     Return value: double --> the median in seconds, or -1 if the baseline has none      *
+ *                     Side effects: none                                                                  *
+ ***********************************************************************************************************/
+double find_baseline(const struct baseline *baseline, const char *stage, int size)
+// Requires <string.h> for strcmp()
+{
+    for (int k = 0; k < baseline->count; k++)
+        if (baseline->entries[k].size == size && strcmp(baseline->entries[k].stage, stage) == 0)
+            return baseline->entries[k].median;
+    return -1;
+}
@@ -0,0 +1,233 @@
+/****************************************************************************************************
+ * Name: bitgrid.c                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements a bit-packed maze grid and its conversions to and from the char format.      *
+ ****************************************************************************************************/
+
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <stdint.h> // for the types "uint32_t" and "uint64_t"
+#include <stdlib.h> // for calloc() and free()
+#include "shared.h" // for macros
+#include "bitgrid.h" // for "struct bitgrid" and its macros
+
+/*************************************************************************************************
+ * bitgrid_create():    Purpose: Allocates a grid with every cell (and all padding) closed.      *
+ *                      Parameters: struct bitgrid *grid --> the grid to initialize              *
+ *                                  int y_dimension --> the height of the maze                   *
+ *                                  int x_dimension --> the width of the maze                    *
+ *                      Return value: bool --> false if the grid could not be allocated          *
+ *                      Side effects: - modifies *grid                                           *
+ *                                    - allocates memory                                         *
+ *************************************************************************************************/
+bool bitgrid_create(struct bitgrid *grid, int y_dimension, int x_dimension)
+// Requires <stdbool.h> for the type "bool",
+//  requires <stdlib.h> for calloc(),
+//  & requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    // One padding column on each side, plus a spare word so that reads straddling
+    // the last word of a row never leave the row:
+    grid->stride = ((size_t) x_dimension + 2 + WORD_BITS - 1) / WORD_BITS + 1;
+    grid->y_dimension = y_dimension;
+    grid->x_dimension = x_dimension;
+    grid->start_y = grid->start_x = 0;
+    grid->end_y = grid->end_x = 0;
+    grid->words = calloc(((size_t) y_dimension + 2) * grid->stride, sizeof(uint64_t));
+
+    return grid->words != NULL;
+}
+
+
+/************************************************************************************
+ * bitgrid_free():    Purpose: Releases the memory held by a grid.                  *
+ *                    Parameters: struct bitgrid *grid --> the grid to release      *
+ *                    Return value: none                                            *
+ *                    Side effects: - frees memory                                  *
+ *                                  - modifies *grid                                *
+ ************************************************************************************/
+void bitgrid_free(struct bitgrid *grid)
+// Requires <stdlib.h> for free()
+{
+    free(grid->words);
+    grid->words = NULL;
+}
+
+
+/****************************************************************************************************************
+ * bitgrid_shifted():    Purpose: Reads a 64-bit word of a padded row starting "shift" bits after               *
+ *                                (or before, if negative) a word boundary, so that whole-row                   *
+ *                                neighbour tests can be done with one AND per word.                            *
+ *                       Parameters: const uint64_t *row --> the padded row                                     *
+ *                                   size_t word --> which word of the row to read                              *
+ *                                   int shift --> how far to slide the read (-63 to 63)                        *
+ *                       Return value: uint64_t --> bit b is bit (WORD_BITS * word + b + shift) of the row      *
+ *                       Side effects: none                                                                     *
+ ****************************************************************************************************************/
+uint64_t bitgrid_shifted(const uint64_t *row, size_t word, int shift)
+// Requires <stdint.h> for the type "uint64_t"
+{
+    if (shift > 0)
+        return (row[word] >> shift) | (row[word + 1] << (WORD_BITS - shift));
+    if (shift < 0)
+        return (row[word] << -shift) | (word > 0 ? row[word - 1] >> (WORD_BITS + shift) : 0);
+    return row[word];
+}
+
+
+/********************************************************************************************************
+ * bitgrid_window():    Purpose: Gathers the open bits of the 5x5 block of cells centred on (i, j)      *
+ *                               with one two-word read per row, as shown by WINDOW_BIT().              *
+ *                               Cells beyond the maze read as padding.                                 *
+ *                      Parameters: const struct bitgrid *grid --> the grid to read                     *
+ *                                  int i --> the y-value of the centre (1 to y_dimension - 2)          *
+ *                                  int j --> the x-value of the centre (1 to x_dimension - 2)          *
+ *                      Return value: uint32_t --> the 25-bit window                                    *
+ *                      Side effects: none                                                              *
+ ********************************************************************************************************/
+uint32_t bitgrid_window(const struct bitgrid *grid, int i, int j)
+// Requires <stdint.h> for the types "uint32_t" and "uint64_t",
+//  & requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    // Variable declarations:
+    uint32_t window = 0;
+    size_t first = (size_t) j - 1; // padded column of the window's leftmost cell (j - 2)
+    size_t word = first / WORD_BITS;
+    int offset = (int) (first % WORD_BITS);
+    const uint64_t *row;
+
+    for (int r = 0; r < WINDOW_SIZE; r++)
+    {
+        row = BITGRID_ROW(grid, i - 2 + r);
+        window |= (uint32_t) (bitgrid_shifted(row, word, offset) & 0x1F) << (WINDOW_SIZE * r);
+    }
+
+    return window;
+}
+
+
+/*****************************************************************************************
+ * bitgrid_cell():    Purpose: Converts one cell of a grid back to the char format.      *
+ *                    Parameters: const struct bitgrid *grid --> the grid to read        *
+ *                                int i --> the y-value of the cell                      *
+ *                                int j --> the x-value of the cell                      *
+ *                    Return value: char --> BORDER, WALL, FLOOR, START, or END          *
+ *                    Side effects: none                                                 *
+ *****************************************************************************************/
+char bitgrid_cell(const struct bitgrid *grid, int i, int j)
+// Requires "shared.h" for macros,
+//  & requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    if (i == 0 || i == grid->y_dimension - 1 || j == 0 || j == grid->x_dimension - 1)
+        return BORDER;
+    if (!BITGRID_TEST(grid, i, j))
+        return WALL;
+    if (i == grid->start_y && j == grid->start_x)
+        return START;
+    if (i == grid->end_y && j == grid->end_x)
+        return END;
+    return FLOOR;
+}
+
+
+/***********************************************************************************************
+ * bitgrid_row_to_chars():    Purpose: Converts a whole row of a grid to the char format.      *
+ *                            Parameters: const struct bitgrid *grid --> the grid to read      *
+ *                                        int i --> the y-value of the row                     *
+ *                                        char *row --> where to store x_dimension chars       *
+ *                            Return value: none                                               *
+ *                            Side effects: modifies the array pointed to by row               *
+ ***********************************************************************************************/
+void bitgrid_row_to_chars(const struct bitgrid *grid, int i, char *row)
+// Requires <stdint.h> for the type "uint64_t",
+//  requires "shared.h" for macros,
+//  & requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    // Variable declarations:
+    const uint64_t *words = BITGRID_ROW(grid, i);
+    int x_dimension = grid->x_dimension;
+
+    if (i == 0 || i == grid->y_dimension - 1)
+    {
+        for (int j = 0; j < x_dimension; j++)
+            row[j] = BORDER;
+        return;
+    }
+
+    row[0] = row[x_dimension - 1] = BORDER;
+    for (int j = 1; j < x_dimension - 1; j++)
+        row[j] = (words[(j + 1) / WORD_BITS] >> ((j + 1) % WORD_BITS)) & 1 ? FLOOR : WALL;
+
+    if (i == grid->start_y)
+        row[grid->start_x] = START;
+    if (i == grid->end_y)
+        row[grid->end_x] = END;
+}
+
+
+/*****************************************************************************************************
+ * bitgrid_from_chars():    Purpose: Packs a char-format maze into a grid created with the same      *
+ *                                   dimensions. START and END go to the side table.                 *
+ *                          Parameters: struct bitgrid *grid --> the grid to fill                    *
+ *                                      const char *maze --> the row-major char maze                 *
+ *                          Return value: none                                                       *
+ *                          Side effects: modifies *grid                                             *
+ *****************************************************************************************************/
+void bitgrid_from_chars(struct bitgrid *grid, const char *maze)
+// Requires "shared.h" for macros,
+//  & requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    int x_dimension = grid->x_dimension;
+
+    for (int i = 0; i < grid->y_dimension; i++)
+        for (int j = 0; j < x_dimension; j++)
+        {
+            if (MAZE_OF_I_OF_J == FLOOR || MAZE_OF_I_OF_J == START || MAZE_OF_I_OF_J == END)
+                BITGRID_SET(grid, i, j);
+            if (MAZE_OF_I_OF_J == START)
+                grid->start_y = i, grid->start_x = j;
+            else if (MAZE_OF_I_OF_J == END)
+                grid->end_y = i, grid->end_x = j;
+        }
+}
+
+
+/************************************************************************************************************
+ * bitgrid_copy():    Purpose: Copies a rectangle of cells from one grid into another, up to a word at      *
+ *                             a time. START and END are not copied.                                        *
+ *                    Parameters: struct bitgrid *destination --> the grid to copy into                     *
+ *                                int destination_y, destination_x --> the top-left cell to copy to         *
+ *                                const struct bitgrid *source --> the grid to copy from                    *
+ *                                int source_y, source_x --> the top-left cell to copy from                 *
+ *                                int height, width --> the size of the rectangle                           *
+ *                    Return value: none                                                                    *
+ *                    Side effects: modifies the destination grid                                           *
+ ************************************************************************************************************/
+void bitgrid_copy(struct bitgrid *destination, int destination_y, int destination_x,
+                  const struct bitgrid *source, int source_y, int source_x, int height, int width)
+// Requires <stdint.h> for the type "uint64_t",
+//  & requires "bitgrid.h" for "struct bitgrid", its macros, and bitgrid_shifted()
+{
+    // Variable declarations:
+    const uint64_t *from;
+    uint64_t *to;
+    uint64_t bits, mask;
+    size_t from_bit, to_bit;
+    int chunk, offset;
+
+    for (int r = 0; r < height; r++)
+    {
+        from = BITGRID_ROW(source, source_y + r);
+        to = BITGRID_ROW(destination, destination_y + r);
+        // Each chunk fills the destination up to its next word boundary:
+        for (int k = 0; k < width; k += chunk)
+        {
+            from_bit = (size_t) source_x + 1 + k;
+            to_bit = (size_t) destination_x + 1 + k;
+            offset = (int) (to_bit % WORD_BITS);
+            chunk = WORD_BITS - offset < width - k ? WORD_BITS - offset : width - k;
+            mask = chunk == WORD_BITS ? ~(uint64_t) 0 : ((uint64_t) 1 << chunk) - 1;
+            bits = bitgrid_shifted(from, from_bit / WORD_BITS, (int) (from_bit % WORD_BITS)) & mask;
+            to[to_bit / WORD_BITS] = (to[to_bit / WORD_BITS] & ~(mask << offset)) | (bits << offset);
+        }
+    }
+}
\ No newline at end of file
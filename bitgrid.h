@@ -0,0 +1,53 @@
+/****************************************************************************************************
+ * Name: bitgrid.h                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for bitgrid.c                                                               *
+ ****************************************************************************************************/
+
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <stdbool.h> // for the type "bool"
+#include <stddef.h> // for the type "size_t"
+#include <stdint.h> // for the type "uint64_t"
+
+/* Object-Like Macros */
+#define WORD_BITS 64
+#define WINDOW_SIZE 5 // bitgrid_window() returns a WINDOW_SIZE x WINDOW_SIZE block of cells
+
+/* Parameterized Macros */
+// Rows and columns are stored with one cell of padding on every side, hence the "+ 1"s:
+#define BITGRID_ROW(grid, i) ((grid)->words + ((size_t) (i) + 1) * (grid)->stride)
+#define BITGRID_TEST(grid, i, j) ((BITGRID_ROW(grid, i)[((size_t) (j) + 1) / WORD_BITS] >> (((size_t) (j) + 1) % WORD_BITS)) & 1)
+#define BITGRID_SET(grid, i, j) (BITGRID_ROW(grid, i)[((size_t) (j) + 1) / WORD_BITS] |= (uint64_t) 1 << (((size_t) (j) + 1) % WORD_BITS))
+#define BITGRID_CLEAR(grid, i, j) (BITGRID_ROW(grid, i)[((size_t) (j) + 1) / WORD_BITS] &= ~((uint64_t) 1 << (((size_t) (j) + 1) % WORD_BITS)))
+// Bit b of window (WINDOW_SIZE * row + column) is the cell at (i - 2 + row, j - 2 + column):
+#define WINDOW_BIT(row, column) ((uint32_t) 1 << (WINDOW_SIZE * (row) + (column)))
+
+/* Structures */
+// A maze stored as one "open" bit per cell (FLOOR, START, and END are open; WALL and BORDER are not).
+// The padding ring around the maze is never part of the maze; its meaning is up to the caller.
+// START and END, which the plane cannot tell apart from FLOOR, are kept in a side table.
+struct bitgrid
+{
+    uint64_t *words; // (y_dimension + 2) padded rows of stride words each
+    size_t stride; // words per padded row
+    int y_dimension;
+    int x_dimension;
+    int start_y, start_x;
+    int end_y, end_x;
+};
+
+/* Function Prototypes */
+bool bitgrid_create(struct bitgrid *grid, int y_dimension, int x_dimension);
+void bitgrid_free(struct bitgrid *grid);
+uint64_t bitgrid_shifted(const uint64_t *row, size_t word, int shift);
+uint32_t bitgrid_window(const struct bitgrid *grid, int i, int j);
+char bitgrid_cell(const struct bitgrid *grid, int i, int j);
+void bitgrid_row_to_chars(const struct bitgrid *grid, int i, char *row);
+void bitgrid_from_chars(struct bitgrid *grid, const char *maze);
+void bitgrid_copy(struct bitgrid *destination, int destination_y, int destination_x,
+                  const struct bitgrid *source, int source_y, int source_x, int height, int width);
+
+#endif
@@ -0,0 +1,458 @@
+/****************************************************************************************************
+ * Name: cache.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements the maze cache: a directory of generated mazes, each named by a hash of what *
+ *          decides it (algorithm, encoding, dimensions, and seed), so that asking again for a maze *
+ *          already made copies it from a mapped file instead of generating it. Entries are written *
+ *          whole under a temporary name and renamed into place, are checked on every read, and are *
+ *          evicted least recently used first once they outgrow the cache's limit.                  *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for mkstemp(), fdopen(), and futimens() under -std=c99
+#include <stdio.h> // for the type "FILE *" and snprintf(), fdopen(), fflush(), fileno(), ftell(), fwrite(), fclose(), and rename()
+#include <stdlib.h> // for realloc(), free(), qsort(), strtoull(), and mkstemp()
+#include <string.h> // for memcmp(), memcpy(), strlen(), and strncmp()
+#include <stdint.h> // for the types "uint8_t" and "uint64_t"
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <time.h> // for time()
+#include <fcntl.h> // for open()
+#include <unistd.h> // for close() and unlink()
+#include <dirent.h> // for opendir(), readdir(), and closedir()
+#include <sys/mman.h> // for mmap() and munmap()
+#include <sys/stat.h> // for fstat(), stat(), mkdir(), futimens(), and "struct stat"
+#include "generation.h" // for draw_maze() and "struct generation_context"
+#include "maze_file.h" // for put_u32(), put_u64(), get_u64(), and macros
+#include "libmaze.h" // for the status codes
+#include "cache.h" // for "struct maze_cache" and macros
+
+/* Object-Like Macros */
+#define MAX_PATH 4096
+#define CACHE_MAGIC "MZCH"
+#define CACHE_MAGIC_SIZE 4
+#define CACHE_VERSION 1
+#define CACHE_TRAILER_SIZE 32 // after the maze: magic, version, key, the maze's length, and its checksum
+#define CACHE_KEY_SIZE 32 // bytes hashed into a key
+#define CACHE_TEMPORARY ".tmp-" // begins the name an entry is written under, before it is renamed
+#define CACHE_STALE_SECONDS 3600 // age past which a temporary file was left by a writer that died
+#define CHECKSUM_PRIME 0x9E3779B97F4A7C15ULL
+
+/* Structures */
+// An entry, as found while trimming the cache.
+struct cache_entry
+{
+    uint64_t used; // when last written or read, in nanoseconds
+    uint64_t size;
+    uint64_t key;
+};
+
+/* Internal Function Prototypes */
+void entry_path(const struct maze_cache *cache, uint64_t key, char *path);
+uint64_t checksum(const char *bytes, size_t length);
+bool entry_intact(const char *entry, size_t size, uint64_t key);
+void store_stream(const struct maze_cache *cache, uint64_t key, FILE *maze_file, long start);
+void trim_cache(const struct maze_cache *cache);
+int compare_entries(const void *a, const void *b);
+
+/**************************************************************************************************************
+ * draw_cached_maze():    Purpose: Does what draw_maze() does, but copies the maze from the cache             *
+ *                                 when it holds it, and otherwise adds the maze to the cache once            *
+ *                                 generated (if it is large enough to be worth keeping, and the file         *
+ *                                 can be mapped to copy it from). The file ends up the same either way.      *
+ *                        Parameters: FILE *maze_file --> the file to write to                                *
+ *                                    int y_dimension --> the height of the maze (in characters)              *
+ *                                    int x_dimension --> the width of the maze (in characters)               *
+ *                                    struct generation_context *context --> the seeded context               *
+ *                                    const struct maze_cache *cache --> the cache (its directory NULL        *
+ *                                                                       for none)                            *
+ *                                    bool *hit --> where to store whether the cache held the maze            *
+ *                        Return value: int --> MAZE_OK, or the failure (see libmaze.h)                       *
+ *                        Side effects: - modifies the file pointed to by maze_file                           *
+ *                                      - advances the context's random number generator, unless the          *
+ *                                        cache held the maze                                                 *
+ *                                      - may add entries to the cache and remove others                      *
+ *                                      - modifies *hit                                                       *
+ **************************************************************************************************************/
+int draw_cached_maze(FILE *maze_file, int y_dimension, int x_dimension, struct generation_context *context,
+                     const struct maze_cache *cache, bool *hit)
+// Requires <stdio.h> for the type "FILE *" and ftell(),
+//  requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "generation.h" for draw_maze() and "struct generation_context",
+//  requires "libmaze.h" for the status codes,
+//  requires "cache.h" for "struct maze_cache" and macros,
+//  & requires cache_key(), cache_fetch(), and store_stream()
+{
+    // Variable declarations:
+    uint64_t key;
+    long start;
+    int status;
+
+    *hit = false;
+    if (cache->directory == NULL || (uint64_t) y_dimension * x_dimension < CACHE_MINIMUM)
+        return draw_maze(maze_file, y_dimension, x_dimension, context);
+
+    key = cache_key(context, y_dimension, x_dimension);
+    start = ftell(maze_file);
+    status = cache_fetch(cache, key, maze_file, hit);
+    if (status != MAZE_OK || *hit)
+        return status;
+    status = draw_maze(maze_file, y_dimension, x_dimension, context);
+    if (status == MAZE_OK)
+        store_stream(cache, key, maze_file, start);
+    return status;
+}
+
+
+/**********************************************************************************************************
+ * cache_key():    Purpose: Names a maze in the cache: a hash of everything its file depends on, and      *
+ *                          of the cache and file format versions, so that neither change can serve       *
+ *                          a stale maze. The number of threads is left out, because it never             *
+ *                          changes the maze.                                                             *
+ *                 Parameters: const struct generation_context *context --> the seeded context            *
+ *                             int y_dimension --> the height of the maze (in characters)                 *
+ *                             int x_dimension --> the width of the maze (in characters)                  *
+ *                 Return value: uint64_t --> the key                                                     *
+ *                 Side effects: none                                                                     *
+ **********************************************************************************************************/
+uint64_t cache_key(const struct generation_context *context, int y_dimension, int x_dimension)
+// Requires <stdint.h> for the types "uint8_t" and "uint64_t",
+//  requires "generation.h" for "struct generation_context",
+//  requires "maze_file.h" for put_u32(), put_u64(), and macros,
+//  & requires checksum()
+{
+    // Variable declarations:
+    uint8_t bytes[CACHE_KEY_SIZE] = {0};
+
+    bytes[0] = CACHE_VERSION;
+    bytes[1] = HEADER_VERSION;
+    bytes[2] = (uint8_t) context->encoding;
+    bytes[3] = (uint8_t) context->algorithm;
+    put_u32(bytes + 4, (uint32_t) x_dimension);
+    put_u32(bytes + 8, (uint32_t) y_dimension);
+    put_u64(bytes + 16, context->seed);
+    return checksum((const char *) bytes, sizeof(bytes));
+}
+
+
+/************************************************************************************************************
+ * cache_fetch():    Purpose: Copies a maze from the cache to file, if the cache holds it intact, and       *
+ *                            marks it as just used. An entry that fails its check is removed, so that      *
+ *                            the maze is generated and stored afresh.                                      *
+ *                   Parameters: const struct maze_cache *cache --> the cache                               *
+ *                               uint64_t key --> the maze's key (see cache_key())                          *
+ *                               FILE *maze_file --> the file to write to                                   *
+ *                               bool *hit --> where to store whether the maze was copied                   *
+ *                   Return value: int --> MAZE_OK (whether or not the maze was there), or                  *
+ *                                         MAZE_ERROR_WRITE if it could not be copied whole                 *
+ *                   Side effects: - modifies the file pointed to by maze_file                              *
+ *                                 - may update the entry's modification time, or remove the entry          *
+ *                                 - modifies *hit                                                          *
+ ************************************************************************************************************/
+int cache_fetch(const struct maze_cache *cache, uint64_t key, FILE *maze_file, bool *hit)
+// Requires <stdio.h> for the type "FILE *" and fwrite(),
+//  requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <fcntl.h> for open(),
+//  requires <unistd.h> for close() and unlink(),
+//  requires <sys/mman.h> for mmap() and munmap(),
+//  requires <sys/stat.h> for fstat(), futimens(), and "struct stat",
+//  requires "libmaze.h" for the status codes,
+//  & requires entry_path() and entry_intact()
+{
+    // Variable declarations:
+    char path[MAX_PATH];
+    struct stat status;
+    char *entry;
+    size_t size;
+    int descriptor, result = MAZE_OK;
+
+    *hit = false;
+    entry_path(cache, key, path);
+    descriptor = open(path, O_RDONLY);
+    if (descriptor < 0)
+        return MAZE_OK;
+    if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= CACHE_TRAILER_SIZE)
+    {
+        (void) close(descriptor);
+        return MAZE_OK;
+    }
+    size = (size_t) status.st_size;
+    entry = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (entry == MAP_FAILED)
+    {
+        (void) close(descriptor);
+        return MAZE_OK;
+    }
+
+    if (!entry_intact(entry, size, key))
+        (void) unlink(path);
+    else
+    {
+        *hit = true;
+        if (fwrite(entry, size - CACHE_TRAILER_SIZE, 1, maze_file) != 1)
+            result = MAZE_ERROR_WRITE;
+        (void) futimens(descriptor, NULL);
+    }
+    (void) munmap(entry, size);
+    (void) close(descriptor);
+    return result;
+}
+
+
+/***********************************************************************************************************
+ * cache_store():    Purpose: Adds a maze to the cache, then trims the cache to its limit. The entry       *
+ *                            is written under a temporary name and renamed into place, so readers         *
+ *                            only ever see it whole. The cache is only an optimization, so a failure      *
+ *                            to write it is ignored.                                                      *
+ *                   Parameters: const struct maze_cache *cache --> the cache                              *
+ *                               uint64_t key --> the maze's key (see cache_key())                         *
+ *                               const char *bytes --> the maze file's bytes, header and all               *
+ *                               size_t length --> how many there are                                      *
+ *                   Return value: none                                                                    *
+ *                   Side effects: - creates the cache directory if it does not exist                      *
+ *                                 - creates or replaces the entry, and may remove others                  *
+ ***********************************************************************************************************/
+void cache_store(const struct maze_cache *cache, uint64_t key, const char *bytes, size_t length)
+// Requires <stdio.h> for the type "FILE *" and snprintf(), fdopen(), fwrite(), fclose(), and rename(),
+//  requires <stdlib.h> for mkstemp(),
+//  requires <string.h> for memcpy(),
+//  requires <stdint.h> for the types "uint8_t" and "uint64_t",
+//  requires <stdbool.h> for the type "bool",
+//  requires <unistd.h> for close() and unlink(),
+//  requires <sys/stat.h> for mkdir(),
+//  requires "maze_file.h" for put_u64(),
+//  & requires entry_path(), checksum(), and trim_cache()
+{
+    // Variable declarations:
+    char path[MAX_PATH], temporary[MAX_PATH];
+    uint8_t trailer[CACHE_TRAILER_SIZE] = {0};
+    FILE *entry;
+    int descriptor;
+    bool written;
+
+    // The directory may already exist:
+    (void) mkdir(cache->directory, 0777);
+    entry_path(cache, key, path);
+    (void) snprintf(temporary, sizeof(temporary), "%s/" CACHE_TEMPORARY "XXXXXX", cache->directory);
+    descriptor = mkstemp(temporary);
+    if (descriptor < 0)
+        return;
+    entry = fdopen(descriptor, "wb");
+    if (entry == NULL)
+    {
+        (void) close(descriptor);
+        (void) unlink(temporary);
+        return;
+    }
+
+    (void) memcpy(trailer, CACHE_MAGIC, CACHE_MAGIC_SIZE);
+    trailer[4] = CACHE_VERSION;
+    put_u64(trailer + 8, key);
+    put_u64(trailer + 16, (uint64_t) length);
+    put_u64(trailer + 24, checksum(bytes, length));
+    written = fwrite(bytes, 1, length, entry) == length && fwrite(trailer, 1, CACHE_TRAILER_SIZE, entry) == CACHE_TRAILER_SIZE;
+    written = fclose(entry) == 0 && written;
+    if (!written || rename(temporary, path) != 0)
+    {
+        (void) unlink(temporary);
+        return;
+    }
+    trim_cache(cache);
+}
+
+
+/**************************************************************************************************
+ * entry_path():    Purpose: Names a maze's entry: the cache directory, then its key in hex.      *
+ *                  Parameters: const struct maze_cache *cache --> the cache                      *
+ *                              uint64_t key --> the maze's key                                   *
+ *                              char *path --> where to store the name (MAX_PATH bytes)           *
+ *                  Return value: none                                                            *
+ *                  Side effects: modifies the path                                               *
+ **************************************************************************************************/
+void entry_path(const struct maze_cache *cache, uint64_t key, char *path)
+// Requires <stdio.h> for snprintf(),
+//  & requires <stdint.h> for the type "uint64_t"
+{
+    (void) snprintf(path, MAX_PATH, "%s/%016llx" CACHE_SUFFIX, cache->directory, (unsigned long long) key);
+}
+
+
+/*******************************************************************************************************
+ * checksum():    Purpose: Hashes bytes 8 at a time: a multiply and a shift per word, fast enough      *
+ *                         to check a whole entry on every read at a fraction of the cost of           *
+ *                         copying it. Words are read in this machine's byte order, which is all       *
+ *                         a cache on this machine needs.                                              *
+ *                Parameters: const char *bytes --> the bytes                                          *
+ *                            size_t length --> how many there are                                     *
+ *                Return value: uint64_t --> the hash                                                  *
+ *                Side effects: none                                                                   *
+ *******************************************************************************************************/
+uint64_t checksum(const char *bytes, size_t length)
+// Requires <stdint.h> for the type "uint64_t",
+//  & requires <string.h> for memcpy()
+{
+    // Variable declarations:
+    uint64_t hash = (uint64_t) length * CHECKSUM_PRIME, word;
+    size_t k;
+
+    for (k = 0; k + 8 <= length; k += 8)
+    {
+        (void) memcpy(&word, bytes + k, 8);
+        hash = (hash ^ word) * CHECKSUM_PRIME;
+        hash ^= hash >> 32;
+    }
+    word = 0;
+    (void) memcpy(&word, bytes + k, length - k);
+    hash = (hash ^ word) * CHECKSUM_PRIME;
+    return hash ^ hash >> 29;
+}
+
+
+/*********************************************************************************************************
+ * entry_intact():    Purpose: Checks an entry: that its trailer is there and names this key, that       *
+ *                             the maze is as long as the trailer says, and that it hashes to the        *
+ *                             checksum the trailer records.                                             *
+ *                    Parameters: const char *entry --> the entry's bytes                                *
+ *                                size_t size --> how many there are (more than CACHE_TRAILER_SIZE)      *
+ *                                uint64_t key --> the key it was looked up by                           *
+ *                    Return value: bool --> true if the entry can be used                               *
+ *                    Side effects: none                                                                 *
+ *********************************************************************************************************/
+bool entry_intact(const char *entry, size_t size, uint64_t key)
+// Requires <stdbool.h> for the type "bool",
+//  requires <string.h> for memcmp(),
+//  requires <stdint.h> for the types "uint8_t" and "uint64_t",
+//  requires "maze_file.h" for get_u64(),
+//  & requires checksum()
+{
+    // Variable declarations:
+    size_t length = size - CACHE_TRAILER_SIZE;
+    const uint8_t *trailer = (const uint8_t *) entry + length;
+
+    return memcmp(trailer, CACHE_MAGIC, CACHE_MAGIC_SIZE) == 0 && trailer[4] == CACHE_VERSION
+           && get_u64(trailer + 8) == key && get_u64(trailer + 16) == length
+           && get_u64(trailer + 24) == checksum(entry, length);
+}
+
+
+/***********************************************************************************************************
+ * store_stream():    Purpose: Adds the maze just written to a file to the cache, mapping the file to      *
+ *                             copy it. A stream with no file behind it (a pipe, or memory) is not         *
+ *                             stored.                                                                     *
+ *                    Parameters: const struct maze_cache *cache --> the cache                             *
+ *                                uint64_t key --> the maze's key                                          *
+ *                                FILE *maze_file --> the file, positioned after the maze                  *
+ *                                long start --> where the maze begins in it                               *
+ *                    Return value: none                                                                   *
+ *                    Side effects: - flushes the stream                                                   *
+ *                                  - adds the entry to the cache, and may remove others                   *
+ ***********************************************************************************************************/
+void store_stream(const struct maze_cache *cache, uint64_t key, FILE *maze_file, long start)
+// Requires <stdio.h> for the type "FILE *" and fflush(), fileno(), and ftell(),
+//  requires <sys/mman.h> for mmap() and munmap(),
+//  & requires cache_store()
+{
+    // Variable declarations:
+    long end = ftell(maze_file);
+    int descriptor = fileno(maze_file);
+    char *file;
+
+    if (start < 0 || end <= start || descriptor < 0 || fflush(maze_file) != 0)
+        return;
+    file = mmap(NULL, (size_t) end, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (file == MAP_FAILED)
+        return;
+    cache_store(cache, key, file + start, (size_t) (end - start));
+    (void) munmap(file, (size_t) end);
+}
+
+
+/*********************************************************************************************************
+ * trim_cache():    Purpose: Removes the least recently used entries until the rest fit the cache's      *
+ *                           limit, and any temporary file a writer left behind when it died.            *
+ *                  Parameters: const struct maze_cache *cache --> the cache                             *
+ *                  Return value: none                                                                   *
+ *                  Side effects: removes files from the cache directory                                 *
+ *********************************************************************************************************/
+void trim_cache(const struct maze_cache *cache)
+// Requires <stdio.h> for snprintf(),
+//  requires <stdlib.h> for realloc(), free(), qsort(), and strtoull(),
+//  requires <string.h> for strlen() and strncmp(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <time.h> for time(),
+//  requires <unistd.h> for unlink(),
+//  requires <dirent.h> for opendir(), readdir(), and closedir(),
+//  requires <sys/stat.h> for stat() and "struct stat",
+//  requires "cache.h" for "struct maze_cache" and macros,
+//  & requires entry_path() and compare_entries()
+{
+    // Variable declarations:
+    DIR *directory = opendir(cache->directory);
+    struct dirent *file;
+    struct stat status;
+    struct cache_entry *entries = NULL, *grown;
+    size_t count = 0, capacity = 0, length;
+    uint64_t total = 0, key;
+    char path[MAX_PATH], *end;
+
+    if (directory == NULL)
+        return;
+    while ((file = readdir(directory)) != NULL)
+    {
+        (void) snprintf(path, sizeof(path), "%s/%s", cache->directory, file->d_name);
+        if (stat(path, &status) != 0 || !S_ISREG(status.st_mode))
+            continue;
+        if (strncmp(file->d_name, CACHE_TEMPORARY, strlen(CACHE_TEMPORARY)) == 0)
+        {
+            if (status.st_mtime < time(NULL) - CACHE_STALE_SECONDS)
+                (void) unlink(path);
+            continue;
+        }
+        length = strlen(file->d_name);
+        key = strtoull(file->d_name, &end, 16);
+        if (length != 16 + strlen(CACHE_SUFFIX) || end != file->d_name + 16)
+            continue;
+        if (count == capacity)
+        {
+            capacity = capacity == 0 ? 64 : capacity * 2;
+            grown = realloc(entries, capacity * sizeof(struct cache_entry));
+            if (grown == NULL)
+                break;
+            entries = grown;
+        }
+        entries[count].used = (uint64_t) status.st_mtim.tv_sec * 1000000000 + (uint64_t) status.st_mtim.tv_nsec;
+        entries[count].size = (uint64_t) status.st_size;
+        entries[count].key = key;
+        total += entries[count++].size;
+    }
+    (void) closedir(directory);
+
+    if (total > cache->limit)
+    {
+        qsort(entries, count, sizeof(struct cache_entry), compare_entries);
+        for (size_t k = 0; k < count && total > cache->limit; k++)
+        {
+            entry_path(cache, entries[k].key, path);
+            if (unlink(path) == 0)
+                total -= entries[k].size;
+        }
+    }
+    free(entries);
+}
+
+
+/************************************************************************************************************
+ * compare_entries():    Purpose: qsort() comparator: orders entries from least to most recently used.      *
+ *                       Parameters: const void *a, const void *b --> the entries                           *
+ *                       Return value: int --> negative, zero, or positive                                  *
+ *                       Side effects: none                                                                 *
+ ************************************************************************************************************/
+int compare_entries(const void *a, const void *b)
+// Requires <stdint.h> for the type "uint64_t"
+{
+    // Variable declarations:
+    const struct cache_entry *first = a, *second = b;
+
+    return (first->used > second->used) - (first->used < second->used);
+}
@@ -0,0 +1,37 @@
+/****************************************************************************************************
+ * Name: cache.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for cache.c                                                                 *
+ ****************************************************************************************************/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stdbool.h> // for the type "bool"
+#include <stddef.h> // for the type "size_t"
+#include <stdint.h> // for the type "uint64_t"
+#include "generation.h" // for "struct generation_context"
+
+/* Object-Like Macros */
+#define CACHE_SUFFIX ".maze" // ends each entry's name, after its key in hex
+#define CACHE_MINIMUM (1 << 20) // cells below which a maze is regenerated rather than cached
+#define CACHE_DEFAULT_LIMIT 4096 // megabytes the entries may take up before the least recently used go
+
+/* Structures */
+// Where generated mazes are kept for the next request for the same one, and how much room they may take.
+struct maze_cache
+{
+    const char *directory; // NULL for no cache
+    uint64_t limit; // bytes
+};
+
+/* Function Prototypes */
+int draw_cached_maze(FILE *maze_file, int y_dimension, int x_dimension, struct generation_context *context,
+                     const struct maze_cache *cache, bool *hit);
+uint64_t cache_key(const struct generation_context *context, int y_dimension, int x_dimension);
+int cache_fetch(const struct maze_cache *cache, uint64_t key, FILE *maze_file, bool *hit);
+void cache_store(const struct maze_cache *cache, uint64_t key, const char *bytes, size_t length);
+
+#endif
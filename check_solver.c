@@ -0,0 +1,388 @@
+/****************************************************************************************************
+ * Name: check_solver.c                                                                             *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Check executable: solves random grids and generated mazes both breadth-first and from   *
+ *          both ends, and fails if the two disagree, or if the search from both ends is made in    *
+ *          a maze it cannot be trusted with (one with a loop or an open edge).                     *
+ ***************************************************************************************************/
+
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <stdio.h> // for printf() and fprintf()
+#include <stdlib.h> // for malloc(), free(), and strtoull()
+#include <string.h> // for strcmp() and memset()
+#include <stdint.h> // for the types "uint32_t" and "uint64_t"
+#include "shared.h" // for macros and error_check()
+#include "rng.h" // for rng_seed(), rng_below(), and "struct rng"
+#include "generation.h" // for init_generation(), draw_maze_cells(), and macros
+#include "maze_file.h" // for "struct maze_header"
+#include "solver.h" // for solve_maze(), "struct solution", and macros
+#include "libmaze.h" // for the status codes
+
+/* Object-Like Macros */
+#define DEFAULT_GRIDS 20000
+#define DEFAULT_SEED 20211219
+#define MAX_HEIGHT 81
+#define MAX_WIDTH 301
+// Kinds of grid, taken in turn:
+#define GRID_RANDOM 0 // each cell inside the edge open at random: loops almost everywhere
+#define GRID_TREE 1 // rooms at odd (i, j), every one joined into a single tree
+#define GRID_FOREST 2 // the same, with some joins left out, so the ends may not meet
+#define GRID_LOOPS 3 // a tree with a few more walls opened
+#define GRID_GENERATED 4 // a maze from one of the generation algorithms
+#define GRID_KINDS 5
+
+/* Parameterized Macros */
+#define PASSABLE(cell) ((cell) == FLOOR || (cell) == START || (cell) == END)
+
+/* Function Prototypes */
+void make_grid(struct rng *rng, int kind, uint64_t trial, char **maze, struct maze_header *header);
+void join_rooms(struct rng *rng, char *maze, const struct maze_header *header, uint64_t skip_in);
+void place_grid_ends(struct rng *rng, char *maze, struct maze_header *header);
+bool reference_tree(const char *maze, const struct maze_header *header);
+uint32_t find_cell_set(uint32_t *sets, uint32_t set);
+
+/*************************************************************************************************************
+ * main():    Purpose: Solves each grid both ways and compares the answers, printing the first that differ.  *
+ *            Parameters: int argc, char **argv --> optionally "--grids <number>" and "--seed <number>"      *
+ *            Return value: int --> 0 if every grid agreed, 1 if any did not, or 2 on misuse                 *
+ *            Side effects: - prints to stdout (the summary) and stderr (any disagreement)                   *
+ *                          - terminates program if memory runs out                                          *
+ ************************************************************************************************************/
+int main(int argc, char **argv)
+// Requires <stdio.h> for printf() and fprintf(),
+//  requires <stdlib.h> for free() and strtoull(),
+//  requires <string.h> for strcmp(),
+//  requires "rng.h" for rng_seed(),
+//  requires "solver.h" for solve_maze(), "struct solution", and macros,
+//  & requires make_grid() and reference_tree()
+{
+    // Variable declarations:
+    uint64_t grids = DEFAULT_GRIDS, seed = DEFAULT_SEED, failures = 0, corridor_searches = 0;
+    struct rng rng;
+    struct maze_header header;
+    struct solution breadth_first, both_ends, mislabelled;
+    char *maze;
+    int kind;
+    bool tree;
+
+    for (int k = 1; k < argc; k++)
+        if (strcmp(argv[k], "--grids") == 0 && k + 1 < argc)
+            grids = strtoull(argv[++k], NULL, 10);
+        else if (strcmp(argv[k], "--seed") == 0 && k + 1 < argc)
+            seed = strtoull(argv[++k], NULL, 10);
+        else
+        {
+            (void) printf("Usage: \"<program_filename> [--grids <number>] [--seed <number>]\"\n");
+            return 2;
+        }
+
+    rng_seed(&rng, seed);
+    for (uint64_t trial = 0; trial < grids; trial++)
+    {
+        kind = (int) (trial % GRID_KINDS);
+        make_grid(&rng, kind, trial, &maze, &header);
+        tree = reference_tree(maze, &header);
+        solve_maze(maze, &header, SOLVER_BFS, &breadth_first);
+        solve_maze(maze, &header, SOLVER_BIDIRECTIONAL, &both_ends);
+        corridor_searches += both_ends.method == SOLVER_BIDIRECTIONAL;
+
+        // Every generated maze is a tree with a closed edge, and the other kinds are searched from both
+        //  ends exactly when they are:
+        if (breadth_first.solved != both_ends.solved
+            || (breadth_first.solved && breadth_first.path_length != both_ends.path_length)
+            || breadth_first.open_cells != both_ends.open_cells
+            || breadth_first.expanded > breadth_first.open_cells || both_ends.expanded > both_ends.open_cells
+            || (both_ends.method == SOLVER_BIDIRECTIONAL) != tree || (kind == GRID_GENERATED && !tree))
+        {
+            (void) fprintf(stderr, "Grid %llu (kind %d, algorithm %u, %ux%u): breadth-first %s in %llu, %llu of"
+                           " %llu expanded; from both ends (method %d) %s in %llu, %llu of %llu expanded;"
+                           " %s a tree with a closed edge\n",
+                           (unsigned long long) trial, kind, header.algorithm, header.x_dimension,
+                           header.y_dimension, breadth_first.solved ? "solved" : "unsolved",
+                           (unsigned long long) breadth_first.path_length,
+                           (unsigned long long) breadth_first.expanded, (unsigned long long) breadth_first.open_cells,
+                           both_ends.method, both_ends.solved ? "solved" : "unsolved",
+                           (unsigned long long) both_ends.path_length, (unsigned long long) both_ends.expanded,
+                           (unsigned long long) both_ends.open_cells, tree ? "is" : "not");
+            failures++;
+        }
+
+        // A grid with loops whose header claims it was generated must still be found out, and searched
+        //  breadth-first, so its answer is the same:
+        if (!tree && kind != GRID_GENERATED)
+        {
+            header.algorithm = ALGORITHM_CLASSIC;
+            solve_maze(maze, &header, SOLVER_BIDIRECTIONAL, &mislabelled);
+            if (mislabelled.method != SOLVER_BFS || mislabelled.solved != breadth_first.solved
+                || mislabelled.path_length != breadth_first.path_length
+                || mislabelled.expanded != breadth_first.expanded)
+            {
+                (void) fprintf(stderr, "Grid %llu (kind %d, %ux%u), labelled as generated: method %d %s in %llu,"
+                               " %llu of %llu expanded\n", (unsigned long long) trial, kind, header.x_dimension,
+                               header.y_dimension, mislabelled.method, mislabelled.solved ? "solved" : "unsolved",
+                               (unsigned long long) mislabelled.path_length, (unsigned long long) mislabelled.expanded,
+                               (unsigned long long) mislabelled.open_cells);
+                failures++;
+            }
+        }
+        free(maze);
+    }
+
+    (void) printf("%llu grids, %llu searched from both ends, %llu disagreed\n", (unsigned long long) grids,
+                  (unsigned long long) corridor_searches, (unsigned long long) failures);
+    return failures > 0;
+}
+
+
+/*************************************************************************************************************
+ * make_grid():    Purpose: Makes a grid of the given kind, of random size, with its Start and End on the    *
+ *                          edge. One grid in eight of the kinds not generated has a hole in its edge.       *
+ *                 Parameters: struct rng *rng --> the random number generator                               *
+ *                             int kind --> one of the GRID_ macros                                          *
+ *                             uint64_t trial --> the grid's number, which picks the algorithm to generate   *
+ *                                                with                                                       *
+ *                             char **maze --> where to store the new grid; free() it when done              *
+ *                             struct maze_header *header --> where to store its header                      *
+ *                 Return value: none                                                                        *
+ *                 Side effects: - advances *rng                                                             *
+ *                               - modifies *maze and *header, and allocates the grid                        *
+ *                               - terminates program if memory runs out, or generation fails                *
+ ************************************************************************************************************/
+void make_grid(struct rng *rng, int kind, uint64_t trial, char **maze, struct maze_header *header)
+// Requires <stdlib.h> for malloc(),
+//  requires <string.h> for memset(),
+//  requires "shared.h" for macros, error_check(), and status_check(),
+//  requires "rng.h" for rng_below() and rng_next(),
+//  requires "generation.h" for init_generation(), draw_maze_cells(), and macros,
+//  & requires join_rooms() and place_grid_ends()
+{
+    // Variable declarations:
+    struct generation_context context;
+    uint32_t height, width, i, j;
+    uint64_t cells;
+
+    (void) memset(header, 0, sizeof(*header));
+    header->version = HEADER_VERSION;
+    header->size = HEADER_SIZE;
+    header->algorithm = ALGORITHMS; // none: a grid made here is not trusted to be a tree
+    if (kind == GRID_GENERATED)
+    {
+        height = MIN_DIMENSION + (uint32_t) rng_below(rng, MAX_HEIGHT - MIN_DIMENSION + 1);
+        width = MIN_DIMENSION + (uint32_t) rng_below(rng, MAX_WIDTH - MIN_DIMENSION + 1);
+    }
+    else
+    {
+        height = 3 + (uint32_t) rng_below(rng, MAX_HEIGHT - 2);
+        width = 3 + (uint32_t) rng_below(rng, MAX_WIDTH - 2);
+    }
+    cells = (uint64_t) height * width;
+    *maze = malloc((size_t) cells);
+    error_check("malloc()", 1, *maze != NULL, NULL);
+    header->y_dimension = height;
+    header->x_dimension = width;
+
+    if (kind == GRID_GENERATED)
+    {
+        init_generation(&context, rng_next(rng));
+        context.algorithm = (int) (trial / GRID_KINDS % ALGORITHMS);
+        context.threads = 2;
+        status_check(draw_maze_cells(*maze, (int) height, (int) width, &context, header), NULL);
+        return;
+    }
+
+    (void) memset(*maze, WALL, (size_t) cells);
+    for (i = 0; i < height; i++)
+        for (j = 0; j < width; j++)
+            if (i == 0 || j == 0 || i + 1 == height || j + 1 == width)
+                (*maze)[(size_t) i * width + j] = BORDER;
+            else if (kind == GRID_RANDOM && rng_below(rng, 5) < 3)
+                (*maze)[(size_t) i * width + j] = FLOOR;
+    if (kind != GRID_RANDOM)
+        join_rooms(rng, *maze, header, kind == GRID_FOREST ? 5 : 0);
+    if (kind == GRID_LOOPS)
+        for (uint64_t k = rng_below(rng, 4); k > 0; k--)
+            (*maze)[(1 + rng_below(rng, height - 2)) * width + 1 + rng_below(rng, width - 2)] = FLOOR;
+    if (rng_below(rng, 8) == 0)
+        (*maze)[rng_below(rng, 2) * (height - 1) * width + rng_below(rng, width)] = FLOOR;
+    place_grid_ends(rng, *maze, header);
+}
+
+
+/**************************************************************************************************************
+ * join_rooms():    Purpose: Opens the rooms at odd (i, j) inside the edge, and the walls between them in     *
+ *                           random order wherever they join two sets of rooms, as Kruskal's algorithm does.  *
+ *                  Parameters: struct rng *rng --> the random number generator                               *
+ *                              char *maze --> the grid, all WALL inside its BORDER                           *
+ *                              const struct maze_header *header --> its dimensions                           *
+ *                              uint64_t skip_in --> leave out one join in this many at random (0: none)      *
+ *                  Return value: none                                                                        *
+ *                  Side effects: - advances *rng                                                             *
+ *                                - modifies the grid                                                         *
+ *                                - terminates program if memory runs out                                     *
+ *************************************************************************************************************/
+void join_rooms(struct rng *rng, char *maze, const struct maze_header *header, uint64_t skip_in)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires "shared.h" for macros and error_check(),
+//  requires "rng.h" for rng_below(),
+//  & requires find_cell_set()
+{
+    // Variable declarations:
+    uint64_t width = header->x_dimension, height = header->y_dimension, cells = width * height;
+    uint64_t *walls = malloc((size_t) cells * sizeof(uint64_t)), wall, count = 0, k, pick;
+    uint32_t *sets = malloc((size_t) cells * sizeof(uint32_t)), a, b;
+
+    error_check("malloc()", 1, walls != NULL && sets != NULL, NULL);
+    for (uint64_t i = 1; i + 1 < height; i += 2)
+        for (uint64_t j = 1; j + 1 < width; j += 2)
+        {
+            maze[i * width + j] = FLOOR;
+            sets[i * width + j] = (uint32_t) (i * width + j);
+            if (j + 3 < width)
+                walls[count++] = i * width + j + 1;
+            if (i + 3 < height)
+                walls[count++] = (i + 1) * width + j;
+        }
+
+    // Shuffled, then each wall opened if the rooms either side are not yet joined:
+    for (k = count; k > 1; k--)
+    {
+        pick = rng_below(rng, k);
+        wall = walls[pick];
+        walls[pick] = walls[k - 1];
+        walls[k - 1] = wall;
+    }
+    for (k = 0; k < count; k++)
+    {
+        wall = walls[k];
+        a = (wall / width) % 2 == 1 ? (uint32_t) (wall - 1) : (uint32_t) (wall - width);
+        b = (wall / width) % 2 == 1 ? (uint32_t) (wall + 1) : (uint32_t) (wall + width);
+        a = find_cell_set(sets, a);
+        b = find_cell_set(sets, b);
+        if (a != b && (skip_in == 0 || rng_below(rng, skip_in) != 0))
+        {
+            sets[a] = b;
+            maze[wall] = FLOOR;
+        }
+    }
+
+    free(walls);
+    free(sets);
+}
+
+
+/***************************************************************************************************************
+ * place_grid_ends():    Purpose: Puts the Start and End on the edge, each beside a cell inside it (or in a    *
+ *                                corner, if the grid is too small to have one beside it). One grid in sixteen *
+ *                                has its End on its Start.                                                    *
+ *                       Parameters: struct rng *rng --> the random number generator                           *
+ *                                   char *maze --> the grid                                                   *
+ *                                   struct maze_header *header --> where to store the ends                    *
+ *                       Return value: none                                                                    *
+ *                       Side effects: - advances *rng                                                         *
+ *                                     - modifies the grid and *header                                         *
+ **************************************************************************************************************/
+void place_grid_ends(struct rng *rng, char *maze, struct maze_header *header)
+// Requires "shared.h" for macros,
+//  & requires "rng.h" for rng_below()
+{
+    // Variable declarations:
+    uint32_t width = header->x_dimension, height = header->y_dimension, ends[2][2];
+
+    for (int k = 0; k < 2; k++)
+    {
+        // Top or bottom, at an odd column, so that it meets a room:
+        if (rng_below(rng, 2) == 0)
+        {
+            ends[k][0] = rng_below(rng, 2) == 0 ? 0 : height - 1;
+            ends[k][1] = 1 + 2 * (uint32_t) rng_below(rng, (width - 1) / 2);
+        }
+        // Left or right, at an odd row:
+        else
+        {
+            ends[k][0] = 1 + 2 * (uint32_t) rng_below(rng, (height - 1) / 2);
+            ends[k][1] = rng_below(rng, 2) == 0 ? 0 : width - 1;
+        }
+    }
+    if (rng_below(rng, 16) == 0)
+        ends[1][0] = ends[0][0], ends[1][1] = ends[0][1];
+
+    header->start_y = ends[0][0];
+    header->start_x = ends[0][1];
+    header->end_y = ends[1][0];
+    header->end_x = ends[1][1];
+    maze[(size_t) ends[1][0] * width + ends[1][1]] = END;
+    maze[(size_t) ends[0][0] * width + ends[0][1]] = START;
+}
+
+
+/*************************************************************************************************************
+ * reference_tree():    Purpose: Tells, the slow and obvious way, whether the search from both ends may be   *
+ *                               made in a grid: no two open cells joined twice over (a union-find over      *
+ *                               every cell, one join at a time), and no open cell on the edge but the       *
+ *                               Start and End.                                                              *
+ *                      Parameters: const char *maze --> the grid                                            *
+ *                                  const struct maze_header *header --> its header                          *
+ *                      Return value: bool --> true if the grid has no loop and a closed edge                *
+ *                      Side effects: terminates program if memory runs out                                  *
+ ************************************************************************************************************/
+bool reference_tree(const char *maze, const struct maze_header *header)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires "shared.h" for macros and error_check(),
+//  & requires find_cell_set()
+{
+    // Variable declarations:
+    uint64_t width = header->x_dimension, height = header->y_dimension, cell, other;
+    uint64_t start = (uint64_t) header->start_y * width + header->start_x;
+    uint64_t end = (uint64_t) header->end_y * width + header->end_x;
+    uint32_t *sets = malloc((size_t) (width * height) * sizeof(uint32_t)), a, b;
+    bool tree = true;
+
+    error_check("malloc()", 1, sets != NULL, NULL);
+    for (cell = 0; cell < width * height; cell++)
+        sets[cell] = (uint32_t) cell;
+
+    for (uint64_t i = 0; i < height && tree; i++)
+        for (uint64_t j = 0; j < width && tree; j++)
+        {
+            cell = i * width + j;
+            if (!PASSABLE(maze[cell]))
+                continue;
+            if ((i == 0 || j == 0 || i + 1 == height || j + 1 == width) && cell != start && cell != end)
+                tree = false;
+            // Join to the open cells above and to the left:
+            for (int k = 0; k < 2 && tree; k++)
+            {
+                if (k == 0 ? i == 0 : j == 0)
+                    continue;
+                other = k == 0 ? cell - width : cell - 1;
+                if (!PASSABLE(maze[other]))
+                    continue;
+                a = find_cell_set(sets, (uint32_t) cell);
+                b = find_cell_set(sets, (uint32_t) other);
+                tree = a != b;
+                sets[a] = b;
+            }
+        }
+
+    free(sets);
+    return tree;
+}
+
+
+/***************************************************************************************************************
+ * find_cell_set():    Purpose: Finds the set a cell belongs to, halving the path on the way.                  *
+ *                     Parameters: uint32_t *sets --> the union-find forest                                    *
+ *                                 uint32_t set --> the cell                                                   *
+ *                     Return value: uint32_t --> the set's root                                               *
+ *                     Side effects: modifies sets[]                                                           *
+ **************************************************************************************************************/
+uint32_t find_cell_set(uint32_t *sets, uint32_t set)
+{
+    while (sets[set] != set)
+    {
+        sets[set] = sets[sets[set]];
+        set = sets[set];
+    }
+    return set;
+}
@@ -0,0 +1,276 @@
+/****************************************************************************************************
+ * Name: eller.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements a streaming maze generator after Eller's algorithm. The maze is written a    *
+ *          row at a time, keeping only a few rows' worth of state however tall it is.              *
+ ****************************************************************************************************/
+
+#include <stdio.h> // for the type "FILE *" and fwrite(), ftell(), and fseek()
+#include <stdlib.h> // for malloc() and free()
+#include <string.h> // for memcpy()
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include "shared.h" // for macros
+#include "rng.h" // for rng_next() and rng_below()
+#include "generation.h" // for "struct generation_context" and macros
+#include "maze_file.h" // for write_header() and "struct maze_header"
+#include "packed.h" // for packed_begin(), packed_put_row(), packed_finish(), and "struct packed_writer"
+#include "eller.h" // for draw_eller()
+#include "libmaze.h" // for the MAZE_ status codes
+
+/* Object-Like Macros */
+#define NO_DROP -1
+
+/* Parameterized Macros */
+// Rooms are the cells at odd (i, j); the cells between two rooms are opened to join them:
+#define ROOM_TO_CELL(k) (2 * (k) + 1)
+#define FLIP_COIN (rng_next(&context->rng) >> 63)
+
+/* Structures */
+// Where draw_eller() sends each finished row: to a file, as chars or packed, or to a grid in memory.
+struct row_output
+{
+    FILE *maze_file;
+    struct packed_writer *writer; // NULL unless the file is packed
+    char *cells; // NULL unless writing to memory; moves on a row at a time
+    int x_dimension;
+    int status; // MAZE_OK, or the first failure, after which nothing more is written
+};
+
+/* Internal Function Prototypes */
+int find_set(int *set, int room);
+void write_row(struct row_output *output, const char *row);
+
+/**************************************************************************************************************
+ * draw_eller():    Purpose: Generates a maze row by row with Eller's algorithm and writes each row as        *
+ *                           soon as it is final. Each room of the current row belongs to a set of rooms      *
+ *                           already joined above; neighbouring rooms of different sets are joined at         *
+ *                           random, then every set drops at least one passage into the next row.             *
+ *                           The last row joins all remaining sets, so the maze is a single tree.             *
+ *                           Memory is a handful of arrays as long as a row, whatever the height.             *
+ *                           The header is written last, over a placeholder, once the End is known.           *
+ *                           Rows can go to a grid in memory instead, for callers that want the               *
+ *                           maze without a file.                                                             *
+ *                  Parameters: FILE *maze_file --> the seekable file to write to, or NULL                    *
+ *                              char *cells --> if maze_file is NULL, the y_dimension * x_dimension           *
+ *                                              chars to fill instead                                         *
+ *                              int y_dimension --> the height of the maze (in characters)                    *
+ *                              int x_dimension --> the width of the maze (in characters)                     *
+ *                              struct generation_context *context --> the seeded context                     *
+ *                              struct maze_header *described --> where to store the header as well,          *
+ *                                                                or NULL                                     *
+ *                  Return value: int --> MAZE_OK, or the failure (see libmaze.h)                             *
+ *                  Side effects: - advances the context's random number generator                            *
+ *                                - modifies the file pointed to by maze_file, or the cells                   *
+ *                                - modifies *described                                                       *
+ **************************************************************************************************************/
+int draw_eller(FILE *maze_file, char *cells, int y_dimension, int x_dimension, struct generation_context *context,
+               struct maze_header *described)
+// Requires <stdio.h> for the type "FILE *", ftell(), and fseek(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <stdbool.h> for the type "bool",
+//  requires "shared.h" for macros,
+//  requires "rng.h" for rng_next() and rng_below(),
+//  requires "generation.h" for "struct generation_context",
+//  requires "maze_file.h" for write_header(), "struct maze_header", and macros,
+//  requires "packed.h" for packed_begin(), packed_finish(), and "struct packed_writer",
+//  requires "libmaze.h" for the status codes,
+//  & requires find_set() and write_row()
+{
+    // Variable declarations:
+    int rooms_y = (y_dimension - 1) / 2, rooms_x = (x_dimension - 1) / 2;
+    int *set = malloc(sizeof(int) * rooms_x); // a union-find forest over the current row's rooms
+    int *members = malloc(sizeof(int) * rooms_x); // rooms of each set not yet considered for a drop
+    int *drop = malloc(sizeof(int) * rooms_x); // per set, the first room that dropped into the next row
+    int *next = malloc(sizeof(int) * rooms_x); // the next row's sets, as they are decided
+    char *row = malloc(x_dimension);
+    struct maze_header header = {0};
+    long header_position = 0, end_position;
+    struct packed_writer packed;
+    struct row_output output = {maze_file, NULL, cells, x_dimension, MAZE_OK};
+    int root;
+    bool last;
+
+    if (set == NULL || members == NULL || drop == NULL || next == NULL || row == NULL)
+        output.status = MAZE_ERROR_MEMORY;
+
+    // Leave room for the header, which is only complete once the End has been placed:
+    header.version = HEADER_VERSION;
+    header.encoding = (uint8_t) context->encoding;
+    header.size = HEADER_SIZE;
+    header.x_dimension = x_dimension;
+    header.y_dimension = y_dimension;
+    header.seed = context->seed;
+    header.algorithm = ALGORITHM_ELLER;
+    if (maze_file != NULL && output.status == MAZE_OK)
+    {
+        header_position = ftell(maze_file);
+        output.status = header_position < 0 ? MAZE_ERROR_SEEK : write_header(maze_file, &header);
+        if (output.status == MAZE_OK && context->encoding == ENCODING_PACKED)
+        {
+            output.status = packed_begin(&packed, maze_file, y_dimension, x_dimension);
+            output.writer = &packed;
+        }
+    }
+    if (output.status != MAZE_OK)
+    {
+        free(set);
+        free(members);
+        free(drop);
+        free(next);
+        free(row);
+        return output.status;
+    }
+
+    // The Start is a random room of the first row, and the End a random room of the last:
+    header.start_y = ROOM_TO_CELL(0);
+    header.start_x = ROOM_TO_CELL(rng_below(&context->rng, rooms_x));
+    header.end_y = ROOM_TO_CELL(rooms_y - 1);
+    header.end_x = ROOM_TO_CELL(rng_below(&context->rng, rooms_x));
+
+    // Top border:
+    for (int j = 0; j < x_dimension; j++)
+        row[j] = BORDER;
+    write_row(&output, row);
+
+    // Every room of the first row starts in a set of its own:
+    for (int k = 0; k < rooms_x; k++)
+        set[k] = k;
+
+    for (int r = 0; r < rooms_y; r++)
+    {
+        last = r == rooms_y - 1;
+
+        // Row of rooms: join neighbours of different sets at random (always, on the last row):
+        for (int j = 1; j < x_dimension - 1; j++)
+            row[j] = WALL;
+        for (int k = 0; k < rooms_x; k++)
+        {
+            row[ROOM_TO_CELL(k)] = FLOOR;
+            if (k + 1 < rooms_x && (last || FLIP_COIN) && (root = find_set(set, k)) != find_set(set, k + 1))
+            {
+                set[find_set(set, k + 1)] = root;
+                row[ROOM_TO_CELL(k) + 1] = FLOOR;
+            }
+        }
+        if (r == 0)
+            row[header.start_x] = START;
+        if (last)
+            row[header.end_x] = END;
+        write_row(&output, row);
+        if (last)
+            break;
+
+        // Row between rooms: drop passages at random, but at least one per set so none is cut off:
+        for (int k = 0; k < rooms_x; k++)
+        {
+            members[k] = 0;
+            drop[k] = NO_DROP;
+        }
+        for (int k = 0; k < rooms_x; k++)
+            members[find_set(set, k)]++;
+        for (int j = 1; j < x_dimension - 1; j++)
+            row[j] = WALL;
+        for (int k = 0; k < rooms_x; k++)
+        {
+            root = find_set(set, k);
+            members[root]--;
+            if (FLIP_COIN || (members[root] == 0 && drop[root] == NO_DROP))
+            {
+                row[ROOM_TO_CELL(k)] = FLOOR;
+                if (drop[root] == NO_DROP)
+                    drop[root] = k;
+                // Rooms below a drop stay in its set, which is rooted at its first drop in the next row:
+                next[k] = drop[root];
+            }
+            else
+                next[k] = k; // a room without a drop above it starts a set of its own
+        }
+        write_row(&output, row);
+
+        // Carry the sets down:
+        for (int k = 0; k < rooms_x; k++)
+            set[k] = next[k];
+    }
+
+    // A maze with an even height has one more row of wall before the bottom border:
+    if (y_dimension % 2 == 0)
+    {
+        for (int j = 1; j < x_dimension - 1; j++)
+            row[j] = WALL;
+        write_row(&output, row);
+    }
+    for (int j = 0; j < x_dimension; j++)
+        row[j] = BORDER;
+    write_row(&output, row);
+
+    // Go back and complete the header, then leave the file positioned after the maze (by offset rather
+    //  than SEEK_END, which a memory stream takes to be wherever it was last written):
+    if (output.writer != NULL) // rows only fail here through the writer, so its status is the output's
+        output.status = packed_finish(output.writer);
+    if (maze_file != NULL && output.status == MAZE_OK)
+    {
+        end_position = ftell(maze_file);
+        output.status = end_position < 0 || fseek(maze_file, header_position, SEEK_SET) != 0 ? MAZE_ERROR_SEEK
+                        : write_header(maze_file, &header);
+        if (output.status == MAZE_OK && fseek(maze_file, end_position, SEEK_SET) != 0)
+            output.status = MAZE_ERROR_SEEK;
+    }
+    if (described != NULL)
+        *described = header;
+
+    free(set);
+    free(members);
+    free(drop);
+    free(next);
+    free(row);
+    return output.status;
+}
+
+
+/**********************************************************************************************
+ * find_set():    Purpose: Finds the set a room belongs to, halving the path as it goes.      *
+ *                Parameters: int *set --> the union-find forest of the current row           *
+ *                            int room --> the room to look up                                *
+ *                Return value: int --> the room at the root of the set                       *
+ *                Side effects: shortens paths in set[]                                       *
+ **********************************************************************************************/
+int find_set(int *set, int room)
+{
+    while (set[room] != room)
+    {
+        set[room] = set[set[room]];
+        room = set[room];
+    }
+    return room;
+}
+
+
+/************************************************************************************************************
+ * write_row():    Purpose: Sends one finished row of cells on: to file, as chars or packed, or to the      *
+ *                          next row of the grid in memory.                                                 *
+ *                 Parameters: struct row_output *output --> where the row goes                             *
+ *                             const char *row --> the row's cells                                          *
+ *                 Return value: none                                                                       *
+ *                 Side effects: - modifies the file or the grid, and *output                               *
+ *                               - sets the output's status if the row cannot be written; does              *
+ *                                 nothing if it is already set                                             *
+ ************************************************************************************************************/
+void write_row(struct row_output *output, const char *row)
+// Requires <stdio.h> for fwrite(),
+//  requires <string.h> for memcpy(),
+//  requires "packed.h" for packed_put_row(),
+//  & requires "libmaze.h" for the status codes
+{
+    if (output->status != MAZE_OK)
+        return;
+    if (output->cells != NULL)
+    {
+        (void) memcpy(output->cells, row, (size_t) output->x_dimension);
+        output->cells += output->x_dimension;
+    }
+    else if (output->writer != NULL)
+        output->status = packed_put_row(output->writer, row);
+    else if (fwrite(row, output->x_dimension, 1, output->maze_file) != 1)
+        output->status = MAZE_ERROR_WRITE;
+}
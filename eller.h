@@ -0,0 +1,19 @@
+/****************************************************************************************************
+ * Name: eller.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for eller.c                                                                 *
+ ****************************************************************************************************/
+
+#ifndef ELLER_H
+#define ELLER_H
+
+#include <stdio.h> // for the type "FILE *"
+#include "generation.h" // for "struct generation_context"
+#include "maze_file.h" // for "struct maze_header"
+
+/* Function Prototypes */
+int draw_eller(FILE *maze_file, char *cells, int y_dimension, int x_dimension, struct generation_context *context,
+               struct maze_header *described);
+
+#endif
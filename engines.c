@@ -0,0 +1,413 @@
+/****************************************************************************************************
+ * Name: engines.c                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements the generation engines that work on rooms rather than single cells: a        *
+ *          recursive backtracker, Kruskal's, Prim's, and Wilson's algorithms. Like Eller's         *
+ *          algorithm, each treats the cells at odd (i, j) as rooms and joins neighbouring rooms    *
+ *          by opening the cell between them, so every maze is a spanning tree of the rooms.        *
+ ****************************************************************************************************/
+
+#include <stdlib.h> // for malloc() and free()
+#include <stdint.h> // for the types "uint8_t", "uint32_t", and "uint64_t"
+#include "rng.h" // for rng_next() and rng_below()
+#include "generation.h" // for "struct generation_context"
+#include "bitgrid.h" // for "struct bitgrid" and its functions and macros
+#include "engines.h" // for the engines' prototypes
+#include "libmaze.h" // for the MAZE_ status codes
+
+/* Object-Like Macros */
+#define DIRECTIONS 4
+#define GO_UP 0
+#define GO_DOWN 1
+#define GO_LEFT 2
+#define GO_RIGHT 3
+#define PICK_LIMIT ((uint64_t) 1 << 32) // PICK() is exact for counts up to here
+
+/* Parameterized Macros */
+// Room (r, c) is the cell (2r + 1, 2c + 1); the cell between two neighbouring rooms joins them:
+#define ROOM_TO_CELL(k) (2 * (k) + 1)
+#define CELL_TO_ROOM(k) (((k) - 1) / 2)
+#define OPEN_ROOM(grid, r, c) BITGRID_SET(grid, ROOM_TO_CELL(r), ROOM_TO_CELL(c))
+#define ROOM_IS_OPEN(grid, r, c) BITGRID_TEST(grid, ROOM_TO_CELL(r), ROOM_TO_CELL(c))
+#define OPEN_BETWEEN(grid, r1, c1, r2, c2) BITGRID_SET(grid, (r1) + (r2) + 1, (c1) + (c2) + 1)
+#define IN_ROOMS(r, c, rooms_y, rooms_x) ((r) >= 0 && (r) < (rooms_y) && (c) >= 0 && (c) < (rooms_x))
+// A row and column as one word, for the stacks and lists of rooms and walls:
+#define PACK(row, column) ((uint64_t) (row) << 32 | (uint32_t) (column))
+#define PACKED_ROW(packed) ((int) ((packed) >> 32))
+#define PACKED_COLUMN(packed) ((int) ((packed) & 0xFFFFFFFF))
+// A uniform value in [0, count) from one draw and no division, for counts up to PICK_LIMIT:
+#define PICK(count) ((rng_next(&context->rng) >> 32) * (uint64_t) (count) >> 32)
+
+/* Global Variables */
+// The row and column each GO_ step moves by, from one room to the next:
+const int room_step_y[DIRECTIONS] = {-1, 1, 0, 0};
+const int room_step_x[DIRECTIONS] = {0, 0, -1, 1};
+
+/* Internal Function Prototypes */
+void place_ends(struct generation_context *context, struct bitgrid *grid, int rooms_y, int rooms_x);
+uint32_t find_room_set(uint32_t *parent, uint32_t room);
+
+/*************************************************************************************************************
+ * carve_backtracker():    Purpose: Carves a maze with the recursive backtracker: a walk from the Start      *
+ *                                  that always steps into an unvisited room when it can, and backs up       *
+ *                                  when it cannot. The recursion is an explicit stack of the rooms on       *
+ *                                  the current path, so the deepest maze needs no more than the heap.       *
+ *                                  Its mazes have few, long corridors.                                      *
+ *                         Parameters: struct generation_context *context --> the seeded context             *
+ *                                     struct bitgrid *grid --> the all-WALL grid to carve                   *
+ *                         Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY (the grid is then             *
+ *                                               left as it was)                                             *
+ *                         Side effects: - advances the context's random number generator                    *
+ *                                       - modifies the grid, including its Start and End                    *
+ *************************************************************************************************************/
+int carve_backtracker(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "rng.h" for rng_next(),
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires place_ends()
+{
+    // Variable declarations:
+    int rooms_y = (grid->y_dimension - 1) / 2, rooms_x = (grid->x_dimension - 1) / 2;
+    uint64_t *stack = malloc(sizeof(uint64_t) * (size_t) rooms_y * rooms_x); // the path back to the Start
+    size_t depth = 0;
+    int r, c, next_r, next_c, options[DIRECTIONS], count, step;
+
+    if (stack == NULL)
+        return MAZE_ERROR_MEMORY;
+    place_ends(context, grid, rooms_y, rooms_x);
+
+    r = CELL_TO_ROOM(grid->start_y);
+    c = CELL_TO_ROOM(grid->start_x);
+    OPEN_ROOM(grid, r, c);
+    stack[depth++] = PACK(r, c);
+    while (depth > 0)
+    {
+        // Gather the unvisited rooms next to the one on top of the stack:
+        r = PACKED_ROW(stack[depth - 1]);
+        c = PACKED_COLUMN(stack[depth - 1]);
+        count = 0;
+        for (int d = 0; d < DIRECTIONS; d++)
+        {
+            next_r = r + room_step_y[d];
+            next_c = c + room_step_x[d];
+            if (IN_ROOMS(next_r, next_c, rooms_y, rooms_x) && !ROOM_IS_OPEN(grid, next_r, next_c))
+                options[count++] = d;
+        }
+
+        // Back up if there are none, or else step into one at random:
+        if (count == 0)
+        {
+            depth--;
+            continue;
+        }
+        step = options[PICK(count)];
+        next_r = r + room_step_y[step];
+        next_c = c + room_step_x[step];
+        OPEN_BETWEEN(grid, r, c, next_r, next_c);
+        OPEN_ROOM(grid, next_r, next_c);
+        stack[depth++] = PACK(next_r, next_c);
+    }
+
+    free(stack);
+    return MAZE_OK;
+}
+
+
+/***********************************************************************************************************
+ * carve_kruskal():    Purpose: Carves a maze with Kruskal's algorithm: every room starts in a set of      *
+ *                              its own, and the walls between neighbouring rooms are taken in random      *
+ *                              order, each opened if the rooms on either side are in different sets,      *
+ *                              which it then joins. The sets are a union-find forest over a flat          *
+ *                              array, joined by rank and with path halving. Its mazes have many           *
+ *                              short dead ends.                                                           *
+ *                     Parameters: struct generation_context *context --> the seeded context               *
+ *                                 struct bitgrid *grid --> the all-WALL grid to carve                     *
+ *                     Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY (the grid is then left          *
+ *                                           as it was)                                                    *
+ *                     Side effects: - advances the context's random number generator                      *
+ *                                   - modifies the grid, including its Start and End                      *
+ ***********************************************************************************************************/
+int carve_kruskal(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <stdint.h> for the types "uint8_t", "uint32_t", and "uint64_t",
+//  requires "rng.h" for rng_next() and rng_below(),
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires place_ends() and find_room_set()
+{
+    // Variable declarations:
+    int rooms_y = (grid->y_dimension - 1) / 2, rooms_x = (grid->x_dimension - 1) / 2;
+    size_t rooms = (size_t) rooms_y * rooms_x, walls = 0, joins = 0, room, pick;
+    uint32_t *parent = malloc(sizeof(uint32_t) * rooms); // rooms are fewer than 2^32 (see MAX_DIMENSION)
+    uint8_t *rank = malloc(rooms); // per root, a bound on its tree's height (at most log2 of the rooms)
+    uint64_t *wall = malloc(sizeof(uint64_t) * 2 * rooms); // each room's walls to its right and below, as cells
+    uint64_t taken;
+    uint32_t set, other;
+    int i, j;
+
+    if (parent == NULL || rank == NULL || wall == NULL)
+    {
+        free(parent);
+        free(rank);
+        free(wall);
+        return MAZE_ERROR_MEMORY;
+    }
+    place_ends(context, grid, rooms_y, rooms_x);
+
+    // Every room starts as a set of its own, with the walls to its right and below (if any) to consider:
+    for (int r = 0; r < rooms_y; r++)
+        for (int c = 0; c < rooms_x; c++)
+        {
+            room = (size_t) r * rooms_x + c;
+            parent[room] = (uint32_t) room;
+            rank[room] = 0;
+            OPEN_ROOM(grid, r, c);
+            if (c + 1 < rooms_x)
+                wall[walls++] = PACK(ROOM_TO_CELL(r), ROOM_TO_CELL(c) + 1);
+            if (r + 1 < rooms_y)
+                wall[walls++] = PACK(ROOM_TO_CELL(r) + 1, ROOM_TO_CELL(c));
+        }
+
+    // Shuffle the walls first: its random reads do not wait on one another, as they would between finds:
+    for (size_t k = 0; k + 1 < walls; k++)
+    {
+        pick = k + (walls - k <= PICK_LIMIT ? PICK(walls - k) : rng_below(&context->rng, walls - k));
+        taken = wall[pick];
+        wall[pick] = wall[k];
+        wall[k] = taken;
+    }
+
+    // Take the walls in that order until every room is in one set:
+    for (size_t k = 0; joins + 1 < rooms; k++)
+    {
+        taken = wall[k];
+
+        // A wall in an odd row joins the rooms left and right of it; one in an even row, those above and below:
+        i = PACKED_ROW(taken);
+        j = PACKED_COLUMN(taken);
+        room = (size_t) CELL_TO_ROOM(i - (~i & 1)) * rooms_x + CELL_TO_ROOM(j - (~j & 1));
+        set = find_room_set(parent, (uint32_t) room);
+        other = find_room_set(parent, (uint32_t) (room + (i & 1 ? 1 : (size_t) rooms_x)));
+        if (set != other)
+        {
+            // Hang the shorter tree under the taller, so that finding a set stays quick:
+            if (rank[set] > rank[other])
+                parent[other] = set;
+            else
+            {
+                parent[set] = other;
+                rank[other] += rank[set] == rank[other];
+            }
+            joins++;
+            BITGRID_SET(grid, i, j);
+        }
+    }
+
+    free(parent);
+    free(rank);
+    free(wall);
+    return MAZE_OK;
+}
+
+
+/*********************************************************************************************************
+ * carve_prim():    Purpose: Carves a maze with a randomized Prim's algorithm: the tree grows from       *
+ *                           the Start by adding a random room from its frontier (the rooms next to      *
+ *                           it), each joined to a random neighbour already in the tree. Its mazes       *
+ *                           branch often near every part of the tree.                                   *
+ *                  Parameters: struct generation_context *context --> the seeded context                *
+ *                              struct bitgrid *grid --> the all-WALL grid to carve                      *
+ *                  Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY (the grid is then left as        *
+ *                                        it was)                                                        *
+ *                  Side effects: - advances the context's random number generator                       *
+ *                                - modifies the grid, including its Start and End                       *
+ *********************************************************************************************************/
+int carve_prim(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "rng.h" for rng_next(),
+//  requires "bitgrid.h" for "struct bitgrid" and its functions and macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires place_ends()
+{
+    // Variable declarations:
+    int rooms_y = (grid->y_dimension - 1) / 2, rooms_x = (grid->x_dimension - 1) / 2;
+    uint64_t *frontier = malloc(sizeof(uint64_t) * (size_t) rooms_y * rooms_x);
+    struct bitgrid queued; // one bit per room: whether it has been put on the frontier
+    size_t count = 0, k;
+    int r, c, next_r, next_c, options[DIRECTIONS], joinable;
+
+    if (frontier == NULL)
+        return MAZE_ERROR_MEMORY;
+    if (!bitgrid_create(&queued, rooms_y, rooms_x))
+    {
+        free(frontier);
+        return MAZE_ERROR_MEMORY;
+    }
+    place_ends(context, grid, rooms_y, rooms_x);
+
+    // The Start is the first room on the frontier, and the only one with no neighbour in the tree:
+    r = CELL_TO_ROOM(grid->start_y);
+    c = CELL_TO_ROOM(grid->start_x);
+    BITGRID_SET(&queued, r, c);
+    frontier[count++] = PACK(r, c);
+    while (count > 0)
+    {
+        // Take a random room off the frontier:
+        k = PICK(count);
+        r = PACKED_ROW(frontier[k]);
+        c = PACKED_COLUMN(frontier[k]);
+        frontier[k] = frontier[--count];
+
+        // Join it to a random neighbour in the tree, and put its other neighbours on the frontier:
+        joinable = 0;
+        for (int d = 0; d < DIRECTIONS; d++)
+        {
+            next_r = r + room_step_y[d];
+            next_c = c + room_step_x[d];
+            if (!IN_ROOMS(next_r, next_c, rooms_y, rooms_x))
+                continue;
+            if (ROOM_IS_OPEN(grid, next_r, next_c))
+                options[joinable++] = d;
+            else if (!BITGRID_TEST(&queued, next_r, next_c))
+            {
+                BITGRID_SET(&queued, next_r, next_c);
+                frontier[count++] = PACK(next_r, next_c);
+            }
+        }
+        if (joinable > 0)
+        {
+            k = (size_t) options[PICK(joinable)];
+            OPEN_BETWEEN(grid, r, c, r + room_step_y[k], c + room_step_x[k]);
+        }
+        OPEN_ROOM(grid, r, c);
+    }
+
+    bitgrid_free(&queued);
+    free(frontier);
+    return MAZE_OK;
+}
+
+
+/************************************************************************************************************
+ * carve_wilson():    Purpose: Carves a maze with Wilson's algorithm, which picks uniformly among all       *
+ *                             the mazes the rooms allow. The tree starts as the Start; from each room      *
+ *                             not yet in it, a random walk runs until it reaches the tree. Only the        *
+ *                             last step out of each room is remembered, which erases the walk's            *
+ *                             loops, and the path those steps trace joins the tree. Early walks            *
+ *                             wander far before they find the small tree, so its time varies with          *
+ *                             the seed more than the other engines' does.                                  *
+ *                    Parameters: struct generation_context *context --> the seeded context                 *
+ *                                struct bitgrid *grid --> the all-WALL grid to carve                       *
+ *                    Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY (the grid is then left as         *
+ *                                          it was)                                                         *
+ *                    Side effects: - advances the context's random number generator                        *
+ *                                  - modifies the grid, including its Start and End                        *
+ ************************************************************************************************************/
+int carve_wilson(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <stdint.h> for the types "uint8_t" and "uint64_t",
+//  requires "rng.h" for rng_next(),
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires place_ends()
+{
+    // Variable declarations:
+    int rooms_y = (grid->y_dimension - 1) / 2, rooms_x = (grid->x_dimension - 1) / 2;
+    uint8_t *left_by = malloc((size_t) rooms_y * rooms_x); // per room, the GO_ step the walk last left it by
+    uint64_t bits = 0; // random bits not yet used, two per step
+    int bits_left = 0, walk_r, walk_c, step;
+
+    if (left_by == NULL)
+        return MAZE_ERROR_MEMORY;
+    place_ends(context, grid, rooms_y, rooms_x);
+    OPEN_ROOM(grid, CELL_TO_ROOM(grid->start_y), CELL_TO_ROOM(grid->start_x));
+
+    for (int r = 0; r < rooms_y; r++)
+        for (int c = 0; c < rooms_x; c++)
+        {
+            if (ROOM_IS_OPEN(grid, r, c))
+                continue;
+
+            // Walk at random until the tree is reached, redrawing steps that would leave the rooms:
+            walk_r = r;
+            walk_c = c;
+            while (!ROOM_IS_OPEN(grid, walk_r, walk_c))
+            {
+                do
+                {
+                    if (bits_left == 0)
+                    {
+                        bits = rng_next(&context->rng);
+                        bits_left = 32;
+                    }
+                    step = (int) (bits & 0x3);
+                    bits >>= 2;
+                    bits_left--;
+                }
+                while (!IN_ROOMS(walk_r + room_step_y[step], walk_c + room_step_x[step], rooms_y, rooms_x));
+                left_by[(size_t) walk_r * rooms_x + walk_c] = (uint8_t) step;
+                walk_r += room_step_y[step];
+                walk_c += room_step_x[step];
+            }
+
+            // Retrace the walk by the steps remembered, adding its rooms to the tree:
+            walk_r = r;
+            walk_c = c;
+            while (!ROOM_IS_OPEN(grid, walk_r, walk_c))
+            {
+                step = left_by[(size_t) walk_r * rooms_x + walk_c];
+                OPEN_ROOM(grid, walk_r, walk_c);
+                OPEN_BETWEEN(grid, walk_r, walk_c, walk_r + room_step_y[step], walk_c + room_step_x[step]);
+                walk_r += room_step_y[step];
+                walk_c += room_step_x[step];
+            }
+        }
+
+    free(left_by);
+    return MAZE_OK;
+}
+
+
+/***********************************************************************************************************
+ * place_ends():    Purpose: Places the Start in a random room of the first row of rooms, and the End      *
+ *                           in a random room of the last, as Eller's algorithm does.                      *
+ *                  Parameters: struct generation_context *context --> the seeded context                  *
+ *                              struct bitgrid *grid --> the grid to place them in                         *
+ *                              int rooms_y --> rows of rooms                                              *
+ *                              int rooms_x --> columns of rooms                                           *
+ *                  Return value: none                                                                     *
+ *                  Side effects: - advances the context's random number generator                         *
+ *                                - modifies the grid's Start and End                                      *
+ ***********************************************************************************************************/
+void place_ends(struct generation_context *context, struct bitgrid *grid, int rooms_y, int rooms_x)
+// Requires "rng.h" for rng_below(),
+//  & requires "bitgrid.h" for "struct bitgrid"
+{
+    grid->start_y = ROOM_TO_CELL(0);
+    grid->start_x = ROOM_TO_CELL((int) rng_below(&context->rng, rooms_x));
+    grid->end_y = ROOM_TO_CELL(rooms_y - 1);
+    grid->end_x = ROOM_TO_CELL((int) rng_below(&context->rng, rooms_x));
+}
+
+
+/***************************************************************************************************
+ * find_room_set():    Purpose: Finds the set a room belongs to, halving the path on the way.      *
+ *                     Parameters: uint32_t *parent --> the union-find forest over the rooms       *
+ *                                 uint32_t room --> the room to look up                           *
+ *                     Return value: uint32_t --> the set's root room                              *
+ *                     Side effects: modifies the forest                                           *
+ ***************************************************************************************************/
+uint32_t find_room_set(uint32_t *parent, uint32_t room)
+// Requires <stdint.h> for the type "uint32_t"
+{
+    while (parent[room] != room)
+    {
+        parent[room] = parent[parent[room]];
+        room = parent[room];
+    }
+    return room;
+}
@@ -0,0 +1,21 @@
+/****************************************************************************************************
+ * Name: engines.h                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for engines.c                                                               *
+ ****************************************************************************************************/
+
+#ifndef ENGINES_H
+#define ENGINES_H
+
+#include "generation.h" // for "struct generation_context"
+#include "bitgrid.h" // for "struct bitgrid"
+
+/* Function Prototypes */
+// Each carves a maze into an all-WALL grid and returns MAZE_OK, or MAZE_ERROR_MEMORY:
+int carve_backtracker(struct generation_context *context, struct bitgrid *grid);
+int carve_kruskal(struct generation_context *context, struct bitgrid *grid);
+int carve_prim(struct generation_context *context, struct bitgrid *grid);
+int carve_wilson(struct generation_context *context, struct bitgrid *grid);
+
+#endif
@@ -5,12 +5,21 @@
  * Purpose: Implements all the functions necessary to procedurally generate a maze.                 *
  ****************************************************************************************************/
 
+#define _POSIX_C_SOURCE 200809L // for pthreads under -std=c99
 #include <stdio.h> // for the type "FILE *" and fwrite()
-#include <stdint.h> // for the type "uint8_t"
-#include <stdlib.h> // for srand() and rand()
-#include <time.h> // for time()
+#include <stdint.h> // for the types "uint32_t" and "uint64_t"
+#include <stdlib.h> // for malloc(), realloc(), and free()
 #include <stdbool.h> // for the macros "bool", "false", and "true"
-#include "shared.h" // for macros and error_check()
+#include <pthread.h> // for the type "pthread_t" and pthread_create(), pthread_join(), and the mutex functions
+#include "shared.h" // for macros
+#include "rng.h" // for "struct rng", rng_seed(), rng_next(), and rng_below()
+#include "generation.h" // for "struct generation_context" and macros
+#include "maze_file.h" // for write_header(), write_cells(), write_packed_cells(), "struct maze_header", and macros
+#include "eller.h" // for draw_eller()
+#include "engines.h" // for carve_backtracker(), carve_kruskal(), carve_prim(), and carve_wilson()
+#include "bitgrid.h" // for "struct bitgrid" and its functions and macros
+#include "libmaze.h" // for the MAZE_ status codes
+#include "stats.h" // for stats_clear(), stats_merge(), and macros
 
 /* Object-Like Macros */
 #define DIRECTIONS 4
@@ -19,111 +28,709 @@
 #define GO_LEFT 2
 #define GO_RIGHT 3
 #define NO_VALID_STEP -1
-#define NOT_YET_FOUND 4
-#define UP_UP (*(&MAZE_OF_I_OF_J - x_dimension - x_dimension))
-#define UP_LEFT (*(&MAZE_OF_I_OF_J - x_dimension - 1))
-#define UP_RIGHT (*(&MAZE_OF_I_OF_J - x_dimension + 1))
-#define DOWN_DOWN (*(&MAZE_OF_I_OF_J + x_dimension + x_dimension))
-#define DOWN_LEFT (*(&MAZE_OF_I_OF_J + x_dimension - 1))
-#define DOWN_RIGHT (*(&MAZE_OF_I_OF_J + x_dimension + 1))
-#define LEFT_UP (*(&MAZE_OF_I_OF_J - 1 - x_dimension))
-#define LEFT_DOWN (*(&MAZE_OF_I_OF_J - 1 + x_dimension))
-#define LEFT_LEFT (*(&MAZE_OF_I_OF_J - 1 - 1))
-#define RIGHT_UP (*(&MAZE_OF_I_OF_J + 1 - x_dimension))
-#define RIGHT_DOWN (*(&MAZE_OF_I_OF_J + 1 + x_dimension))
-#define RIGHT_RIGHT (*(&MAZE_OF_I_OF_J + 1 + 1))
-#define FLIP_COIN (rand() % 2)
+// The cells (as bitgrid_window() bits) that must all be closed for a step to keep FLOORs one character wide.
+// Each set is the target cell itself plus the three cells beyond and beside it:
+#define UP_BLOCKERS (WINDOW_BIT(1, 2) | WINDOW_BIT(0, 2) | WINDOW_BIT(1, 1) | WINDOW_BIT(1, 3))
+#define DOWN_BLOCKERS (WINDOW_BIT(3, 2) | WINDOW_BIT(4, 2) | WINDOW_BIT(3, 1) | WINDOW_BIT(3, 3))
+#define LEFT_BLOCKERS (WINDOW_BIT(2, 1) | WINDOW_BIT(2, 0) | WINDOW_BIT(1, 1) | WINDOW_BIT(3, 1))
+#define RIGHT_BLOCKERS (WINDOW_BIT(2, 3) | WINDOW_BIT(2, 4) | WINDOW_BIT(1, 3) | WINDOW_BIT(3, 3))
+#define FLIP_COIN (rng_next(&context->rng) >> 63) // the top bit is the strongest one
+#define WORKLIST_MINIMUM 1024 // initial capacity (in cells) of the dead-end worklist
+#define TILE_SIZE 256 // approximate width and height of a tile, in cells
+#define DOOR_THROUGH 1 // door_kind(): FLOOR on both sides of the cell
+#define DOOR_EXTEND_NEAR 2 // door_kind(): FLOOR beyond; the near side must be opened too
+#define DOOR_EXTEND_FAR 4 // door_kind(): FLOOR on the near side; the far side must be opened too
+#define DOOR_EXTENDED (DOOR_EXTEND_NEAR | DOOR_EXTEND_FAR)
+#define TILES_NOT_JOINED -1 // draw_tiles(): two tiles could not be joined, so the grid must be carved afresh
+
+/* Parameterized Macros */
+// A set of valid steps as its size (in the low four bits) and its steps in GO_ order (two bits each from bit 4):
+#define CHOICE(size, first, second, third, fourth) \
+    ((size) | (first) << 4 | (second) << 6 | (third) << 8 | (fourth) << 10)
+#define CHOICE_SIZE(choice) ((choice) & 0xF)
+#define CHOICE_STEP(choice, k) ((int) ((choice) >> (4 + 2 * (k)) & 0x3))
+
+/* Structures */
+// One rectangle of the maze carved independently by draw_tiles():
+struct tile
+{
+    int top, left; // the first interior row and column of the tile
+    int height, width;
+    uint64_t seed; // the tile's own seed, drawn from the maze's generator
+    int start_y, start_x, end_y, end_x; // where carve_maze() put the tile's Start and End
+};
+
+// State shared between draw_tiles() and its workers:
+struct tiling
+{
+    struct bitgrid *grid;
+    struct generation_stats *stats; // the maze's, which every tile's are added to; guarded by lock
+    bool failed; // whether a worker ran out of memory; guarded by lock
+    struct tile *tiles;
+    int count;
+    int next; // the next tile to carve; guarded by lock
+    pthread_mutex_t lock;
+};
+
+// A generation algorithm, by the name it is asked for and how it carves an all-WALL grid:
+struct generator
+{
+    const char *name;
+    // MAZE_OK, MAZE_ERROR_MEMORY, or TILES_NOT_JOINED; NULL for Eller's algorithm, which writes as it goes:
+    int (*carve)(struct generation_context *context, struct bitgrid *grid);
+};
 
 /* Internal Function Prototypes */
-void draw_border(char *maze, int y_dimension, int x_dimension);
-void draw_critical_path(char *maze, int y_dimension, int x_dimension, int start_y, int start_x);
-int find_move(char *maze, int current_y, int current_x, int x_dimension);
-void draw_dead_ends(char *maze, int y_dimension, int x_dimension);
-
-/********************************************************************************************
- * draw_maze():    Purpose: Procedurally generates maze with the help of subfunctions.      *
- *                          Also saves maze to file.                                        *
- *                 Parameters: FILE *maze_file --> pointer to the file to write to.         *
- *                             int y_dimension --> the height of the maze (in characters)   *
- *                             int x_dimension --> the width of the maze (in characters)    *
- *                 Return value: none                                                       *
- *                 Side effects: - seeds rand()                                             *
- *                               - modifies the file pointed to by maze_file                *
- ********************************************************************************************/
-void draw_maze(FILE *maze_file, int y_dimension, int x_dimension)
-// Requires <stdio.h> for the type "FILE *",
-//  requires <stdint.h> for the type "uint8_t",
-//  requires <stdlib.h> for srand() and rand(),
-//  requires <time.h> for time(),
-//  requires "shared.h" for macros and error_check(),
-//  & requires draw_border(), draw_critical_path(), and draw_dead_ends()
+int carve_grid(struct generation_context *context, struct bitgrid *grid, int y_dimension, int x_dimension,
+               struct maze_header *header);
+int carve_classic(struct generation_context *context, struct bitgrid *grid);
+bool carve_maze(struct generation_context *context, struct bitgrid *grid);
+int draw_tiles(struct generation_context *context, struct bitgrid *grid);
+void *carve_tiles(void *argument);
+int find_root(int *roots, int tile);
+bool open_door(struct rng *rng, struct bitgrid *grid, int y, int x, int step_y, int step_x, int length);
+int door_kind(const struct bitgrid *grid, int i, int j, int across_y, int across_x);
+void draw_border(struct bitgrid *grid);
+void draw_critical_path(struct generation_context *context, struct bitgrid *grid, int start_y, int start_x,
+                        int *end_y, int *end_x);
+int find_move(struct generation_context *context, const struct bitgrid *grid, int current_y, int current_x);
+bool draw_dead_ends(struct generation_context *context, struct bitgrid *grid);
+bool push_cell(size_t **worklist, size_t *count, size_t *capacity, size_t cell);
+
+/* Global Variables */
+// Every set of valid steps (indexed by a bit for each GO_ direction) as the list one random draw picks from:
+// (Read-only, so shared by every thread.)
+const uint16_t step_choices[1 << DIRECTIONS] = {
+    CHOICE(0, 0, 0, 0, 0), CHOICE(1, GO_UP, 0, 0, 0),
+    CHOICE(1, GO_DOWN, 0, 0, 0), CHOICE(2, GO_UP, GO_DOWN, 0, 0),
+    CHOICE(1, GO_LEFT, 0, 0, 0), CHOICE(2, GO_UP, GO_LEFT, 0, 0),
+    CHOICE(2, GO_DOWN, GO_LEFT, 0, 0), CHOICE(3, GO_UP, GO_DOWN, GO_LEFT, 0),
+    CHOICE(1, GO_RIGHT, 0, 0, 0), CHOICE(2, GO_UP, GO_RIGHT, 0, 0),
+    CHOICE(2, GO_DOWN, GO_RIGHT, 0, 0), CHOICE(3, GO_UP, GO_DOWN, GO_RIGHT, 0),
+    CHOICE(2, GO_LEFT, GO_RIGHT, 0, 0), CHOICE(3, GO_UP, GO_LEFT, GO_RIGHT, 0),
+    CHOICE(3, GO_DOWN, GO_LEFT, GO_RIGHT, 0), CHOICE(4, GO_UP, GO_DOWN, GO_LEFT, GO_RIGHT)
+};
+
+// Every algorithm, indexed by its ALGORITHM_ macro:
+const struct generator generators[ALGORITHMS] = {
+    {"classic", carve_classic}, {"tiled", draw_tiles}, {"streaming", NULL}, {"backtracker", carve_backtracker},
+    {"kruskal", carve_kruskal}, {"prim", carve_prim}, {"wilson", carve_wilson}
+};
+
+/***********************************************************************************************************
+ * init_generation():    Purpose: Prepares a generation context for a maze built from the given seed.      *
+ *                       Parameters: struct generation_context *context --> the context to prepare         *
+ *                                   uint64_t seed --> the seed to generate from                           *
+ *                       Return value: none                                                                *
+ *                       Side effects: modifies *context                                                   *
+ ***********************************************************************************************************/
+void init_generation(struct generation_context *context, uint64_t seed)
+// Requires <stdint.h> for the type "uint64_t",
+//  requires "rng.h" for rng_seed(),
+//  requires "generation.h" for "struct generation_context" and macros,
+//  requires "maze_file.h" for macros,
+//  & requires "stats.h" for stats_clear()
+{
+    context->seed = seed;
+    context->algorithm = ALGORITHM_CLASSIC;
+    context->threads = 1;
+    context->encoding = ENCODING_CHARS;
+    stats_clear(&context->stats);
+    rng_seed(&context->rng, seed);
+}
+
+
+/************************************************************************************************************
+ * algorithm_name():    Purpose: Names an algorithm, as the game's --algorithm option spells it.            *
+ *                      Parameters: int algorithm --> an ALGORITHM_ macro, or anything else                 *
+ *                      Return value: const char * --> the name, or NULL if there is no such algorithm      *
+ *                      Side effects: none                                                                  *
+ ************************************************************************************************************/
+const char *algorithm_name(int algorithm)
+// Requires "generation.h" for macros,
+//  & requires the generators table
+{
+    return algorithm >= 0 && algorithm < ALGORITHMS ? generators[algorithm].name : NULL;
+}
+
+
+/***********************************************************************************************
+ * draw_maze():    Purpose: Procedurally generates maze with the help of subfunctions.         *
+ *                          Also saves maze to file.                                           *
+ *                 Parameters: FILE *maze_file --> pointer to the file to write to.            *
+ *                             int y_dimension --> the height of the maze (in characters)      *
+ *                             int x_dimension --> the width of the maze (in characters)       *
+ *                             struct generation_context *context --> the seeded context       *
+ *                 Return value: int --> MAZE_OK, or the failure (see libmaze.h)               *
+ *                 Side effects: - advances the context's random number generator              *
+ *                               - modifies the file pointed to by maze_file                   *
+ ***********************************************************************************************/
+int draw_maze(FILE *maze_file, int y_dimension, int x_dimension, struct generation_context *context)
+// Requires <stdio.h> for the type "FILE *" and ftell(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "generation.h" for "struct generation_context" and macros,
+//  requires "maze_file.h" for write_header(), write_cells(), write_packed_cells(), "struct maze_header",
+//   and macros,
+//  requires "bitgrid.h" for "struct bitgrid" and bitgrid_free(),
+//  requires "eller.h" for draw_eller(),
+//  requires "libmaze.h" for the status codes,
+//  requires "stats.h" for macros,
+//  & requires carve_grid()
 {
     // Variable declarations:
-    char maze[y_dimension][x_dimension];
-    int start_y, start_x;
-    uint8_t header[HEADER_SIZE];
+    struct bitgrid grid;
+    struct maze_header header;
+    long position = ftell(maze_file), end;
+    double started = STATS_CLOCK(), writing;
+    int status;
+
+    // Eller's algorithm never holds the whole maze; it writes the file itself as it goes:
+    if (context->algorithm == ALGORITHM_ELLER)
+        status = draw_eller(maze_file, NULL, y_dimension, x_dimension, context, NULL);
+    else if ((status = carve_grid(context, &grid, y_dimension, x_dimension, &header)) == MAZE_OK)
+    {
+        // Write the header, then the maze, expanding it back to one char per cell or packing it:
+        writing = STATS_CLOCK();
+        status = write_header(maze_file, &header);
+        if (status == MAZE_OK && context->encoding == ENCODING_PACKED)
+            status = write_packed_cells(maze_file, &grid);
+        else if (status == MAZE_OK)
+            status = write_cells(maze_file, &grid);
+        STATS_TIME(&context->stats, write_s, writing);
+        bitgrid_free(&grid);
+    }
+
+    // Count the maze, and what it took up in the file (unless the file cannot tell its position):
+    end = ftell(maze_file);
+    STATS_COUNT(&context->stats, bytes_written, position >= 0 && end > position ? (uint64_t) (end - position) : 0);
+    STATS_COUNT(&context->stats, mazes, status == MAZE_OK);
+    STATS_TIME(&context->stats, total_s, started);
+    return status;
+}
 
-    //Initialize maze with purely walls:
-    for (int i = 0; i < y_dimension; i++)
-        for (int j = 0; j < x_dimension; j++)
-            maze[i][j] = WALL;
 
-    // Surround the maze with a special-character border:
-    draw_border(*maze, y_dimension, x_dimension);
+/*********************************************************************************************************
+ * draw_maze_cells():    Purpose: Generates the same maze as draw_maze(), but into a grid in memory      *
+ *                                (one char per cell, row-major) rather than a file.                     *
+ *                       Parameters: char *cells --> the y_dimension * x_dimension chars to fill         *
+ *                                   int y_dimension --> the height of the maze (in characters)          *
+ *                                   int x_dimension --> the width of the maze (in characters)           *
+ *                                   struct generation_context *context --> the seeded context           *
+ *                                   struct maze_header *header --> where to store the header the        *
+ *                                                                  maze would be saved with             *
+ *                       Return value: int --> MAZE_OK, or the failure (see libmaze.h)                   *
+ *                       Side effects: - advances the context's random number generator                  *
+ *                                     - modifies the cells and *header                                  *
+ *********************************************************************************************************/
+int draw_maze_cells(char *cells, int y_dimension, int x_dimension, struct generation_context *context,
+                    struct maze_header *header)
+// Requires <stddef.h> for the type "size_t",
+//  requires "generation.h" for "struct generation_context" and macros,
+//  requires "maze_file.h" for "struct maze_header",
+//  requires "bitgrid.h" for "struct bitgrid", bitgrid_row_to_chars(), and bitgrid_free(),
+//  requires "eller.h" for draw_eller(),
+//  requires "libmaze.h" for the status codes,
+//  requires "stats.h" for macros,
+//  & requires carve_grid()
+{
+    // Variable declarations:
+    struct bitgrid grid;
+    double started = STATS_CLOCK();
+    int status;
 
-    // Seeding rand():
-    srand(time(NULL));
+    if (context->algorithm == ALGORITHM_ELLER)
+        status = draw_eller(NULL, cells, y_dimension, x_dimension, context, header);
+    else if ((status = carve_grid(context, &grid, y_dimension, x_dimension, header)) == MAZE_OK)
+    {
+        for (int i = 0; i < y_dimension; i++)
+            bitgrid_row_to_chars(&grid, i, cells + (size_t) i * x_dimension);
+        bitgrid_free(&grid);
+    }
+
+    STATS_COUNT(&context->stats, mazes, status == MAZE_OK);
+    STATS_TIME(&context->stats, total_s, started);
+    return status;
+}
+
+
+/**************************************************************************************************************
+ * carve_grid():    Purpose: Carves a maze into a new grid with the context's algorithm (any but Eller's),    *
+ *                           and fills in the header it is to be saved with.                                  *
+ *                  Parameters: struct generation_context *context --> the seeded context                     *
+ *                              struct bitgrid *grid --> the grid to create; bitgrid_free() it when done      *
+ *                              int y_dimension --> the height of the maze (in characters)                    *
+ *                              int x_dimension --> the width of the maze (in characters)                     *
+ *                              struct maze_header *header --> where to store the header                      *
+ *                  Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY (nothing is then left to free)        *
+ *                  Side effects: - advances the context's random number generator                            *
+ *                                - falls back to the classic algorithm (in the context too) in the           *
+ *                                  rare case tiles cannot be joined                                          *
+ *                                - modifies *grid and *header, and allocates the grid                        *
+ **************************************************************************************************************/
+int carve_grid(struct generation_context *context, struct bitgrid *grid, int y_dimension, int x_dimension,
+               struct maze_header *header)
+// Requires "rng.h" for rng_seed(),
+//  requires "generation.h" for "struct generation_context" and macros,
+//  requires "maze_file.h" for "struct maze_header",
+//  requires "bitgrid.h" for "struct bitgrid" and its functions,
+//  requires "libmaze.h" for the status codes,
+//  & requires carve_classic() and the generators table
+{
+    // Variable declarations:
+    int status;
+
+    // Initialize maze with purely walls, one bit per cell:
+    if (!bitgrid_create(grid, y_dimension, x_dimension))
+        return MAZE_ERROR_MEMORY;
+
+    // Carve the maze with the context's algorithm (tile by tile on several threads, if tiled):
+    status = generators[context->algorithm].carve(context, grid);
+    if (status == TILES_NOT_JOINED)
+    {
+        // In the rare case the tiles could not be stitched together, start over as a classic maze:
+        bitgrid_free(grid);
+        if (!bitgrid_create(grid, y_dimension, x_dimension))
+            return MAZE_ERROR_MEMORY;
+        rng_seed(&context->rng, context->seed);
+        context->algorithm = ALGORITHM_CLASSIC;
+        status = carve_classic(context, grid);
+    }
+    if (status != MAZE_OK)
+    {
+        bitgrid_free(grid);
+        return status;
+    }
+
+    header->version = HEADER_VERSION;
+    header->encoding = (uint8_t) context->encoding;
+    header->size = HEADER_SIZE;
+    header->x_dimension = x_dimension;
+    header->y_dimension = y_dimension;
+    header->start_x = grid->start_x;
+    header->start_y = grid->start_y;
+    header->end_x = grid->end_x;
+    header->end_y = grid->end_y;
+    header->seed = context->seed;
+    header->algorithm = context->algorithm;
+    return MAZE_OK;
+}
+
+
+/*******************************************************************************************************
+ * carve_classic():    Purpose: Carves a maze with the classic algorithm, as the generators table      *
+ *                              calls every engine.                                                    *
+ *                     Parameters: struct generation_context *context --> the seeded context           *
+ *                                 struct bitgrid *grid --> the all-WALL grid to carve                 *
+ *                     Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY                             *
+ *                     Side effects: - advances the context's random number generator                  *
+ *                                   - modifies the grid, including its Start and End                  *
+ *******************************************************************************************************/
+int carve_classic(struct generation_context *context, struct bitgrid *grid)
+// Requires "generation.h" for "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid",
+//  requires "libmaze.h" for the status codes,
+//  & requires carve_maze()
+{
+    return carve_maze(context, grid) ? MAZE_OK : MAZE_ERROR_MEMORY;
+}
+
+
+/************************************************************************************************************
+ * carve_maze():    Purpose: Carves a maze into an all-WALL grid: border, Start, critical path to the       *
+ *                           End, then dead ends.                                                           *
+ *                  Parameters: struct generation_context *context --> the seeded context                   *
+ *                              struct bitgrid *grid --> the grid to carve (at least 3 x 3)                 *
+ *                  Return value: bool --> false if memory ran out (the maze is then complete, but has      *
+ *                                         fewer dead ends than it should)                                  *
+ *                  Side effects: - advances the context's random number generator                          *
+ *                                - modifies the grid, including its Start and End                          *
+ ************************************************************************************************************/
+bool carve_maze(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdbool.h> for the type "bool",
+//  requires "rng.h" for rng_below(),
+//  requires "generation.h" for "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  requires "stats.h" for macros,
+//  & requires draw_border(), draw_critical_path(), and draw_dead_ends()
+{
+    // Variable declarations:
+    int start_y, start_x, end_y, end_x;
+    double since = STATS_CLOCK();
+    bool complete;
+
+    // Surround the maze with a border that no step may carve into:
+    draw_border(grid);
+    STATS_TIME(&context->stats, border_s, since);
 
     // Pick a random Start location:
-    start_y = rand() % (y_dimension - 1 - 1); // the "- 1 - 1" is to invalidate starting on the top or bottom
-                                              //    since there are borders there.
-    start_x = rand() % (x_dimension - 1 - 1); // ditto for the left and right borders
+    start_y = (int) rng_below(&context->rng, grid->y_dimension - 1 - 1); // the "- 1 - 1" is to invalidate starting on
+                                                                         //    the top or bottom since there are borders there.
+    start_x = (int) rng_below(&context->rng, grid->x_dimension - 1 - 1); // ditto for the left and right borders
     start_y++; // This iterations offset the start by 1 to ensure the start is not on the top border.
     start_x++; // Offset to ensure the start is not on the left border.
-    maze[start_y][start_x] = START;
+    BITGRID_SET(grid, start_y, start_x);
+    grid->start_y = start_y;
+    grid->start_x = start_x;
 
     // Draw a path to a randomized finish, and mark the End location:
-    draw_critical_path(*maze, y_dimension, x_dimension, start_y, start_x);
+    since = STATS_CLOCK();
+    draw_critical_path(context, grid, start_y, start_x, &end_y, &end_x);
+    STATS_TIME(&context->stats, critical_path_s, since);
 
     // Fill the remainder of the maze with dead ends:
-    draw_dead_ends(*maze, y_dimension, x_dimension);
+    since = STATS_CLOCK();
+    complete = draw_dead_ends(context, grid);
+    STATS_TIME(&context->stats, dead_ends_s, since);
+    return complete;
+}
 
-    // Encode the header:
-    header[0] = (uint8_t) x_dimension;
-    header[1] = (uint8_t) y_dimension;
-    header[2] = (uint8_t) start_x;
-    header[3] = (uint8_t) start_y;
 
-    // Write the header to file:
-    error_check("fwrite()", 1, fwrite(header, HEADER_SIZE, 1, maze_file), maze_file);
+/************************************************************************************************************
+ * draw_tiles():    Purpose: Carves a maze as a grid of tiles, each on a worker thread, then joins          *
+ *                           neighbouring tiles through single-cell doors chosen along a random             *
+ *                           spanning tree, so every FLOOR stays reachable and the maze stays a tree.       *
+ *                           Tiles are seeded by index, so the result depends on the context's seed         *
+ *                           but not on how many threads run.                                               *
+ *                  Parameters: struct generation_context *context --> the seeded context                   *
+ *                              struct bitgrid *grid --> the all-WALL grid to carve                         *
+ *                  Return value: int --> MAZE_OK, MAZE_ERROR_MEMORY, or TILES_NOT_JOINED if two tiles      *
+ *                                        could not be joined (the grid is then left partly carved          *
+ *                                        and must be discarded)                                            *
+ *                  Side effects: - advances the context's random number generator                          *
+ *                                - modifies the grid, including its Start and End                          *
+ *                                - starts and joins up to context->threads threads                         *
+ ************************************************************************************************************/
+int draw_tiles(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <pthread.h> for pthread_create(), pthread_join(), and the mutex functions,
+//  requires "libmaze.h" for the status codes,
+//  requires "rng.h" for rng_next() and rng_below(),
+//  requires "generation.h" for "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid",
+//  requires "stats.h" for macros,
+//  & requires carve_tiles(), find_root(), open_door(), draw_border(), and draw_dead_ends()
+{
+    // Variable declarations:
+    struct tiling tiling;
+    struct tile *tile;
+    pthread_t *workers;
+    int *roots, *edges;
+    int tile_rows, tile_columns, tiles, edge_count = 0, threads, started = 0;
+    int usable, a, b, swap;
+    bool joined = true, complete;
+    double since;
+
+    // Split the interior into bands of rows and of columns about TILE_SIZE wide, separated by
+    // single lines of WALL (each tile's own border):
+    tile_rows = (grid->y_dimension - 1) / (TILE_SIZE + 1);
+    tile_columns = (grid->x_dimension - 1) / (TILE_SIZE + 1);
+    tile_rows = tile_rows < 1 ? 1 : tile_rows;
+    tile_columns = tile_columns < 1 ? 1 : tile_columns;
+    tiles = tile_rows * tile_columns;
+
+    tiling.tiles = malloc((size_t) tiles * sizeof(struct tile));
+    roots = malloc((size_t) tiles * sizeof(int));
+    edges = malloc((size_t) tiles * 2 * sizeof(int));
+    threads = context->threads < 1 ? 1 : context->threads > tiles ? tiles : context->threads;
+    workers = malloc((size_t) threads * sizeof(pthread_t));
+    if (tiling.tiles == NULL || roots == NULL || edges == NULL || workers == NULL
+        || pthread_mutex_init(&tiling.lock, NULL) != 0)
+    {
+        free(workers);
+        free(edges);
+        free(roots);
+        free(tiling.tiles);
+        return MAZE_ERROR_MEMORY;
+    }
 
-    // Write the maze to file:
-    for (int i = 0; i < y_dimension; i++)
-        for (int j = 0; j < x_dimension; j++)
-            error_check("fwrite()", 1, fwrite(&maze[i][j], sizeof(char), 1, maze_file), maze_file);
+    // Spread the remainder over the first bands, one cell each:
+    for (int r = 0; r < tile_rows; r++)
+        for (int c = 0; c < tile_columns; c++)
+        {
+            tile = &tiling.tiles[r * tile_columns + c];
+            usable = grid->y_dimension - 2 - (tile_rows - 1);
+            tile->top = 1 + r * (usable / tile_rows + 1) + (r < usable % tile_rows ? r : usable % tile_rows);
+            tile->height = usable / tile_rows + (r < usable % tile_rows);
+            usable = grid->x_dimension - 2 - (tile_columns - 1);
+            tile->left = 1 + c * (usable / tile_columns + 1) + (c < usable % tile_columns ? c : usable % tile_columns);
+            tile->width = usable / tile_columns + (c < usable % tile_columns);
+            tile->seed = rng_next(&context->rng);
+        }
 
-    return;
+    // Carve every tile, handing them out to the workers one at a time:
+    // (Fewer workers than asked for is fine, so long as one starts; it carves whatever the others do not.)
+    tiling.grid = grid;
+    tiling.stats = &context->stats;
+    tiling.failed = false;
+    tiling.count = tiles;
+    tiling.next = 0;
+    while (started < threads && pthread_create(&workers[started], NULL, carve_tiles, &tiling) == 0)
+        started++;
+    for (int k = 0; k < started; k++)
+        (void) pthread_join(workers[k], NULL);
+    (void) pthread_mutex_destroy(&tiling.lock);
+    if (started == 0 || tiling.failed)
+    {
+        free(workers);
+        free(edges);
+        free(roots);
+        free(tiling.tiles);
+        return MAZE_ERROR_MEMORY;
+    }
+
+    // The Start is the first tile's; the End is the last tile's:
+    grid->start_y = tiling.tiles[0].start_y;
+    grid->start_x = tiling.tiles[0].start_x;
+    grid->end_y = tiling.tiles[tiles - 1].end_y;
+    grid->end_x = tiling.tiles[tiles - 1].end_x;
+
+    // List every pair of neighbouring tiles (encoded as tile * 2, + 1 for the one below), and shuffle them:
+    for (int t = 0; t < tiles; t++)
+    {
+        roots[t] = t;
+        if (t % tile_columns < tile_columns - 1)
+            edges[edge_count++] = t * 2;
+        if (t / tile_columns < tile_rows - 1)
+            edges[edge_count++] = t * 2 + 1;
+    }
+    for (int k = edge_count - 1; k > 0; k--)
+    {
+        b = (int) rng_below(&context->rng, k + 1);
+        swap = edges[k], edges[k] = edges[b], edges[b] = swap;
+    }
+
+    // Join tiles through doors in the WALL between them wherever that links two separate groups (Kruskal):
+    for (int k = 0; k < edge_count && joined; k++)
+    {
+        tile = &tiling.tiles[edges[k] / 2];
+        a = find_root(roots, edges[k] / 2);
+        b = find_root(roots, edges[k] / 2 + (edges[k] % 2 ? tile_columns : 1));
+        if (a == b)
+            continue;
+        roots[a] = b;
+        if (edges[k] % 2) // The separating row below the tile
+            joined = open_door(&context->rng, grid, tile->top + tile->height, tile->left, 0, 1, tile->width);
+        else // The separating column to the right of the tile
+            joined = open_door(&context->rng, grid, tile->top, tile->left + tile->width, 1, 0, tile->height);
+    }
+
+    // Grow dead ends into whatever WALL the tile borders left carvable (this never links two FLOORs):
+    complete = true;
+    if (joined)
+    {
+        since = STATS_CLOCK();
+        draw_border(grid);
+        STATS_TIME(&context->stats, border_s, since);
+        since = STATS_CLOCK();
+        complete = draw_dead_ends(context, grid);
+        STATS_TIME(&context->stats, dead_ends_s, since);
+    }
+
+    free(workers);
+    free(edges);
+    free(roots);
+    free(tiling.tiles);
+    return !joined ? TILES_NOT_JOINED : complete ? MAZE_OK : MAZE_ERROR_MEMORY;
+}
+
+
+/******************************************************************************************************************
+ * carve_tiles():    Purpose: Worker thread for draw_tiles(). Takes tiles one at a time, carves each              *
+ *                            into a grid of its own, then copies it into the shared grid.                        *
+ *                   Parameters: void *argument --> pointer to the shared "struct tiling"                         *
+ *                   Return value: void * --> NULL                                                                *
+ *                   Side effects: modifies the shared grid and tiles (the grid under the tiling's lock); if      *
+ *                                 memory runs out, marks the tiling failed under its lock and stops              *
+ ******************************************************************************************************************/
+void *carve_tiles(void *argument)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <pthread.h> for pthread_mutex_lock() and pthread_mutex_unlock(),
+//  requires "generation.h" for init_generation() and "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid" and its functions,
+//  requires "stats.h" for stats_merge(),
+//  & requires carve_maze()
+{
+    // Variable declarations:
+    struct tiling *tiling = argument;
+    struct generation_context tile_context;
+    struct bitgrid tile_grid;
+    struct tile *tile;
+    int t;
+    bool carved;
+
+    while (true)
+    {
+        (void) pthread_mutex_lock(&tiling->lock);
+        t = tiling->failed ? tiling->count : tiling->next++;
+        (void) pthread_mutex_unlock(&tiling->lock);
+        if (t >= tiling->count)
+            break;
+        tile = &tiling->tiles[t];
+
+        // The tile's own border is the WALL separating it from its neighbours:
+        carved = bitgrid_create(&tile_grid, tile->height + 2, tile->width + 2);
+        if (carved)
+        {
+            init_generation(&tile_context, tile->seed);
+            carved = carve_maze(&tile_context, &tile_grid);
+        }
+        if (!carved)
+        {
+            (void) pthread_mutex_lock(&tiling->lock);
+            tiling->failed = true;
+            (void) pthread_mutex_unlock(&tiling->lock);
+            bitgrid_free(&tile_grid);
+            break;
+        }
+        tile->start_y = tile->top - 1 + tile_grid.start_y;
+        tile->start_x = tile->left - 1 + tile_grid.start_x;
+        tile->end_y = tile->top - 1 + tile_grid.end_y;
+        tile->end_x = tile->left - 1 + tile_grid.end_x;
+
+        // Tiles next to each other share words of the shared grid, so copy one at a time:
+        (void) pthread_mutex_lock(&tiling->lock);
+        bitgrid_copy(tiling->grid, tile->top, tile->left, &tile_grid, 1, 1, tile->height, tile->width);
+        stats_merge(tiling->stats, &tile_context.stats);
+        (void) pthread_mutex_unlock(&tiling->lock);
+        bitgrid_free(&tile_grid);
+    }
+
+    return NULL;
 }
 
 
-/******************************************************************************************
- * draw_border():    Purpose: Draws a border around the maze.                             *
- *                   Parameters: char *maze --> pointer to the array containing the maze  *
- *                               int y_dimension --> the height of the maze               *
- *                               int x_dimension --> the width of the maze                *
- *                   Return value: none                                                   *
- *                   Side effects: modifies the maze array                                *
- ******************************************************************************************/
-void draw_border(char *maze, int y_dimension, int x_dimension)
-// Requires "shared.h" for macros
+/*******************************************************************************************************
+ * find_root():    Purpose: Finds the representative of a tile's group, halving paths as it goes.      *
+ *                 Parameters: int *roots --> each tile's parent in its group                          *
+ *                             int tile --> the tile to look up                                        *
+ *                 Return value: int --> the representative tile                                       *
+ *                 Side effects: modifies the roots array                                              *
+ *******************************************************************************************************/
+int find_root(int *roots, int tile)
+{
+    while (roots[tile] != tile)
+        tile = roots[tile] = roots[roots[tile]];
+    return tile;
+}
+
+
+/**********************************************************************************************************
+ * open_door():    Purpose: Opens one cell of the WALL line between two tiles so that a FLOOR on          *
+ *                          one side meets a FLOOR on the other. Prefers a cell with FLOOR on both        *
+ *                          sides; failing that, also opens the closed cell on one side when exactly      *
+ *                          one FLOOR touches it, so no loop or wide FLOOR is made.                       *
+ *                 Parameters: struct rng *rng --> the generator used to pick among candidates            *
+ *                             struct bitgrid *grid --> the grid containing the maze                      *
+ *                             int y --> the y-value of the first cell of the line                        *
+ *                             int x --> the x-value of the first cell of the line                        *
+ *                             int step_y --> 1 if the line runs down, else 0                             *
+ *                             int step_x --> 1 if the line runs right, else 0                            *
+ *                             int length --> the number of cells in the line                             *
+ *                 Return value: bool --> false if no cell of the line can join the two tiles             *
+ *                 Side effects: - advances the random number generator                                   *
+ *                               - modifies the grid                                                      *
+ **********************************************************************************************************/
+bool open_door(struct rng *rng, struct bitgrid *grid, int y, int x, int step_y, int step_x, int length)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires "rng.h" for rng_below(),
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  & requires door_kind()
 {
-    for (int i = 0; i < y_dimension; i++)
-        for (int j = 0; j < x_dimension; j++)
+    // Variable declarations:
+    int across_y = step_x, across_x = step_y; // from the line toward the second tile
+    int candidates, pick, kind, i, j;
+
+    // First pass looks for FLOOR on both sides; the second for the fallback:
+    for (int pass = DOOR_THROUGH; pass != 0; pass = pass == DOOR_THROUGH ? DOOR_EXTENDED : 0)
+    {
+        candidates = 0;
+        for (int k = 0; k < length; k++)
+            if (door_kind(grid, y + k * step_y, x + k * step_x, across_y, across_x) & pass)
+                candidates++;
+        if (candidates == 0)
+            continue;
+
+        pick = (int) rng_below(rng, candidates);
+        for (int k = 0; k < length; k++)
         {
-            if (i == 0 || i == y_dimension - 1)
-                MAZE_OF_I_OF_J = BORDER;
-            else if (j == 0 || j == x_dimension - 1)
-                MAZE_OF_I_OF_J = BORDER;
+            i = y + k * step_y;
+            j = x + k * step_x;
+            kind = door_kind(grid, i, j, across_y, across_x) & pass;
+            if (kind == 0 || pick-- > 0)
+                continue;
+            BITGRID_SET(grid, i, j);
+            if (kind == DOOR_EXTEND_NEAR)
+                BITGRID_SET(grid, i - across_y, j - across_x);
+            else if (kind == DOOR_EXTEND_FAR)
+                BITGRID_SET(grid, i + across_y, j + across_x);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**********************************************************************************************************
+ * door_kind():    Purpose: Classifies a cell of the WALL line between two tiles as a door.               *
+ *                 Parameters: const struct bitgrid *grid --> the grid containing the maze                *
+ *                             int i --> the y-value of the cell                                          *
+ *                             int j --> the x-value of the cell                                          *
+ *                             int across_y, across_x --> the step from the first tile to the second      *
+ *                 Return value: int --> DOOR_THROUGH if both sides are FLOOR; DOOR_EXTEND_NEAR or        *
+ *                                       DOOR_EXTEND_FAR if only one side is, and the closed side         *
+ *                                       touches exactly one FLOOR of its own tile; otherwise 0           *
+ *                 Side effects: none                                                                     *
+ **********************************************************************************************************/
+int door_kind(const struct bitgrid *grid, int i, int j, int across_y, int across_x)
+// Requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    // Variable declarations:
+    int near_y = i - across_y, near_x = j - across_x;
+    int far_y = i + across_y, far_x = j + across_x;
+    int touching;
+
+    if (BITGRID_TEST(grid, near_y, near_x) && BITGRID_TEST(grid, far_y, far_x))
+        return DOOR_THROUGH;
+
+    // The closed side's three other neighbours: one further on, and one to either side along the line:
+    if (BITGRID_TEST(grid, far_y, far_x))
+    {
+        touching = BITGRID_TEST(grid, near_y - across_y, near_x - across_x)
+                   + BITGRID_TEST(grid, near_y + across_x, near_x + across_y)
+                   + BITGRID_TEST(grid, near_y - across_x, near_x - across_y);
+        return touching == 1 ? DOOR_EXTEND_NEAR : 0;
+    }
+    if (BITGRID_TEST(grid, near_y, near_x))
+    {
+        touching = BITGRID_TEST(grid, far_y + across_y, far_x + across_x)
+                   + BITGRID_TEST(grid, far_y + across_x, far_x + across_y)
+                   + BITGRID_TEST(grid, far_y - across_x, far_x - across_y);
+        return touching == 1 ? DOOR_EXTEND_FAR : 0;
+    }
+    return 0;
+}
+
+
+/*********************************************************************************************************
+ * draw_border():    Purpose: Draws a border around the maze. Border cells stay closed; the padding      *
+ *                            ring just outside them is marked open, so that any step into the           *
+ *                            border sees an open cell beyond it and is rejected by find_move().         *
+ *                   Parameters: struct bitgrid *grid --> the grid containing the maze                   *
+ *                   Return value: none                                                                  *
+ *                   Side effects: modifies the grid                                                     *
+ *********************************************************************************************************/
+void draw_border(struct bitgrid *grid)
+// Requires "bitgrid.h" for "struct bitgrid" and its macros
+{
+    for (int i = -1; i <= grid->y_dimension; i++)
+        for (int j = -1; j <= grid->x_dimension; j++)
+        {
+            if (i == -1 || i == grid->y_dimension)
+                BITGRID_SET(grid, i, j);
+            else if (j == -1 || j == grid->x_dimension)
+                BITGRID_SET(grid, i, j);
         }
 }
 
@@ -131,26 +738,30 @@ void draw_border(char *maze, int y_dimension, int x_dimension)
 /****************************************************************************************************
  * draw_critical_path():    Purpose: Pathfinds from Start until it can't move anymore,              *
  *                                   changing WALLs to FLOORs as it goes. Places End at terminus.   *
- *                          Parameters: char *maze --> pointer to the array storing the maze        *
- *                                      int y_dimension --> the height of the maze                  *
- *                                      int x_dimension --> the width of the maze                   *
+ *                          Parameters: struct generation_context *context --> the context to use   *
+ *                                      struct bitgrid *grid --> the grid storing the maze          *
  *                                      int start_y --> the y-value of the Start location           *
  *                                      int start_x --> the x-value of the Start location           *
  *                                      int *end_y --> pointer to the y-value of the End location   *
  *                                      int *end_x --> pointer to the x-value of the End location   *
  *                          Return value: none                                                      *
- *                          Side effects: - modifies the maze array                                 *
+ *                          Side effects: - modifies the grid                                       *
  *                                        - modifies end_y                                          *
  *                                        - modifies end_x                                          *
  ****************************************************************************************************/
-void draw_critical_path(char *maze, int y_dimension, int x_dimension, int start_y, int start_x)
+void draw_critical_path(struct generation_context *context, struct bitgrid *grid, int start_y, int start_x,
+                        int *end_y, int *end_x)
 // Requires <stdbool.h> for the macros "bool", "true", and "false",
-//  requires "shared.h" for macros,
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "generation.h" for "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid" and its macros,
+//  requires "stats.h" for macros,
 //  & requires find_move()
 {
     // Variable declarations:
     bool valid_moves;
     int i, j;
+    uint64_t moves = 0; // one more than the steps taken, counting the last, failed look
 
     valid_moves = true;
     i = start_y;
@@ -159,195 +770,243 @@ void draw_critical_path(char *maze, int y_dimension, int x_dimension, int start_
     // Loop until there are no more valid places to move to:
     do
     {
-        switch (find_move(maze, i, j, x_dimension))
+        moves++;
+        switch (find_move(context, grid, i, j))
         {
             case GO_UP: // Randomly-chosen Movement Direction
-                UP = FLOOR; // Mark path
                 i--; // Move to newly marked path
+                BITGRID_SET(grid, i, j); // Mark path
                 break;
             case GO_DOWN:
-                DOWN = FLOOR;
                 i++;
+                BITGRID_SET(grid, i, j);
                 break;
             case GO_LEFT:
-                LEFT = FLOOR;
                 j--;
+                BITGRID_SET(grid, i, j);
                 break;
             case GO_RIGHT:
-                RIGHT = FLOOR;
                 j++;
+                BITGRID_SET(grid, i, j);
                 break;
             case NO_VALID_STEP: // No more steps are valid.
                 valid_moves = false; // Break loop.
                 break;
         }
     } while (valid_moves);
+    STATS_COUNT(&context->stats, critical_path_length, moves - 1);
+    STATS_COUNT(&context->stats, find_move_calls, moves);
 
     // Place End at path terminus:
-    MAZE_OF_I_OF_J = END;
+    grid->end_y = *end_y = i;
+    grid->end_x = *end_x = j;
 
     return;
 }
 
 
-/********************************************************************************************
- * find_move():    Purpose: Determines what directions are valid for movement,              *
- *                          and picks a random valid direction.                             *
- *                 Parameters: char *maze --> the array containing the maze                 *
- *                             int current_y --> the y-value of the location to move from   *
- *                             int current_x --> the x-value of the location to move from   *
- *                             int x_dimension --> the width of the maze                    *
- *                 Return value: int --> the direction to move in (or an alert that there   *
- *                                  is no valid move)                                       *
- *                 Side effects: none                                                       *
- ********************************************************************************************/
-int find_move(char *maze, int current_y, int current_x, int x_dimension)
-// Requires <stdbool.h> for the macros "bool", "true", and "false",
-//  requires <stdlib.h> for rand(),
-//  & requires "shared.h" for macros
+/************************************************************************************************
+ * find_move():    Purpose: Determines what directions are valid for movement,                  *
+ *                          and picks a random valid direction.                                 *
+ *                 Parameters: struct generation_context *context --> the context to use        *
+ *                             const struct bitgrid *grid --> the grid containing the maze      *
+ *                             int current_y --> the y-value of the location to move from       *
+ *                             int current_x --> the x-value of the location to move from       *
+ *                 Return value: int --> the direction to move in (or an alert that there       *
+ *                                  is no valid move)                                           *
+ *                 Side effects: advances the context's random number generator (only if        *
+ *                               there is a valid move)                                         *
+ ************************************************************************************************/
+int find_move(struct generation_context *context, const struct bitgrid *grid, int current_y, int current_x)
+// Requires <stdint.h> for the types "uint32_t" and "uint64_t",
+//  requires "rng.h" for rng_next(),
+//  requires "generation.h" for "struct generation_context",
+//  & requires "bitgrid.h" for bitgrid_window()
 {
     // Variable declarations:
-    bool valid_up = true, valid_down = true, valid_left = true, valid_right = true;
-    bool valid_move = false;
-    int step = NOT_YET_FOUND;
-    int i, j;
-    int direction;
-
-    // Set location to move from:
-    i = current_y;
-    j = current_x;
-
-    // Test whether UP is a valid move:
-    if (UP != WALL) // This triggers when UP == BORDER, FLOOR, or START.
-        valid_up = false;
-    else if (UP_UP == FLOOR || UP_UP == START || UP_UP == END) // This makes sure FLOORs are only one-character wide.
-        valid_up = false;
-    else if (UP_LEFT == FLOOR || UP_LEFT == START || UP_LEFT == END)
-        valid_up = false;
-    else if (UP_RIGHT == FLOOR || UP_RIGHT == START || UP_RIGHT == END)
-        valid_up = false;
-
-    // Test whether DOWN is a valid move:
-    if (DOWN != WALL)
-        valid_down = false;
-    else if (DOWN_DOWN == FLOOR || DOWN_DOWN == START || DOWN_DOWN == END)
-        valid_down = false;
-    else if (DOWN_LEFT == FLOOR || DOWN_LEFT == START || DOWN_LEFT == END)
-        valid_down = false;
-    else if (DOWN_RIGHT == FLOOR || DOWN_RIGHT == START || DOWN_RIGHT == END)
-        valid_down = false;
-
-    // Test whether LEFT is a valid move:
-    if (LEFT != WALL)
-        valid_left = false;
-    else if (LEFT_UP == FLOOR || LEFT_UP == START || LEFT_UP == END)
-        valid_left = false;
-    else if (LEFT_DOWN == FLOOR || LEFT_DOWN == START || LEFT_DOWN == END)
-        valid_left = false;
-    else if (LEFT_LEFT == FLOOR || LEFT_LEFT == START || LEFT_LEFT == END)
-        valid_left = false;
-
-    // Test whether RIGHT is a valid move:
-    if (RIGHT != WALL)
-        valid_right = false;
-    else if (RIGHT_UP == FLOOR || RIGHT_UP == START || RIGHT_UP == END)
-        valid_right = false;
-    else if (RIGHT_DOWN == FLOOR || RIGHT_DOWN == START || RIGHT_DOWN == END)
-        valid_right = false;
-    else if (RIGHT_RIGHT == FLOOR || RIGHT_RIGHT == START || RIGHT_RIGHT == END)
-        valid_right = false;
+    uint32_t window;
+    unsigned int steps, choice;
+
+    // Fetch the open/closed state of every cell within two steps, five rows at a time:
+    window = bitgrid_window(grid, current_y, current_x);
+
+    // A direction is valid when its target is a WALL and no FLOOR, START, or END touches it
+    // (this makes sure FLOORs are only one-character wide; the open padding rules out the BORDER):
+    steps = ((window & UP_BLOCKERS) == 0) << GO_UP | ((window & DOWN_BLOCKERS) == 0) << GO_DOWN
+            | ((window & LEFT_BLOCKERS) == 0) << GO_LEFT | ((window & RIGHT_BLOCKERS) == 0) << GO_RIGHT;
+    choice = step_choices[steps];
 
     // Test whether all directions are invalid:
-    if (!valid_up && !valid_down && !valid_left && !valid_right)   
-        step = NO_VALID_STEP;
+    if (CHOICE_SIZE(choice) == 0)
+        return NO_VALID_STEP;
+
+    // Pick one of the valid directions with a single draw, scaling its top 32 bits down to their number
+    // (the bias this leaves is below one part in 2^32):
+    return CHOICE_STEP(choice, (rng_next(&context->rng) >> 32) * CHOICE_SIZE(choice) >> 32);
+}
 
-    // Test whether there is a possible step and it's not the End:
-    if (step == NOT_YET_FOUND)
+
+/**********************************************************************************************************
+ * draw_dead_ends():    Purpose: Fills remainder of maze with dead ends. Keeps a worklist of the          *
+ *                               FLOORs that may still grow, so each pass only revisits those             *
+ *                               rather than rescanning the whole maze.                                   *
+ *                      Parameters: struct generation_context *context --> the context to use             *
+ *                                  struct bitgrid *grid --> the grid containing the maze                 *
+ *                      Return value: bool --> false if the worklist could not be allocated or grown      *
+ *                                             (the maze is then complete, but has fewer dead ends)       *
+ *                      Side effects: modifies the grid                                                   *
+ **********************************************************************************************************/
+bool draw_dead_ends(struct generation_context *context, struct bitgrid *grid)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <stdlib.h> for malloc() and free(),
+//  requires "rng.h" for rng_next(),
+//  requires "generation.h" for "struct generation_context",
+//  requires "bitgrid.h" for "struct bitgrid" and its functions and macros,
+//  requires "stats.h" for macros,
+//  & requires find_move() and push_cell()
+{
+    // Variable declarations:
+    size_t *worklist;
+    size_t count = 0, capacity = WORKLIST_MINIMUM, kept, passed;
+    size_t cell, x_dimension = grid->x_dimension;
+    const uint64_t *above_2, *above, *here, *below, *below_2;
+    uint64_t up, down, left, right, growable;
+    int i, j;
+    bool coin, complete = true;
+
+    worklist = malloc(capacity * sizeof(size_t));
+    if (worklist == NULL)
+        return false;
+
+    // Seed the worklist with every FLOOR laid so far (the critical path) that has a valid step.
+    // The same rules as find_move(), applied 64 cells at a time by sliding whole rows against each other:
+    for (i = 1; i < grid->y_dimension - 1; i++)
     {
-        // Loop picks random directions until it picks one that is valid:
-        do
+        above_2 = BITGRID_ROW(grid, i - 2);
+        above = BITGRID_ROW(grid, i - 1);
+        here = BITGRID_ROW(grid, i);
+        below = BITGRID_ROW(grid, i + 1);
+        below_2 = BITGRID_ROW(grid, i + 2);
+        for (size_t w = 0; w + 1 < grid->stride; w++)
         {
-            direction = rand() % DIRECTIONS;
-
-            if (direction == GO_UP && !valid_up)
-                continue;
-            else if (direction == GO_DOWN && !valid_down)
-                continue;
-            else if (direction == GO_LEFT && !valid_left)
+            if (here[w] == 0)
                 continue;
-            else if (direction == GO_RIGHT && !valid_right)
-                continue;
-            else
+            up = ~(above[w] | above_2[w] | bitgrid_shifted(above, w, -1) | bitgrid_shifted(above, w, 1));
+            down = ~(below[w] | below_2[w] | bitgrid_shifted(below, w, -1) | bitgrid_shifted(below, w, 1));
+            left = ~(bitgrid_shifted(here, w, -1) | bitgrid_shifted(here, w, -2)
+                     | bitgrid_shifted(above, w, -1) | bitgrid_shifted(below, w, -1));
+            right = ~(bitgrid_shifted(here, w, 1) | bitgrid_shifted(here, w, 2)
+                      | bitgrid_shifted(above, w, 1) | bitgrid_shifted(below, w, 1));
+            growable = here[w] & (up | down | left | right);
+
+            // Visit each set bit; skip the padding, START, and END:
+            for (; growable != 0; growable &= growable - 1)
+            {
+                j = (int) (w * WORD_BITS) + __builtin_ctzll(growable) - 1;
+                if (j < 1 || j > grid->x_dimension - 2)
+                    continue;
+                if ((i == grid->start_y && j == grid->start_x) || (i == grid->end_y && j == grid->end_x))
+                    continue;
+                complete &= push_cell(&worklist, &count, &capacity, i * x_dimension + j);
+            }
+        }
+    }
+
+    // Each pass gives every candidate one try; FLOORs carved during a pass are appended and tried in the same pass.
+    // A FLOOR with no valid step can never regain one (carving only removes WALLs), so it is dropped for good.
+    // Loop breaks when not a single candidate is left.
+    while (count > 0)
+    {
+        kept = 0;
+        passed = count;
+        for (size_t k = 0; k < count; k++)
+        {
+            cell = worklist[k];
+            i = (int) (cell / x_dimension);
+            j = (int) (cell % x_dimension);
+
+            // Decide whether to turn a nearby WALL into a FLOOR:
+            coin = FLIP_COIN;
+            switch (find_move(context, grid, i, j))
             {
-                step = direction;
-                valid_move = true;
+                case GO_UP:
+                    if (coin)
+                    {
+                        BITGRID_SET(grid, i - 1, j);
+                        complete &= push_cell(&worklist, &count, &capacity, cell - x_dimension);
+                    }
+                    break;
+                case GO_DOWN:
+                    if (coin)
+                    {
+                        BITGRID_SET(grid, i + 1, j);
+                        complete &= push_cell(&worklist, &count, &capacity, cell + x_dimension);
+                    }
+                    break;
+                case GO_LEFT:
+                    if (coin)
+                    {
+                        BITGRID_SET(grid, i, j - 1);
+                        complete &= push_cell(&worklist, &count, &capacity, cell - 1);
+                    }
+                    break;
+                case GO_RIGHT:
+                    if (coin)
+                    {
+                        BITGRID_SET(grid, i, j + 1);
+                        complete &= push_cell(&worklist, &count, &capacity, cell + 1);
+                    }
+                    break;
+                case NO_VALID_STEP: // Dead for good; do not keep.
+                    continue;
             }
-        } while (!valid_move);
+            // Compact survivors toward the front (kept <= k, so nothing unvisited is overwritten):
+            worklist[kept++] = cell;
+        }
+
+        // Every candidate was tried once, and every carve appended its FLOOR, so the worklist grew by
+        //  the carves made this pass:
+        STATS_COUNT(&context->stats, find_move_calls, count);
+        if (context->stats.dead_end_passes < STATS_PASSES)
+            STATS_COUNT(&context->stats, pass_carves[context->stats.dead_end_passes], count - passed);
+        STATS_COUNT(&context->stats, dead_end_carves, count - passed);
+        STATS_COUNT(&context->stats, dead_end_passes, 1);
+        count = kept;
     }
 
-    return step;
+    free(worklist);
+    return complete;
 }
 
 
-/*****************************************************************************************
- * draw_dead_ends():    Purpose: Fills remainder of maze with dead ends.                 *
- *                      Parameters: char *maze --> the array containing the maze         *
- *                                  int y_dimension --> the height of the maze           *
- *                                  int x_dimension --> the width of the maze            *
- *                      Return value: none                                               *
- *                      Side effects: modifies the maze array                            *
- *****************************************************************************************/
-void draw_dead_ends(char *maze, int y_dimension, int x_dimension)
+/***********************************************************************************************************
+ * push_cell():    Purpose: Appends a cell index to a worklist, growing it when full.                      *
+ *                 Parameters: size_t **worklist --> the worklist to append to                             *
+ *                             size_t *count --> pointer to the number of cells in the worklist            *
+ *                             size_t *capacity --> pointer to the number of cells allocated               *
+ *                             size_t cell --> the row-major index of the cell to append                   *
+ *                 Return value: bool --> false if the worklist was full and could not grow (the cell      *
+ *                                        is then left out, and the worklist is as it was)                 *
+ *                 Side effects: - modifies *count and *capacity                                           *
+ *                               - may reallocate the worklist, modifying *worklist                        *
+ ***********************************************************************************************************/
+bool push_cell(size_t **worklist, size_t *count, size_t *capacity, size_t cell)
 // Requires <stdbool.h> for the macros "bool", "false", and "true",
-//  requires "shared.h" for macros,
-//  & requires find_move()
+//  & requires <stdlib.h> for realloc()
 {
     // Variable declarations:
-    bool completed = false;
-    bool moved;
-    bool coin;
+    size_t *grown;
 
-    // Loop breaks when, in the whole array, there is not a single valid place to move.
-    while (!completed)
+    if (*count == *capacity)
     {
-        moved = false;
-        for (int i = 0; i < y_dimension; i++)
-            for (int j = 0; j < x_dimension; j++)
-            {
-                if (MAZE_OF_I_OF_J == FLOOR)
-                {
-                    // Decide whether to turn a nearby WALL into a FLOOR:
-                    coin = FLIP_COIN;
-                    switch (find_move(maze, i, j, x_dimension))
-                    {
-                        case GO_UP:
-                            if (coin)
-                                UP = FLOOR;
-                            moved = true;
-                            break;
-                        case GO_DOWN:
-                            if (coin)
-                                DOWN = FLOOR;
-                            moved = true;
-                            break;
-                        case GO_LEFT:
-                            if (coin)
-                                LEFT = FLOOR;
-                            moved = true;
-                            break;
-                        case GO_RIGHT:
-                            if (coin)
-                                RIGHT = FLOOR;
-                            moved = true;
-                            break;
-                        case NO_VALID_STEP:
-                            break;
-                    }
-                }
-            }
-        // If the whole array was iterated through but not one valid move was found:
-        if (moved == false)
-            completed = true;
+        grown = realloc(*worklist, *capacity * 2 * sizeof(size_t));
+        if (grown == NULL)
+            return false;
+        *worklist = grown;
+        *capacity *= 2;
     }
-    return;
-}
\ No newline at end of file
+    (*worklist)[(*count)++] = cell;
+
+    return true;
+}
@@ -5,5 +5,45 @@
  * Purpose: Header file for generation.c                                                            *
  ****************************************************************************************************/
 
+#ifndef GENERATION_H
+#define GENERATION_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stdint.h> // for the type "uint64_t"
+#include "rng.h" // for "struct rng"
+#include "maze_file.h" // for "struct maze_header"
+#include "stats.h" // for "struct generation_stats"
+
+/* Object-Like Macros */
+// Generation algorithms, as recorded in the file header:
+#define ALGORITHM_CLASSIC 0 // a random walk from Start to End, then dead ends grown off it
+#define ALGORITHM_TILED 1 // the classic algorithm on tiles carved in parallel, joined by doors
+#define ALGORITHM_ELLER 2 // Eller's algorithm, streamed to file a row at a time (see eller.c)
+// The engines that join rooms at odd (i, j), as Eller's algorithm does (see engines.c):
+#define ALGORITHM_BACKTRACKER 3 // a depth-first walk that backs up along an explicit stack
+#define ALGORITHM_KRUSKAL 4 // walls opened in random order, wherever they join two sets of rooms
+#define ALGORITHM_PRIM 5 // a tree grown from the Start by random rooms of its frontier
+#define ALGORITHM_WILSON 6 // loop-erased random walks, choosing uniformly among all possible mazes
+#define ALGORITHMS 7
+
+/* Structures */
+// Everything one generation needs besides the maze itself. Nothing is shared between contexts,
+// so separate contexts may generate on separate threads at once.
+struct generation_context
+{
+    uint64_t seed; // recorded in the file header; the same seed and dimensions always give the same maze
+    struct rng rng;
+    int algorithm; // one of the ALGORITHM_ macros; also recorded in the file header
+    int threads; // worker threads for ALGORITHM_TILED
+    int encoding; // the ENCODING_ macro (see maze_file.h) the maze is written in
+    struct generation_stats stats; // added to by every generation with this context
+};
+
 /* Function Prototypes */
-void draw_maze(FILE *maze_file, int y_dimension, int x_dimension);
\ No newline at end of file
+void init_generation(struct generation_context *context, uint64_t seed);
+const char *algorithm_name(int algorithm);
+int draw_maze(FILE *maze_file, int y_dimension, int x_dimension, struct generation_context *context);
+int draw_maze_cells(char *cells, int y_dimension, int x_dimension, struct generation_context *context,
+                    struct maze_header *header);
+
+#endif
\ No newline at end of file
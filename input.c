@@ -0,0 +1,295 @@
+/****************************************************************************************************
+ * Name: input.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements reading the player's commands, as single keys in raw mode or as typed lines. *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for the termios functions, read(), and strcasecmp() under -std=c99
+#include <stdio.h> // for the type "FILE *" and printf(), fflush(), scanf(), and getchar()
+#include <stdlib.h> // for atexit()
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <stdint.h> // for the type "uint32_t"
+#include <string.h> // for strlen()
+#include <strings.h> // for strcasecmp()
+#include <ctype.h> // for tolower() and isdigit()
+#include <unistd.h> // for read(), isatty(), and "STDIN_FILENO"
+#include <termios.h> // for tcgetattr(), tcsetattr(), and "struct termios"
+#include "shared.h" // for error_check()
+#include "input.h" // for "struct command", "struct command_reader", and macros
+
+/* Object-Like Macros */
+#define LINE_PROMPT "Type command ('help' for help): "
+#define KEY_PROMPT "Press a key ('?' for help): "
+#define SCAN_LINE "%" STRINGIZE2(MAX_KEYS) "s"
+#define ESCAPE '\033' // arrow keys arrive as ESCAPE, '[', and a letter from 'A' to 'D'
+#define CONTROL_C '\003'
+#define CONTROL_D '\004'
+
+/* Parameterized Macros */
+// 2-layer stringization macro, used to allow SCAN_LINE to be dependent on MAX_KEYS:
+#define STRINGIZE2(x) STRINGIZE(x)
+#define STRINGIZE(x) #x
+
+/* Structures */
+struct command_word
+{
+    const char *word;
+    int code;
+};
+
+/* Global Variables */
+// Whole-word commands; anything else typed on a line is taken as a string of keys:
+const struct command_word command_words[] = {
+    {"up", COMMAND_UP}, {"down", COMMAND_DOWN}, {"left", COMMAND_LEFT}, {"right", COMMAND_RIGHT},
+    {"help", COMMAND_HELP}, {"hint", COMMAND_HINT}, {"restart", COMMAND_RESTART}, {"minimap", COMMAND_MINIMAP},
+    {"quit", COMMAND_QUIT}
+};
+// The terminal's settings from before raw mode, which stop_input() puts back, even on the way out through exit():
+struct termios saved_terminal;
+bool terminal_changed = false, exit_hook = false;
+
+/* Internal Function Prototypes */
+size_t add_command(struct command *batch, size_t count, int code, uint32_t repeat);
+int key_command(char key);
+
+/*******************************************************************************************************
+ * init_reader():    Purpose: Readies a reader for a fresh string of keys, with no count pending.      *
+ *                   Parameters: struct command_reader *reader --> the reader                          *
+ *                   Return value: none                                                                *
+ *                   Side effects: modifies *reader                                                    *
+ *******************************************************************************************************/
+void init_reader(struct command_reader *reader)
+// Requires <stdbool.h> for the macro "false"
+{
+    reader->raw = false;
+    reader->last_move = COMMAND_UNKNOWN;
+    reader->typed = 0;
+    reader->issued = 0;
+}
+
+
+/******************************************************************************************************
+ * start_input():    Purpose: Switches a terminal on stdin to raw mode, so that each key acts as      *
+ *                            soon as it is pressed, without echo or Enter; when stdin is not a       *
+ *                            terminal, commands are read a line at a time, as before.                *
+ *                   Parameters: struct command_reader *reader --> the reader to set up               *
+ *                   Return value: none                                                               *
+ *                   Side effects: - modifies *reader                                                 *
+ *                                 - changes the terminal's settings until stop_input()               *
+ ******************************************************************************************************/
+void start_input(struct command_reader *reader)
+// Requires <stdlib.h> for atexit(),
+//  requires <unistd.h> for isatty() and "STDIN_FILENO",
+//  requires <termios.h> for tcgetattr(), tcsetattr(), and "struct termios",
+//  & requires init_reader()
+{
+    // Variable declarations:
+    struct termios raw;
+
+    init_reader(reader);
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_terminal) != 0)
+        return;
+
+    // No line editing, no echo, and Control-C arrives as a key (it quits), with read() waiting for one byte:
+    raw = saved_terminal;
+    raw.c_lflag &= ~(tcflag_t) (ICANON | ECHO | ISIG);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0)
+        return;
+    terminal_changed = true;
+    reader->raw = true;
+    if (!exit_hook)
+        exit_hook = atexit(stop_input) == 0;
+}
+
+
+/*******************************************************************************************************
+ * stop_input():    Purpose: Puts the terminal's settings back as they were before start_input().      *
+ *                  Parameters: none                                                                   *
+ *                  Return value: none                                                                 *
+ *                  Side effects: changes the terminal's settings                                      *
+ *******************************************************************************************************/
+void stop_input(void)
+// Requires <unistd.h> for "STDIN_FILENO",
+//  & requires <termios.h> for tcsetattr()
+{
+    if (!terminal_changed)
+        return;
+    (void) tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_terminal);
+    terminal_changed = false;
+}
+
+
+/***********************************************************************************************************
+ * read_commands():    Purpose: Prompts for and reads the player's next batch of commands: every key       *
+ *                              waiting in raw mode (so that a pasted "wwwddds" is one batch), or one      *
+ *                              typed line, which is either a whole word ("restart") or a string of        *
+ *                              keys ("d12").                                                              *
+ *                     Parameters: struct command_reader *reader --> the reader                            *
+ *                                 struct command *batch --> where to put up to MAX_KEYS commands          *
+ *                                 FILE *maze_file --> the file containing the maze                        *
+ *                     Return value: size_t --> how many commands were put in batch                        *
+ *                     Side effects: - modifies *reader                                                    *
+ *                                   - prints to stdout                                                    *
+ *                                   - fetches from stdin                                                  *
+ *                                   - terminates program if stdin ends in line mode                       *
+ ***********************************************************************************************************/
+size_t read_commands(struct command_reader *reader, struct command *batch, FILE *maze_file)
+// Requires <stdio.h> for the type "FILE *" and printf(), fflush(), scanf(), and getchar(),
+//  requires <string.h> for strlen(),
+//  requires <strings.h> for strcasecmp(),
+//  requires <unistd.h> for read() and "STDIN_FILENO",
+//  requires "shared.h" for error_check(),
+//  & requires parse_keys() and add_command()
+{
+    // Variable declarations:
+    char keys[MAX_KEYS + 1];
+    ssize_t length;
+    size_t count;
+    int character;
+
+    if (reader->raw)
+    {
+        (void) printf(KEY_PROMPT);
+        (void) fflush(stdout);
+        length = read(STDIN_FILENO, keys, MAX_KEYS);
+        // The terminal has gone away:
+        if (length <= 0)
+            return add_command(batch, 0, COMMAND_QUIT, 1);
+        return parse_keys(reader, keys, (size_t) length, batch);
+    }
+
+    (void) printf(LINE_PROMPT);
+    error_check("scanf()", 1, scanf(SCAN_LINE, keys), maze_file);
+    while ((character = getchar()) != '\n' && character != EOF);
+
+    for (size_t k = 0; k < sizeof(command_words) / sizeof(command_words[0]); k++)
+        if (strcasecmp(keys, command_words[k].word) == 0)
+            return add_command(batch, 0, command_words[k].code, 1);
+
+    // Each line is a batch of its own, and is all keys or nothing:
+    reader->last_move = COMMAND_UNKNOWN;
+    count = parse_keys(reader, keys, strlen(keys), batch);
+    for (size_t k = 0; k < count; k++)
+        if (batch[k].code == COMMAND_UNKNOWN)
+            return add_command(batch, 0, COMMAND_UNKNOWN, 1);
+    return count;
+}
+
+
+/*******************************************************************************************************
+ * parse_keys():    Purpose: Turns keys into commands. A count after a movement makes that             *
+ *                           movement so many steps in all, counting those already handed out,         *
+ *                           so "d12" means twelve steps whether it arrives at once or a key at a      *
+ *                           time. Repeats of a movement are merged into one command.                  *
+ *                  Parameters: struct command_reader *reader --> the reader                           *
+ *                              const char *keys --> the keys                                          *
+ *                              size_t length --> how many there are                                   *
+ *                              struct command *batch --> where to put the commands                    *
+ *                  Return value: size_t --> how many commands were put in batch                       *
+ *                  Side effects: modifies *reader                                                     *
+ *******************************************************************************************************/
+size_t parse_keys(struct command_reader *reader, const char *keys, size_t length, struct command *batch)
+// Requires <ctype.h> for isdigit(),
+//  & requires add_command() and key_command()
+{
+    // Variable declarations:
+    size_t count = 0;
+    int code;
+
+    for (size_t k = 0; k < length; k++)
+    {
+        if (isdigit((unsigned char) keys[k]) && reader->last_move != COMMAND_UNKNOWN)
+        {
+            if ((uint64_t) reader->typed * 10 + (uint32_t) (keys[k] - '0') > MAX_REPEAT)
+                continue;
+            reader->typed = reader->typed * 10 + (uint32_t) (keys[k] - '0');
+            if (reader->typed > reader->issued)
+            {
+                count = add_command(batch, count, reader->last_move, reader->typed - reader->issued);
+                reader->issued = reader->typed;
+            }
+            continue;
+        }
+        if (keys[k] == '\n' || keys[k] == '\r' || keys[k] == ' ')
+            continue;
+        if (keys[k] == ESCAPE)
+        {
+            if (k + 2 >= length || keys[k + 1] != '[' || keys[k + 2] < 'A' || keys[k + 2] > 'D')
+                continue;
+            k += 2;
+            code = keys[k] == 'A' ? COMMAND_UP : keys[k] == 'B' ? COMMAND_DOWN : keys[k] == 'C' ? COMMAND_RIGHT : COMMAND_LEFT;
+        }
+        else
+            code = key_command(keys[k]);
+
+        count = add_command(batch, count, code, 1);
+        reader->last_move = IS_MOVEMENT(code) ? code : COMMAND_UNKNOWN;
+        reader->typed = 0;
+        reader->issued = 1;
+    }
+    return count;
+}
+
+
+/*******************************************************************************************************
+ * add_command():    Purpose: Adds a command to a batch, merging it into the last one if both are      *
+ *                            the same movement.                                                       *
+ *                   Parameters: struct command *batch --> the batch                                   *
+ *                               size_t count --> how many commands it holds                           *
+ *                               int code --> the command                                              *
+ *                               uint32_t repeat --> how many times to carry it out                    *
+ *                   Return value: size_t --> how many commands the batch holds now                    *
+ *                   Side effects: modifies the batch                                                  *
+ *******************************************************************************************************/
+size_t add_command(struct command *batch, size_t count, int code, uint32_t repeat)
+// Requires nothing
+{
+    if (count > 0 && batch[count - 1].code == code && IS_MOVEMENT(code))
+    {
+        batch[count - 1].repeat += repeat;
+        return count;
+    }
+    batch[count].code = code;
+    batch[count].repeat = repeat;
+    return count + 1;
+}
+
+
+/***************************************************************************
+ * key_command():    Purpose: Looks up the command for a single key.       *
+ *                   Parameters: char key --> the key                      *
+ *                   Return value: int --> one of the COMMAND_ macros      *
+ *                   Side effects: none                                    *
+ ***************************************************************************/
+int key_command(char key)
+// Requires <ctype.h> for tolower()
+{
+    switch (tolower((unsigned char) key))
+    {
+        case 'w':
+            return COMMAND_UP;
+        case 's':
+            return COMMAND_DOWN;
+        case 'a':
+            return COMMAND_LEFT;
+        case 'd':
+            return COMMAND_RIGHT;
+        case '?':
+            return COMMAND_HELP;
+        case 'h':
+            return COMMAND_HINT;
+        case 'r':
+            return COMMAND_RESTART;
+        case 'm':
+            return COMMAND_MINIMAP;
+        case 'q':
+        case CONTROL_C:
+        case CONTROL_D:
+            return COMMAND_QUIT;
+        default:
+            return COMMAND_UNKNOWN;
+    }
+}
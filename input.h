@@ -0,0 +1,59 @@
+/****************************************************************************************************
+ * Name: input.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for input.c                                                                 *
+ ****************************************************************************************************/
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stddef.h> // for the type "size_t"
+#include <stdbool.h> // for the type "bool"
+#include <stdint.h> // for the type "uint32_t"
+
+/* Object-Like Macros */
+// The player's commands (the movements come first, in the order of obey_player()'s step table):
+#define COMMAND_UP 0
+#define COMMAND_DOWN 1
+#define COMMAND_LEFT 2
+#define COMMAND_RIGHT 3
+#define COMMAND_HELP 4
+#define COMMAND_HINT 5
+#define COMMAND_RESTART 6
+#define COMMAND_MINIMAP 7
+#define COMMAND_QUIT 8
+#define COMMAND_UNKNOWN 9
+#define MAX_KEYS 256 // most keys (or characters of a typed line) read at once; each makes at most one command
+#define MAX_REPEAT 1000000 // largest count that may follow a movement
+
+/* Parameterized Macros */
+#define IS_MOVEMENT(code) ((code) <= COMMAND_RIGHT)
+
+/* Structures */
+// A command from the player, and how many times in a row to carry it out.
+struct command
+{
+    int code; // one of the COMMAND_ macros
+    uint32_t repeat;
+};
+
+// Where commands come from: single keys as they are pressed when stdin is a terminal, or else whole
+//  lines. Either way, a count after a movement ("d12") repeats it, and the count may arrive in pieces.
+struct command_reader
+{
+    bool raw; // whether stdin is a terminal in raw mode
+    int last_move; // the movement a count typed next applies to, or COMMAND_UNKNOWN
+    uint32_t typed; // the count typed for it so far, or 0 if none
+    uint32_t issued; // how many steps of it have been handed out already
+};
+
+/* Function Prototypes */
+void init_reader(struct command_reader *reader);
+void start_input(struct command_reader *reader);
+void stop_input(void);
+size_t read_commands(struct command_reader *reader, struct command *batch, FILE *maze_file);
+size_t parse_keys(struct command_reader *reader, const char *keys, size_t length, struct command *batch);
+
+#endif
@@ -0,0 +1,196 @@
+/****************************************************************************************************
+ * Name: libmaze.c                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements the library interface: a context per caller, generation into the caller's    *
+ *          own buffer, and saving and loading, all reporting failures as status codes. Separate    *
+ *          contexts share nothing, so any number of threads may use the library at once.           *
+ ****************************************************************************************************/
+
+#include <stdio.h> // for the type "FILE *" and fwrite()
+#include <stdlib.h> // for malloc() and free()
+#include <stdint.h> // for the types "uint32_t" and "uint64_t"
+#include "shared.h" // for macros
+#include "generation.h" // for init_generation(), draw_maze_cells(), "struct generation_context", and macros
+#include "maze_file.h" // for write_header(), load_maze(), "struct maze_header", and macros
+#include "packed.h" // for packed_begin(), packed_put_row(), packed_finish(), and "struct packed_writer"
+#include "libmaze.h" // for the status codes
+
+/************************************************************************************************************
+ * maze_create():    Purpose: Allocates a generation context and seeds it. Its algorithm, threads, and      *
+ *                            encoding start as the classic algorithm on one thread, saved as chars,        *
+ *                            and may be changed before generating.                                         *
+ *                   Parameters: struct generation_context **context --> where to store the context;        *
+ *                                                                       maze_free() it when done           *
+ *                               uint64_t seed --> the seed to generate from                                *
+ *                   Return value: int --> MAZE_OK, or MAZE_ERROR_MEMORY                                    *
+ *                   Side effects: - allocates memory                                                       *
+ *                                 - modifies *context                                                      *
+ ************************************************************************************************************/
+int maze_create(struct generation_context **context, uint64_t seed)
+// Requires <stdlib.h> for malloc(),
+//  requires "generation.h" for init_generation() and "struct generation_context",
+//  & requires "libmaze.h" for the status codes
+{
+    *context = malloc(sizeof(struct generation_context));
+    if (*context == NULL)
+        return MAZE_ERROR_MEMORY;
+    init_generation(*context, seed);
+    return MAZE_OK;
+}
+
+
+/********************************************************************************************************
+ * maze_cells_size():    Purpose: Gives the size of the buffer maze_generate() needs for a maze.        *
+ *                       Parameters: int y_dimension --> the height of the maze (in characters)         *
+ *                                   int x_dimension --> the width of the maze (in characters)          *
+ *                       Return value: size_t --> the bytes needed, or 0 if the dimensions are not      *
+ *                                                between MIN_DIMENSION and MAX_DIMENSION               *
+ *                       Side effects: none                                                             *
+ ********************************************************************************************************/
+size_t maze_cells_size(int y_dimension, int x_dimension)
+// Requires <stddef.h> for the type "size_t",
+//  & requires "shared.h" for macros
+{
+    if (y_dimension < MIN_DIMENSION || y_dimension > MAX_DIMENSION || x_dimension < MIN_DIMENSION
+        || x_dimension > MAX_DIMENSION)
+        return 0;
+    return (size_t) y_dimension * x_dimension;
+}
+
+
+/********************************************************************************************************
+ * maze_generate():    Purpose: Generates a maze into the caller's buffer, one char per cell,           *
+ *                              row-major, exactly as the same context would write it to file.          *
+ *                     Parameters: struct generation_context *context --> the seeded context            *
+ *                                 int y_dimension --> the height of the maze (in characters)           *
+ *                                 int x_dimension --> the width of the maze (in characters)            *
+ *                                 char *cells --> the buffer to fill                                   *
+ *                                 size_t capacity --> the size of the buffer, at least                 *
+ *                                                     maze_cells_size(y_dimension, x_dimension)        *
+ *                                 struct maze_header *header --> where to store the maze's header      *
+ *                     Return value: int --> MAZE_OK, MAZE_ERROR_ARGUMENT, or MAZE_ERROR_MEMORY         *
+ *                     Side effects: - advances the context's random number generator                   *
+ *                                   - modifies the cells and *header                                   *
+ ********************************************************************************************************/
+int maze_generate(struct generation_context *context, int y_dimension, int x_dimension, char *cells,
+                  size_t capacity, struct maze_header *header)
+// Requires <stddef.h> for the type "size_t",
+//  requires "generation.h" for draw_maze_cells(), "struct generation_context", and macros,
+//  requires "maze_file.h" for "struct maze_header" and macros,
+//  & requires maze_cells_size()
+{
+    // Variable declarations:
+    size_t size = maze_cells_size(y_dimension, x_dimension);
+
+    if (size == 0 || capacity < size || cells == NULL || header == NULL
+        || context->algorithm < 0 || context->algorithm >= ALGORITHMS
+        || (context->encoding != ENCODING_CHARS && context->encoding != ENCODING_PACKED))
+        return MAZE_ERROR_ARGUMENT;
+    return draw_maze_cells(cells, y_dimension, x_dimension, context, header);
+}
+
+
+/*********************************************************************************************************
+ * maze_serialise():    Purpose: Saves a maze held in memory to file, header first, in the encoding      *
+ *                               its header names. The file can be opened by the game as it is.          *
+ *                      Parameters: FILE *maze_file --> the file to write to (seekable, if packed)       *
+ *                                  const struct maze_header *header --> the maze's header               *
+ *                                  const char *cells --> the maze, one char per cell, row-major         *
+ *                      Return value: int --> MAZE_OK, or the failure                                    *
+ *                      Side effects: modifies the file pointed to by maze_file                          *
+ *********************************************************************************************************/
+int maze_serialise(FILE *maze_file, const struct maze_header *header, const char *cells)
+// Requires <stdio.h> for the type "FILE *" and fwrite(),
+//  requires <stdint.h> for the type "uint32_t",
+//  requires "shared.h" for macros,
+//  requires "maze_file.h" for write_header(), "struct maze_header", and macros,
+//  requires "packed.h" for packed_begin(), packed_put_row(), packed_finish(), and "struct packed_writer",
+//  & requires "libmaze.h" for the status codes
+{
+    // Variable declarations:
+    struct packed_writer writer;
+    size_t x_dimension = header->x_dimension;
+    int status;
+
+    if (header->x_dimension < 3 || header->y_dimension < 3 || header->x_dimension > MAX_DIMENSION
+        || header->y_dimension > MAX_DIMENSION
+        || (header->encoding != ENCODING_CHARS && header->encoding != ENCODING_PACKED))
+        return MAZE_ERROR_ARGUMENT;
+    status = write_header(maze_file, header);
+    if (status != MAZE_OK)
+        return status;
+
+    if (header->encoding == ENCODING_CHARS)
+        return fwrite(cells, x_dimension, header->y_dimension, maze_file) == header->y_dimension ? MAZE_OK
+               : MAZE_ERROR_WRITE;
+    status = packed_begin(&writer, maze_file, (int) header->y_dimension, (int) header->x_dimension);
+    if (status != MAZE_OK)
+        return status;
+    for (uint32_t i = 0; i < header->y_dimension && status == MAZE_OK; i++)
+        status = packed_put_row(&writer, cells + i * x_dimension);
+    return packed_finish(&writer);
+}
+
+
+/**********************************************************************************************************
+ * maze_load():    Purpose: Reads a maze file, in either encoding or the legacy format, into memory.      *
+ *                 Parameters: FILE *maze_file --> the file to read from, positioned at its start         *
+ *                             struct maze_header *header --> where to store the decoded header           *
+ *                             char **cells --> where to store the maze, one char per cell,               *
+ *                                              row-major; free() it when done                            *
+ *                 Return value: int --> MAZE_OK, or the failure (nothing is then left to free)           *
+ *                 Side effects: - moves the file position indicator for maze_file                        *
+ *                               - modifies *header and *cells                                            *
+ *                               - allocates memory                                                       *
+ **********************************************************************************************************/
+int maze_load(FILE *maze_file, struct maze_header *header, char **cells)
+// Requires <stdio.h> for the type "FILE *",
+//  & requires "maze_file.h" for load_maze() and "struct maze_header"
+{
+    return load_maze(maze_file, header, cells);
+}
+
+
+/************************************************************************************************
+ * maze_free():    Purpose: Frees a context made by maze_create().                              *
+ *                 Parameters: struct generation_context *context --> the context, or NULL      *
+ *                 Return value: none                                                           *
+ *                 Side effects: frees memory                                                   *
+ ************************************************************************************************/
+void maze_free(struct generation_context *context)
+// Requires <stdlib.h> for free()
+{
+    free(context);
+}
+
+
+/***************************************************************************************************
+ * maze_error_message():    Purpose: Describes a status code.                                      *
+ *                          Parameters: int status --> the code                                    *
+ *                          Return value: const char * --> a description, without a full stop      *
+ *                          Side effects: none                                                     *
+ ***************************************************************************************************/
+const char *maze_error_message(int status)
+// Requires "libmaze.h" for the status codes
+{
+    switch (status)
+    {
+        case MAZE_OK:
+            return "Success";
+        case MAZE_ERROR_ARGUMENT:
+            return "Invalid argument";
+        case MAZE_ERROR_MEMORY:
+            return "Out of memory";
+        case MAZE_ERROR_WRITE:
+            return "Write-to-file error";
+        case MAZE_ERROR_READ:
+            return "Read-from-file error";
+        case MAZE_ERROR_SEEK:
+            return "File-position error";
+        case MAZE_ERROR_FORMAT:
+            return "Invalid maze file";
+        default:
+            return "Unknown error";
+    }
+}
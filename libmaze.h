@@ -0,0 +1,39 @@
+/****************************************************************************************************
+ * Name: libmaze.h                                                                                  *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for libmaze.c, the library interface for generating, saving, and loading    *
+ *          mazes in-process. Nothing in the library prints or terminates the program: every        *
+ *          fallible function returns one of the status codes below.                                *
+ ****************************************************************************************************/
+
+#ifndef LIBMAZE_H
+#define LIBMAZE_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stddef.h> // for the type "size_t"
+#include <stdint.h> // for the type "uint64_t"
+#include "generation.h" // for "struct generation_context" and macros
+#include "maze_file.h" // for "struct maze_header" and macros
+
+/* Object-Like Macros */
+// Status codes:
+#define MAZE_OK 0
+#define MAZE_ERROR_ARGUMENT 1 // dimensions out of range, an unknown algorithm or encoding, or a buffer too small
+#define MAZE_ERROR_MEMORY 2 // memory (or a worker thread) could not be had
+#define MAZE_ERROR_WRITE 3
+#define MAZE_ERROR_READ 4
+#define MAZE_ERROR_SEEK 5
+#define MAZE_ERROR_FORMAT 6 // not a maze file, or a damaged one
+
+/* Function Prototypes */
+int maze_create(struct generation_context **context, uint64_t seed);
+size_t maze_cells_size(int y_dimension, int x_dimension);
+int maze_generate(struct generation_context *context, int y_dimension, int x_dimension, char *cells,
+                  size_t capacity, struct maze_header *header);
+int maze_serialise(FILE *maze_file, const struct maze_header *header, const char *cells);
+int maze_load(FILE *maze_file, struct maze_header *header, char **cells);
+void maze_free(struct generation_context *context);
+const char *maze_error_message(int status);
+
+#endif
@@ -5,19 +5,34 @@
  * Purpose: CLI video game for exploring a procedurally generated maze.                             *
  ****************************************************************************************************/
 
+#define _POSIX_C_SOURCE 200809L // for sysconf() under -std=c99
 #include <stdbool.h> // for the macros "bool", "false", and "true"
 #include <stdio.h> // for the type "FILE *", the macro "NULL", and printf(), scanf(), getchar(), fopen(), fclose(), fseek(), and fread()
-#include <stdlib.h> // for exit()
-#include <string.h> // for strcat(), strcpy(), and strlen()
-#include <ctype.h> // for tolower()
-#include <stdint.h> // for the type "uint8_t"
-#include "shared.h" // for macros and error_check()
-#include "generation.h" // for draw_maze()
+#include <stdlib.h> // for exit(), malloc(), and free()
+#include <string.h> // for strcat(), strcpy(), strlen(), and memset()
+#include <ctype.h> // for tolower() and isdigit()
+#include <stdint.h> // for the type "uint64_t"
+#include <unistd.h> // for sysconf()
+#include "shared.h" // for macros, error_check(), and status_check()
+#include "generation.h" // for init_generation(), algorithm_name(), and "struct generation_context"
+#include "rng.h" // for random_seed()
+#include "maze_file.h" // for map_maze(), release_maze(), and "struct maze_header"
+#include "batch.h" // for run_batch() and "struct batch_job"
+#include "solver.h" // for solve_maze(), the distance field, and macros
+#include "render.h" // for the incremental renderer, "struct renderer", "struct player_map", and macros
+#include "input.h" // for read_commands(), "struct command", and the COMMAND_ macros
+#include "stats.h" // for stats_clear(), stats_report(), stats_clock(), and macros
+#include "serve.h" // for run_server(), fetch_maze(), fetch_stats(), "struct serve_options", and macros
+#include "cache.h" // for draw_cached_maze(), "struct maze_cache", and macros
 
 /* Object-Like Macros */
 #define MAX_INPUT 10
+#define MAX_THREADS 1024
+#define MAX_MESSAGE 1024 // longest message for the player, which is the help listing
+#define MOVE_TAKEN 0
+#define MOVE_BLOCKED 1 // by a wall
+#define MOVE_WON 2
 #define SCAN_MAX "%" STRINGIZE2(MAX_INPUT) "s"
-#define MAP_OF_I_OF_J *(map + ((i * x_dimension) + j))
 
 /* Parameterized Macros */
 // 2-layer stringization macro, used to allow SCAN_MAX to be dependent on MAX_INPUT:
@@ -30,12 +45,21 @@ while (getchar() != '\n');
 
 /* Function Prototypes */
 bool caseless_cmp(char *str1, char *str2);
-void play(FILE *maze_file);
-void update_map(char *map, char *maze, int player_y, int player_x, int x_dimension);
-void print_map(char *map, int y_dimension, int x_dimension);
-void read_player(char *command, FILE *maze_file);
-void obey_player(char *command, bool *movement, char *maze, int y_dimension, int x_dimension, int *player_y, int *player_x,
-                 bool *won, int start_y, int start_x, char *map, FILE *maze_file);
+bool parse_number(char *text, uint64_t *number);
+bool parse_stats(char *text, int *format);
+bool parse_algorithm(char *text, int *algorithm);
+bool parse_cache_limit(char *text, struct maze_cache *cache);
+bool parse_batch(int argc, char **argv, struct batch_job *job);
+bool parse_serve(int argc, char **argv, struct serve_options *options);
+bool parse_sizes(char *text, struct serve_options *options);
+int verify_mazes(int argc, char **argv);
+int replay_moves(int argc, char **argv);
+void play(FILE *maze_file, const char *maze_filename);
+void update_map(struct player_map *map, int player_y, int player_x);
+int move_player(const char *maze, int x_dimension, int command, int *player_y, int *player_x);
+void obey_player(int command, char *maze, int y_dimension, int x_dimension, int *player_y, int *player_x, bool *won,
+                 int start_y, int start_x, struct player_map *map, FILE *maze_file, const struct distance_field *field, uint64_t *steps_left,
+                 char *message);
 
 /* Definition of main */
 /****************************************************************************************
@@ -51,12 +75,22 @@ void obey_player(char *command, bool *movement, char *maze, int y_dimension, int
 int main(int argc, char **argv)
 // Requires <stdbool.h> for the macros "bool", "false", and "true",
 //  requires <stdio.h> for the type "FILE *", the macro "NULL", and printf(), scanf(), getchar(), fopen(), fclose(), and fseek(),
-//  requires <stdlib.h> for exit(),
+//  requires <stdlib.h> for exit() and strtoull(),
 //  requires <string.h> for strcat() and strcpy(),
-//  requires <ctype.h> for tolower(),
-//  requires "shared.h" for macros and error_check(),
-//  requires "generation.h" for draw_maze(),
-//  & requires caseless_cmp() and play()
+//  requires <ctype.h> for tolower() and isdigit(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <unistd.h> for sysconf(),
+//  requires "shared.h" for macros, error_check(), and status_check(),
+//  requires "generation.h" for init_generation(), "struct generation_context", and macros,
+//  requires "maze_file.h" for macros,
+//  requires "rng.h" for random_seed(),
+//  requires "batch.h" for run_batch() and "struct batch_job",
+//  requires "stats.h" for stats_report() and macros,
+//  requires "serve.h" for run_server(), fetch_maze(), fetch_stats(), and "struct serve_options",
+//  requires "cache.h" for draw_cached_maze(), "struct maze_cache", and macros,
+//  requires "solver.h" for macros,
+//  & requires caseless_cmp(), parse_number(), parse_stats(), parse_algorithm(), parse_cache_limit(), parse_batch(),
+//   parse_serve(), verify_mazes(), replay_moves(), and play()
 {
     // Variable declarations:
     char input[MAX_INPUT + 1] = {0};
@@ -65,17 +99,159 @@ int main(int argc, char **argv)
     int x, y;
     bool valid = false, changed_mind = false;
     int y_n;
+    struct generation_context context;
+    uint64_t seed = 0, number, fetch_width = 0, fetch_height = 0;
+    bool seeded = false, valid_options = true, threaded = false, chosen = false, hint_cache = false;
+    int algorithm = ALGORITHM_CLASSIC, encoding = ENCODING_CHARS, stats_format = STATS_NONE;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    struct batch_job job;
+    struct serve_options serve;
+    struct maze_cache cache = {NULL, (uint64_t) CACHE_DEFAULT_LIMIT << 20};
+    bool cached;
+
+    // "batch" generates many mazes with no prompts, and does not play them:
+    if (argc >= 2 && caseless_cmp(argv[1], "batch") == true)
+    {
+        job.threads = threads < 1 ? 1 : (int) threads;
+        valid_options = parse_batch(argc, argv, &job);
+        if (valid_options)
+        {
+            run_batch(&job);
+            exit(0);
+        }
+    }
+
+    // "serve" keeps mazes ready for other programs, and hands them out over a socket until stopped:
+    if (argc >= 2 && caseless_cmp(argv[1], "serve") == true)
+    {
+        serve.threads = threads < 1 ? 1 : (int) threads;
+        valid_options = parse_serve(argc, argv, &serve);
+        if (valid_options)
+            exit(run_server(&serve));
+    }
+
+    // "fetch" asks a server for a maze, saving it to file, or for the server's statistics:
+    if (argc == 4 && caseless_cmp(argv[1], "fetch") == true && caseless_cmp(argv[3], "stats") == true)
+        exit(fetch_stats(argv[2]));
+    if (argc == 6 && caseless_cmp(argv[1], "fetch") == true)
+    {
+        valid_options = parse_number(argv[3], &fetch_width) && fetch_width <= MAX_DIMENSION
+                        && parse_number(argv[4], &fetch_height) && fetch_height <= MAX_DIMENSION;
+        if (valid_options)
+            exit(fetch_maze(argv[2], (int) fetch_width, (int) fetch_height, argv[5]));
+    }
+
+    // "verify" solves each maze file named, and fails if any cannot be finished:
+    if (argc >= 3 && caseless_cmp(argv[1], "verify") == true)
+        exit(verify_mazes(argc, argv));
+
+    // "replay" plays a script of moves with no screen, and fails if they do not reach the exit:
+    if ((argc == 3 || argc == 4) && caseless_cmp(argv[1], "replay") == true)
+        exit(replay_moves(argc, argv));
+
+    // Options may follow "new": a seed, so that a maze can be re-created exactly from its width, height,
+    //  and seed, and the generation algorithm (with, for tiles, the number of threads):
+    for (int k = 2; k < argc && valid_options; k++)
+    {
+        if (caseless_cmp(argv[k], "--seed") == true && k + 1 < argc)
+            valid_options = seeded = parse_number(argv[++k], &seed);
+        else if (caseless_cmp(argv[k], "--tiled") == true)
+            algorithm = ALGORITHM_TILED, chosen = true;
+        else if (caseless_cmp(argv[k], "--threads") == true && k + 1 < argc)
+        {
+            valid_options = parse_number(argv[++k], &number) && number >= 1 && number <= MAX_THREADS;
+            threads = (long) number;
+            threaded = true;
+        }
+        else if (caseless_cmp(argv[k], "--streaming") == true)
+            algorithm = ALGORITHM_ELLER, chosen = true;
+        else if (caseless_cmp(argv[k], "--algorithm") == true && k + 1 < argc)
+            valid_options = chosen = parse_algorithm(argv[++k], &algorithm);
+        else if (caseless_cmp(argv[k], "--packed") == true)
+            encoding = ENCODING_PACKED;
+        else if (caseless_cmp(argv[k], "--stats") == true && k + 1 < argc)
+            valid_options = parse_stats(argv[++k], &stats_format);
+        else if (caseless_cmp(argv[k], "--cache") == true && k + 1 < argc)
+            cache.directory = argv[++k];
+        else if (caseless_cmp(argv[k], "--cache-limit") == true && k + 1 < argc)
+            valid_options = parse_cache_limit(argv[++k], &cache);
+        else if (caseless_cmp(argv[k], "--hint-cache") == true)
+            hint_cache = true;
+        else
+            valid_options = false;
+    }
+
+    // A maze from a random seed will never be asked for again, so only a seeded one is looked for in the cache or kept:
+    if (!seeded)
+        cache.directory = NULL;
+
+    // Only tiles are carved on threads, so "--threads" picks the tiled algorithm, and cannot go with another:
+    if (threaded && !chosen)
+        algorithm = ALGORITHM_TILED;
+    else if (threaded && algorithm != ALGORITHM_TILED)
+        valid_options = false;
 
     // Loop allows users who entered an invalid command-line filename argument to create a new maze file instead:
     do
     {
-        // If user did not enter exactly two command-line arguments:
-        if (argc != 2)
+        // If user did not enter exactly two command-line arguments (or "new" followed by valid options, or a
+        //  maze filename followed by --hint-cache):
+        if (argc < 2 || !valid_options
+            || (argc > 2 && caseless_cmp(argv[1], "new") == false && !(argc == 3 && hint_cache)))
         {
             // Print usage instructions for user, and terminate program:
             (void) printf("Usage:\n"
-                          "\"<program_filename> new\" for new maze\n"
-                          "\"<program_filename> <maze_filename>\" for old maze\n");
+                          "\"<program_filename> new [options]\" for new maze\n"
+                          "\"<program_filename> <maze_filename> [--hint-cache]\" for old maze\n"
+                          "\"<program_filename> batch --count <number> --min-size <number> --max-size <number>"
+                          " [options]\" for many new mazes, without playing them\n"
+                          "\"<program_filename> verify [--astar | --bidirectional] [--stats <format>]"
+                          " <maze_filename>...\" to check that mazes can be finished\n"
+                          "\"<program_filename> replay <maze_filename> [<moves_filename>]\" to play moves (\"wwwd12\")"
+                          " from a file, or from stdin, with no screen\n"
+                          "\"<program_filename> serve --socket <path> --sizes <width>x<height>[,...] [options]\""
+                          " to keep mazes ready, and hand them out over a socket until stopped\n"
+                          "\"<program_filename> fetch <socket_path> <width> <height> <maze_filename>\" to get a maze"
+                          " from a server\n"
+                          "\"<program_filename> fetch <socket_path> stats\" for a server's latency and refill rate\n"
+                          "Options for new maze:\n"
+                          "\t--seed <number>: generate from this seed (the same seed and size give the same maze)\n"
+                          "\t--tiled: carve the maze in tiles on all processors\n"
+                          "\t--threads <number>: carve the maze in tiles on this many threads (the tiled algorithm\n"
+                          "\t                    only, which it picks when no other is given)\n"
+                          "\t--streaming: write the maze a row at a time (Eller's algorithm), for mazes\n"
+                          "\t             too large to hold in memory\n"
+                          "\t--algorithm <name>: generate with \"classic\" (the default), \"tiled\", \"streaming\",\n"
+                          "\t                    \"backtracker\", \"kruskal\", \"prim\", or \"wilson\"\n"
+                          "\t--packed: write the maze compressed, about a tenth of the size\n"
+                          "\t--stats <format>: before the game starts, report where generation spent its time,\n"
+                          "\t                  as \"text\" or \"json\"\n"
+                          "\t--cache <directory>: copy a large maze from this cache if it was made before, and\n"
+                          "\t                     keep it there if not (with --seed only; without it, the cache\n"
+                          "\t                     is not used)\n"
+                          "\t--cache-limit <number>: megabytes the cache may take up (default: "
+                          STRINGIZE2(CACHE_DEFAULT_LIMIT) ")\n"
+                          "Options for new or old maze:\n"
+                          "\t--hint-cache: keep what hints need for a large maze in \"<maze_filename>"
+                          DISTANCE_CACHE_SUFFIX "\",\n"
+                          "\t              so that the next game on it starts sooner\n"
+                          "Options for verify (besides --stats):\n"
+                          "\t--astar: search best-first toward the End rather than breadth-first\n"
+                          "\t--bidirectional: search from both ends a corridor at a time, first checking the whole\n"
+                          "\t                 maze for loops (one with any is searched breadth-first); slower than\n"
+                          "\t                 breadth-first when the ends are close, as they often are in classic\n"
+                          "\t                 mazes\n"
+                          "Options for batch (besides --seed, --tiled, --streaming, --algorithm, --packed, --stats, and\n"
+                          "the --cache options):\n"
+                          "\t--output <directory>: where to write the mazes (default: the current directory)\n"
+                          "\t--threads <number>: generate this many mazes at once (default: all processors)\n"
+                          "Options for serve (besides --seed, --algorithm, --packed, and the --cache options):\n"
+                          "\t--pool <number>: keep this many mazes of each size ready (default: "
+                          STRINGIZE2(DEFAULT_POOL) ")\n"
+                          "\t--threads <number>: refill the pools on this many threads (default: all processors)\n"
+                          "\t--max-on-demand <number>: most cells in a maze of a size not kept that is generated\n"
+                          "\t                          on request; larger ones are refused (default: "
+                          STRINGIZE2(DEFAULT_ON_DEMAND) ")\n");
             exit(0);
         }
         
@@ -113,22 +289,34 @@ int main(int argc, char **argv)
             // Prompt user for width and height (in characters) of maze:
             do
             {
-                (void) printf("Desired width (10 - 150): ");
+                (void) printf("Desired width (%d - %d): ", MIN_DIMENSION, MAX_DIMENSION);
                 SCAN("%d", &x)
-            } while (x < 10 || x > 150);
+            } while (x < MIN_DIMENSION || x > MAX_DIMENSION);
             do
             {
-                (void) printf("Desired height (10 - 50): ");
+                (void) printf("Desired height (%d - %d): ", MIN_DIMENSION, MAX_DIMENSION);
                 SCAN("%d", &y)
-            } while (y < 10 || y > 50);
+            } while (y < MIN_DIMENSION || y > MAX_DIMENSION);
             // Create (or overwrite) designated file:
             maze_file = fopen(output_filename, "w+");
-            // Create maze and save to file:
-            draw_maze(maze_file, y, x);
+            // Create maze (or copy it from the cache) and save to file; the seed is recorded in the file header:
+            init_generation(&context, seeded ? seed : random_seed());
+            context.algorithm = algorithm;
+            context.encoding = encoding;
+            context.threads = threads < 1 ? 1 : (int) threads;
+            status_check(draw_cached_maze(maze_file, y, x, &context, &cache, &cached), maze_file);
             // Ready file for reading:
             error_check("fseek()", 0, fseek(maze_file, 0, SEEK_SET), maze_file);
+            // Report how generation went, and leave it on screen until the player is ready:
+            if (stats_format != STATS_NONE)
+            {
+                stats_report(stdout, &context.stats, stats_format);
+                (void) printf("Press Enter to start.\n");
+                while ((y_n = getchar()) != '\n' && y_n != EOF)
+                    ;
+            }
             // Run the game, using the new-maze file:
-            play(maze_file);
+            play(maze_file, hint_cache ? output_filename : NULL);
         }
         // If the user wants to play a previously generated maze:
         else
@@ -155,7 +343,7 @@ int main(int argc, char **argv)
             // If file with given name does exist, run the game using that file:
             else
             {
-                play(maze_file);
+                play(maze_file, hint_cache ? argv[1] : NULL);
             }
         }
         // After the game is over, close the maze file:
@@ -188,67 +376,611 @@ bool caseless_cmp(char *str1, char *str2)
 }
 
 
-/********************************************************************************
- * play():    Purpose: Plays the game.                                          *
- *            Parameters: FILE *maze_file --> file to be used for the game      *
- *            Return value: none                                                *
- *            Side effects: - moves the file position indicator for maze_file   *
- *                          - clears the terminal screen                        *
- *                          - clears the terminal scrollback                    *
- *                          - prints to stdout                                  *
- *                          - fetches from stdin                                *
- ********************************************************************************/
-void play(FILE *maze_file)
-// Requires <stdio.h> for the type "FILE *" and for fread(), printf(), and getchar()
-//  requires <stdint.h> for the type "uint8_t",
+/***********************************************************************************************
+ * parse_number():    Purpose: Reads a whole command-line argument as an unsigned number.      *
+ *                    Parameters: char *text --> the argument                                  *
+ *                                uint64_t *number --> where to store the number               *
+ *                    Return value: bool --> true if the whole argument was a number           *
+ *                    Side effects: modifies *number                                           *
+ ***********************************************************************************************/
+bool parse_number(char *text, uint64_t *number)
+// Requires <stdbool.h> for the type "bool",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <stdlib.h> for strtoull(),
+//  & requires <ctype.h> for isdigit()
+{
+    char *end;
+
+    *number = strtoull(text, &end, 0);
+    return isdigit((unsigned char) text[0]) && *end == '\0';
+}
+
+
+/**************************************************************************************
+ * parse_stats():    Purpose: Reads the format named after --stats.                   *
+ *                   Parameters: char *text --> the argument ("text" or "json")       *
+ *                               int *format --> where to store the STATS_ macro      *
+ *                   Return value: bool --> true if the format is known               *
+ *                   Side effects: modifies *format                                   *
+ **************************************************************************************/
+bool parse_stats(char *text, int *format)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires "stats.h" for macros,
+//  & requires caseless_cmp()
+{
+    if (caseless_cmp(text, "text") == true)
+        *format = STATS_TEXT;
+    else if (caseless_cmp(text, "json") == true)
+        *format = STATS_JSON;
+    else
+        return false;
+    return true;
+}
+
+
+/*************************************************************************************************
+ * parse_algorithm():    Purpose: Reads the algorithm named after --algorithm.                   *
+ *                       Parameters: char *text --> the argument (see algorithm_name())          *
+ *                                   int *algorithm --> where to store the ALGORITHM_ macro      *
+ *                       Return value: bool --> true if the algorithm is known                   *
+ *                       Side effects: modifies *algorithm                                       *
+ *************************************************************************************************/
+bool parse_algorithm(char *text, int *algorithm)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires "generation.h" for algorithm_name() and macros,
+//  & requires caseless_cmp()
+{
+    for (int k = 0; k < ALGORITHMS; k++)
+        if (caseless_cmp(text, (char *) algorithm_name(k)) == true)
+        {
+            *algorithm = k;
+            return true;
+        }
+    return false;
+}
+
+
+/*************************************************************************************************************
+ * parse_cache_limit():    Purpose: Reads the limit named after --cache-limit.                               *
+ *                         Parameters: char *text --> the argument (megabytes, at least 1)                   *
+ *                                     struct maze_cache *cache --> where to store the limit (in bytes)      *
+ *                         Return value: bool --> true if the limit is a number, at least 1, that            *
+ *                                                fits in bytes                                              *
+ *                         Side effects: modifies *cache                                                     *
+ *************************************************************************************************************/
+bool parse_cache_limit(char *text, struct maze_cache *cache)
+// Requires <stdbool.h> for the type "bool",
+//  requires <stdint.h> for the type "uint64_t" and the macro "UINT64_MAX",
+//  requires "cache.h" for "struct maze_cache",
+//  & requires parse_number()
+{
+    // Variable declarations:
+    uint64_t megabytes;
+
+    if (!parse_number(text, &megabytes) || megabytes < 1 || megabytes > UINT64_MAX >> 20)
+        return false;
+    cache->limit = megabytes << 20;
+    return true;
+}
+
+
+/*******************************************************************************************************
+ * parse_batch():    Purpose: Reads the options of a "batch" command. --count, --min-size, and         *
+ *                            --max-size are required; the seed defaults to a random one, the          *
+ *                            directory to the current one, the algorithm to the classic one, and      *
+ *                            the encoding to chars. Without a seed, the cache is not used.            *
+ *                   Parameters: int argc, char **argv --> the command line                            *
+ *                               struct batch_job *job --> where to store the job (job->threads        *
+ *                                                         must already hold its default)              *
+ *                   Return value: bool --> true if every option was valid                             *
+ *                   Side effects: modifies *job                                                       *
+ *******************************************************************************************************/
+bool parse_batch(int argc, char **argv, struct batch_job *job)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "shared.h" for macros,
+//  requires "generation.h" for macros,
+//  requires "maze_file.h" for macros,
+//  requires "rng.h" for random_seed(),
+//  requires "batch.h" for "struct batch_job" and macros,
+//  requires "stats.h" for macros,
+//  requires "cache.h" for macros,
+//  & requires caseless_cmp(), parse_number(), parse_stats(), parse_algorithm(), and parse_cache_limit()
+{
+    // Variable declarations:
+    uint64_t number = 0;
+    bool valid = true, seeded = false;
+
+    job->count = job->min_dimension = job->max_dimension = 0;
+    job->directory = ".";
+    job->algorithm = ALGORITHM_CLASSIC;
+    job->encoding = ENCODING_CHARS;
+    job->stats_format = STATS_NONE;
+    job->cache.directory = NULL;
+    job->cache.limit = (uint64_t) CACHE_DEFAULT_LIMIT << 20;
+
+    for (int k = 2; k < argc && valid; k++)
+    {
+        if (caseless_cmp(argv[k], "--tiled") == true)
+            job->algorithm = ALGORITHM_TILED;
+        else if (caseless_cmp(argv[k], "--streaming") == true)
+            job->algorithm = ALGORITHM_ELLER;
+        else if (caseless_cmp(argv[k], "--packed") == true)
+            job->encoding = ENCODING_PACKED;
+        else if (k + 1 == argc)
+            valid = false;
+        else if (caseless_cmp(argv[k], "--output") == true)
+            job->directory = argv[++k];
+        else if (caseless_cmp(argv[k], "--seed") == true)
+            valid = seeded = parse_number(argv[++k], &job->seed);
+        else if (caseless_cmp(argv[k], "--stats") == true)
+            valid = parse_stats(argv[++k], &job->stats_format);
+        else if (caseless_cmp(argv[k], "--algorithm") == true)
+            valid = parse_algorithm(argv[++k], &job->algorithm);
+        else if (caseless_cmp(argv[k], "--cache") == true)
+            job->cache.directory = argv[++k];
+        else if (caseless_cmp(argv[k], "--cache-limit") == true)
+            valid = parse_cache_limit(argv[++k], &job->cache);
+        else if (!parse_number(argv[k + 1], &number) || number > MAX_BATCH)
+            valid = false;
+        else if (caseless_cmp(argv[k], "--count") == true)
+            job->count = (int) number, k++;
+        else if (caseless_cmp(argv[k], "--min-size") == true)
+            job->min_dimension = (int) number, k++;
+        else if (caseless_cmp(argv[k], "--max-size") == true)
+            job->max_dimension = (int) number, k++;
+        else if (caseless_cmp(argv[k], "--threads") == true)
+            job->threads = (int) number, k++;
+        else
+            valid = false;
+    }
+
+    // A maze from a random seed will never be asked for again, so only seeded ones use the cache:
+    if (!seeded)
+    {
+        job->seed = random_seed();
+        job->cache.directory = NULL;
+    }
+    return valid && job->count >= 1 && job->threads >= 1 && job->threads <= MAX_THREADS
+           && job->min_dimension >= MIN_DIMENSION && job->max_dimension <= MAX_DIMENSION
+           && job->min_dimension <= job->max_dimension;
+}
+
+
+/**************************************************************************************************************
+ * parse_serve():    Purpose: Reads the options of a "serve" command. --socket and --sizes are required;      *
+ *                            the pool defaults to DEFAULT_POOL mazes of each size, the largest maze of a     *
+ *                            size not kept to DEFAULT_ON_DEMAND cells, the seed to a random one, the         *
+ *                            algorithm to the classic one, and the encoding to chars. Without a seed,        *
+ *                            the cache is not used.                                                          *
+ *                   Parameters: int argc, char **argv --> the command line                                   *
+ *                               struct serve_options *options --> where to store the options                 *
+ *                                                                 (options->threads must already             *
+ *                                                                 hold its default)                          *
+ *                   Return value: bool --> true if every option was valid                                    *
+ *                   Side effects: modifies *options                                                          *
+ **************************************************************************************************************/
+bool parse_serve(int argc, char **argv, struct serve_options *options)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "generation.h" for macros,
+//  requires "maze_file.h" for macros,
+//  requires "rng.h" for random_seed(),
+//  requires "serve.h" for "struct serve_options" and macros,
+//  requires "cache.h" for macros,
+//  & requires caseless_cmp(), parse_number(), parse_algorithm(), parse_cache_limit(), and parse_sizes()
+{
+    // Variable declarations:
+    uint64_t number = 0;
+    bool valid = true, seeded = false;
+
+    options->socket_path = NULL;
+    options->size_count = 0;
+    options->pool = DEFAULT_POOL;
+    options->max_on_demand = DEFAULT_ON_DEMAND;
+    options->algorithm = ALGORITHM_CLASSIC;
+    options->encoding = ENCODING_CHARS;
+    options->cache.directory = NULL;
+    options->cache.limit = (uint64_t) CACHE_DEFAULT_LIMIT << 20;
+
+    for (int k = 2; k < argc && valid; k++)
+    {
+        if (caseless_cmp(argv[k], "--packed") == true)
+            options->encoding = ENCODING_PACKED;
+        else if (k + 1 == argc)
+            valid = false;
+        else if (caseless_cmp(argv[k], "--socket") == true)
+            options->socket_path = argv[++k];
+        else if (caseless_cmp(argv[k], "--sizes") == true)
+            valid = parse_sizes(argv[++k], options);
+        else if (caseless_cmp(argv[k], "--seed") == true)
+            valid = seeded = parse_number(argv[++k], &options->seed);
+        else if (caseless_cmp(argv[k], "--algorithm") == true)
+            valid = parse_algorithm(argv[++k], &options->algorithm);
+        else if (caseless_cmp(argv[k], "--cache") == true)
+            options->cache.directory = argv[++k];
+        else if (caseless_cmp(argv[k], "--cache-limit") == true)
+            valid = parse_cache_limit(argv[++k], &options->cache);
+        else if (caseless_cmp(argv[k], "--pool") == true)
+        {
+            valid = parse_number(argv[++k], &number) && number >= 1 && number <= MAX_POOL;
+            options->pool = (int) number;
+        }
+        else if (caseless_cmp(argv[k], "--threads") == true)
+        {
+            valid = parse_number(argv[++k], &number) && number >= 1 && number <= MAX_THREADS;
+            options->threads = (int) number;
+        }
+        else if (caseless_cmp(argv[k], "--max-on-demand") == true)
+            valid = parse_number(argv[++k], &options->max_on_demand);
+        else
+            valid = false;
+    }
+
+    // A maze from a random seed will never be asked for again, so only seeded ones use the cache:
+    if (!seeded)
+    {
+        options->seed = random_seed();
+        options->cache.directory = NULL;
+    }
+    return valid && options->socket_path != NULL && options->size_count >= 1;
+}
+
+
+/**********************************************************************************************************
+ * parse_sizes():    Purpose: Reads the size classes named after --sizes: "<width>x<height>", comma-      *
+ *                            separated, each within MIN_DIMENSION to MAX_DIMENSION and named once.       *
+ *                   Parameters: char *text --> the argument (e.g. "100x100,500x200")                     *
+ *                               struct serve_options *options --> where to store the sizes               *
+ *                   Return value: bool --> true if every size was valid, and there were at most          *
+ *                                          MAX_SIZE_CLASSES of them                                      *
+ *                   Side effects: modifies *options                                                      *
+ **********************************************************************************************************/
+bool parse_sizes(char *text, struct serve_options *options)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <stdio.h> for sscanf(),
+//  requires <ctype.h> for isdigit(),
+//  requires "shared.h" for macros,
+//  & requires "serve.h" for "struct serve_options" and macros
+{
+    // Variable declarations:
+    int width, height, used;
+
+    options->size_count = 0;
+    for (;;)
+    {
+        if (options->size_count == MAX_SIZE_CLASSES || !isdigit((unsigned char) *text)
+            || sscanf(text, "%dx%d%n", &width, &height, &used) != 2 || width < MIN_DIMENSION
+            || width > MAX_DIMENSION || height < MIN_DIMENSION || height > MAX_DIMENSION)
+            return false;
+        for (int k = 0; k < options->size_count; k++)
+            if (options->widths[k] == width && options->heights[k] == height)
+                return false;
+        options->widths[options->size_count] = width;
+        options->heights[options->size_count] = height;
+        options->size_count++;
+        text += used;
+        if (*text == '\0')
+            return true;
+        if (*text++ != ',')
+            return false;
+    }
+}
+
+
+/**********************************************************************************************************
+ * verify_mazes():    Purpose: Solves every maze file named on the command line, breadth-first, with      *
+ *                             A* (given --astar), or from both ends at once a corridor at a time         *
+ *                             (given --bidirectional, and breadth-first if the maze has loops), and      *
+ *                             reports whether each can be finished, the length of its shortest           *
+ *                             path, how many cells were expanded, and by which method.                   *
+ *                    Parameters: int argc, char **argv --> the command line                              *
+ *                    Return value: int --> 0 if every maze can be finished, 1 otherwise                  *
+ *                    Side effects: - prints to stdout                                                    *
+ *                                  - terminates program if a file is not a maze file                     *
+ **********************************************************************************************************/
+int verify_mazes(int argc, char **argv)
+// Requires <stdio.h> for the type "FILE *" and printf(), fopen(), ftell(), and fclose(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "shared.h" for seconds_now() and status_check(),
+//  requires "maze_file.h" for map_maze(), release_maze(), and "struct maze_header",
+//  requires "solver.h" for solve_maze(), "struct solution", and macros,
+//  requires "stats.h" for "struct generation_stats", stats_clear(), stats_report(), and macros,
+//  & requires caseless_cmp() and parse_stats()
+{
+    // Variable declarations:
+    const char *method_names[] = {"BFS", "A*", "bidirectional"}; // indexed by SOLVER_ macros
+    int method = SOLVER_BFS, mazes = 0, solved = 0;
+    struct maze_header header;
+    struct solution solution;
+    size_t mapped_length;
+    FILE *maze_file;
+    char *maze;
+    double start, reading;
+    struct generation_stats stats;
+    int stats_format = STATS_NONE;
+
+    for (int k = 2; k < argc; k++)
+        if (caseless_cmp(argv[k], "--astar") == true)
+            method = SOLVER_ASTAR;
+        else if (caseless_cmp(argv[k], "--bfs") == true)
+            method = SOLVER_BFS;
+        else if (caseless_cmp(argv[k], "--bidirectional") == true)
+            method = SOLVER_BIDIRECTIONAL;
+        else if (caseless_cmp(argv[k], "--stats") == true && (k + 1 == argc || !parse_stats(argv[++k], &stats_format)))
+        {
+            (void) printf("--stats: expected \"text\" or \"json\"\n");
+            return 1;
+        }
+    stats_clear(&stats);
+
+    for (int k = 2; k < argc; k++)
+    {
+        if (caseless_cmp(argv[k], "--astar") == true || caseless_cmp(argv[k], "--bfs") == true
+            || caseless_cmp(argv[k], "--bidirectional") == true)
+            continue;
+        if (caseless_cmp(argv[k], "--stats") == true)
+        {
+            k++; // past the format
+            continue;
+        }
+        mazes++;
+        maze_file = fopen(argv[k], "r");
+        if (maze_file == NULL)
+        {
+            (void) printf("%s: could not be opened\n", argv[k]);
+            continue;
+        }
+
+        start = seconds_now();
+        reading = STATS_CLOCK();
+        status_check(map_maze(maze_file, &header, &maze, &mapped_length), maze_file);
+        STATS_TIME(&stats, read_s, reading);
+        STATS_COUNT(&stats, bytes_read, mapped_length > 0 ? mapped_length : (uint64_t) ftell(maze_file));
+        STATS_COUNT(&stats, mazes, 1);
+        solve_maze(maze, &header, method, &solution);
+        if (solution.solved)
+        {
+            solved++;
+            (void) printf("%s: solvable, %llu steps; %llu of %llu open cells expanded (%s, %.3f s)\n", argv[k],
+                          (unsigned long long) solution.path_length, (unsigned long long) solution.expanded,
+                          (unsigned long long) solution.open_cells, method_names[solution.method],
+                          seconds_now() - start);
+        }
+        else if (solution.method == SOLVER_BIDIRECTIONAL)
+            (void) printf("%s: NOT SOLVABLE; %llu of %llu open cells expanded before one end was cut off\n",
+                          argv[k], (unsigned long long) solution.expanded, (unsigned long long) solution.open_cells);
+        else
+            (void) printf("%s: NOT SOLVABLE; %llu of %llu open cells reachable from the Start\n", argv[k],
+                          (unsigned long long) solution.expanded, (unsigned long long) solution.open_cells);
+        release_maze(maze, &header, mapped_length);
+        (void) fclose(maze_file);
+    }
+
+    (void) printf("%d of %d mazes solvable\n", solved, mazes);
+    if (stats_format != STATS_NONE)
+        stats_report(stdout, &stats, stats_format);
+    return solved == mazes ? 0 : 1;
+}
+
+
+
+/**************************************************************************************************************
+ * replay_moves():    Purpose: Plays a script of moves on a maze with no screen, for bots and regression      *
+ *                             runs, then reports the outcome, the steps taken, the moves into walls,         *
+ *                             and the speed. The script uses the keys of the game ("wwwd12"); 'r'            *
+ *                             goes back to the Start, 'q' ends the replay, and the other keys are            *
+ *                             ignored. Moves after the exit is reached are not played.                       *
+ *                    Parameters: int argc, char **argv --> "replay", the maze file, and the script           *
+ *                                                          (stdin if none, or "-")                           *
+ *                    Return value: int --> 0 if the moves reach the exit, else 1                             *
+ *                    Side effects: - prints to stdout                                                        *
+ *                                  - may fetch from stdin                                                    *
+ **************************************************************************************************************/
+int replay_moves(int argc, char **argv)
+// Requires <stdio.h> for the type "FILE *" and printf(), fopen(), fread(), and fclose(),
+//  requires <string.h> for strcmp(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "shared.h" for seconds_now() and status_check(),
+//  requires "maze_file.h" for map_maze(), release_maze(), and "struct maze_header",
+//  requires "input.h" for init_reader(), parse_keys(), "struct command", and macros,
+//  & requires move_player()
+{
+    // Variable declarations:
+    struct maze_header header;
+    struct command_reader reader;
+    struct command batch[MAX_KEYS];
+    char keys[MAX_KEYS];
+    size_t mapped_length, length, count;
+    uint64_t moves = 0, steps = 0, bumps = 0;
+    int player_y, player_x;
+    bool won = false, quit = false;
+    FILE *maze_file, *script;
+    char *maze;
+    double start, elapsed;
+
+    maze_file = fopen(argv[2], "r");
+    if (maze_file == NULL)
+    {
+        (void) printf("%s: could not be opened\n", argv[2]);
+        return 1;
+    }
+    script = argc == 3 || strcmp(argv[3], "-") == 0 ? stdin : fopen(argv[3], "r");
+    if (script == NULL)
+    {
+        (void) printf("%s: could not be opened\n", argv[3]);
+        (void) fclose(maze_file);
+        return 1;
+    }
+    status_check(map_maze(maze_file, &header, &maze, &mapped_length), maze_file);
+    player_y = header.start_y;
+    player_x = header.start_x;
+    init_reader(&reader);
+
+    // The script is read in pieces, with any count split between two pieces carried over by the reader:
+    start = seconds_now();
+    while (!won && !quit && (length = fread(keys, 1, MAX_KEYS, script)) > 0)
+    {
+        count = parse_keys(&reader, keys, length, batch);
+        for (size_t k = 0; k < count && !won && !quit; k++)
+            switch (batch[k].code)
+            {
+                case COMMAND_UP:
+                case COMMAND_DOWN:
+                case COMMAND_LEFT:
+                case COMMAND_RIGHT:
+                    for (uint32_t n = 0; n < batch[k].repeat && !won; n++)
+                    {
+                        moves++;
+                        switch (move_player(maze, header.x_dimension, batch[k].code, &player_y, &player_x))
+                        {
+                            case MOVE_TAKEN:
+                                steps++;
+                                break;
+                            case MOVE_BLOCKED:
+                                bumps++;
+                                break;
+                            case MOVE_WON: // The step onto the exit counts, as in "verify"
+                                steps++;
+                                won = true;
+                                break;
+                        }
+                    }
+                    break;
+                case COMMAND_RESTART:
+                    player_y = header.start_y;
+                    player_x = header.start_x;
+                    break;
+                case COMMAND_QUIT:
+                    quit = true;
+                    break;
+                default: // Help, hints, and the minimap have nothing to show here
+                    break;
+            }
+    }
+    elapsed = seconds_now() - start;
+
+    if (won)
+        (void) printf("%s: reached the exit after %llu steps\n", argv[2], (unsigned long long) steps);
+    else
+        (void) printf("%s: did not reach the exit; %llu steps, ending at row %d, column %d\n", argv[2],
+                      (unsigned long long) steps, player_y, player_x);
+    (void) printf("%llu moves, %llu into walls, in %.3f s (%.2f million moves/s)\n", (unsigned long long) moves,
+                  (unsigned long long) bumps, elapsed, elapsed > 0 ? moves / elapsed / 1e6 : 0.0);
+
+    release_maze(maze, &header, mapped_length);
+    (void) fclose(maze_file);
+    if (script != stdin)
+        (void) fclose(script);
+    return won ? 0 : 1;
+}
+
+/******************************************************************************************
+ * play():    Purpose: Plays the game.                                                    *
+ *            Parameters: FILE *maze_file --> file to be used for the game                *
+ *                        const char *maze_filename --> that file's name, or NULL to      *
+ *                                                      keep no distance cache beside it  *
+ *            Return value: none                                                          *
+ *            Side effects: - moves the file position indicator for maze_file             *
+ *                          - may write a distance cache beside maze_file                 *
+ *                          - clears the terminal screen                                  *
+ *                          - clears the terminal scrollback                              *
+ *                          - switches a terminal on stdin to raw mode while playing      *
+ *                          - prints to stdout                                            *
+ *                          - fetches from stdin                                          *
+ ******************************************************************************************/
+void play(FILE *maze_file, const char *maze_filename)
+// Requires <stdio.h> for the type "FILE *" and for printf() and getchar()
+//  requires <stdlib.h> for calloc() and free(),
 //  requires <stdbool.h> for the macros "bool" and "false",
-//  requires "shared.h" for macros and error_check(),
-//  & requires update_map(), print_map(), read_player(), and obey_player()
+//  requires "shared.h" for macros, error_check(), and status_check(),
+//  requires "maze_file.h" for map_maze(), release_maze(), and "struct maze_header",
+//  requires "solver.h" for open_distance_field(), free_distance_field(), and "struct distance_field",
+//  requires "render.h" for the renderer's functions, "struct renderer", "struct player_map", and macros,
+//  requires "input.h" for start_input(), stop_input(), read_commands(), "struct command", and macros,
+//  & requires update_map() and obey_player()
 {
-    // Early variable declarations:
-    uint8_t header[HEADER_SIZE];
+    // Variable declarations:
+    struct maze_header header;
+    struct distance_field field;
+    struct renderer renderer;
+    struct command_reader reader;
+    struct command batch[MAX_KEYS];
+    size_t count;
+    uint64_t steps_left;
     int x_dimension, y_dimension, start_x, start_y, player_x, player_y;
-    char command[MAX_INPUT + 1] = {0};
-    bool movement, won = false;
+    char message[MAX_MESSAGE] = "";
+    bool redraw, won = false;
+    struct player_map map;
+    char *maze;
+    size_t mapped_length;
 
-    // Decode file header:
-    error_check("fread()", 1, fread(header, HEADER_SIZE, 1, maze_file), maze_file);
-    x_dimension = header[0];
-    y_dimension = header[1];
-    start_x = header[2];
-    start_y = header[3];
+    // Decode file header and map the maze in place (or read it, if the file cannot be mapped):
+    status_check(map_maze(maze_file, &header, &maze, &mapped_length), maze_file);
+    x_dimension = header.x_dimension;
+    y_dimension = header.y_dimension;
+    start_x = header.start_x;
+    start_y = header.start_y;
 
     // Set player start location:
     player_x = start_x;
     player_y = start_y;
 
-    // Late variable declarations (dependent on header being decoded):
-    char maze[y_dimension][x_dimension];
-    char map[y_dimension][x_dimension];
+    // Load (or compute once) every cell's distance to the End, so that hints cost the same on any maze:
+    open_distance_field(maze, &header, maze_file, maze_filename, &field);
+    steps_left = field.start_distance;
 
-    // Read maze from file into variable:
-    error_check("fread()", 1, fread(maze[0], (int) sizeof(char) * y_dimension * x_dimension, 1, maze_file), maze_file);
+    // The player's map is a bit per cell, for whether it has been revealed; all else is read from the maze:
+    map.maze = maze;
+    map.revealed = calloc(CELL_WORDS((size_t) y_dimension * x_dimension), sizeof(uint64_t));
+    error_check("malloc()", 1, map.revealed != NULL, maze_file);
+    map.y_dimension = y_dimension;
+    map.x_dimension = x_dimension;
 
-    // Initialize map to all null characters + border:
-    for (int i = 0; i < y_dimension; i++)
-        for (int j = 0; j < x_dimension; j++)
-            map[i][j] = maze[i][j] == BORDER ? WALL : '\0';
-
-    // Gameplay loop:
+    // Gameplay loop; each batch of commands costs one frame, which draws only the cells that changed:
     (void) printf("\a");
+    start_input(&reader);
+    init_renderer(&renderer, y_dimension, x_dimension);
+    update_map(&map, player_y, player_x);
+    render_reset(&renderer, &map);
+    render_map(&renderer, &map, player_y, player_x);
     while (!won)
     {
-        CLEAR_CONSOLE;
-        update_map(*map, *maze, player_y, player_x, x_dimension);
-        print_map(*map, y_dimension, x_dimension);
+        render_flush(&renderer, message);
+        message[0] = '\0';
+        count = read_commands(&reader, batch, maze_file);
 
-        movement = false;
-        do
-        {
-            read_player(command, maze_file);
-            obey_player(command, &movement, *maze, y_dimension, x_dimension, &player_y, &player_x, &won, start_y, start_x, *map, maze_file);
-        } while (!movement);
+        // A batch stops early at a win, or at the first command with something to say, such as a wall:
+        redraw = false;
+        for (size_t k = 0; k < count && !won && message[0] == '\0'; k++)
+            for (uint32_t n = 0; n < batch[k].repeat && !won && message[0] == '\0'; n++)
+            {
+                // The minimap is the renderer's alone, so it is shown or hidden here:
+                if (batch[k].code == COMMAND_MINIMAP)
+                {
+                    renderer.minimap = !renderer.minimap;
+                    redraw = true;
+                    continue;
+                }
+                render_visit(&renderer, player_y, player_x);
+                obey_player(batch[k].code, maze, y_dimension, x_dimension, &player_y, &player_x, &won, start_y, start_x, &map,
+                            maze_file, &field, &steps_left, message);
+                update_map(&map, player_y, player_x);
+                // A restart wipes the whole map, so it is taken afresh:
+                if (batch[k].code == COMMAND_RESTART)
+                {
+                    render_reset(&renderer, &map);
+                    redraw = true;
+                }
+            }
+
+        if (redraw)
+            render_map(&renderer, &map, player_y, player_x);
+        else
+            render_move(&renderer, &map, player_y, player_x);
     }
+    free_renderer(&renderer);
+    stop_input();
 
     // Winning sequence (from here to end of function):
     CLEAR_CONSOLE;
@@ -270,223 +1002,194 @@ void play(FILE *maze_file)
     for (int i = 0; i < y_dimension; i++)
     {
         for (int j = 0; j < x_dimension; j++)
-            (void) printf("%c", maze[i][j] == '0' ? ' ' : maze[i][j] == BORDER ? WALL : maze[i][j]);
+            (void) printf("%c", MAZE_OF_I_OF_J == '0' ? ' ' : MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J);
         (void) printf("\n");
     }
     (void) printf("\n\n\n\n\n----press ENTER----\n\n");
     while (getchar() != '\n');
 
     CLEAR_CONSOLE;
+    free(map.revealed);
+    free_distance_field(&field);
+    release_maze(maze, &header, mapped_length);
     return;
 }
 
 
-/****************************************************************************************
- * update_map():    Purpose: Removes "fog of war" from map based on player location.    *
- *                  Parameters: char *map --> the array containing the player map       *
- *                              char *maze --> the array containing the maze            *
- *                              int player_y --> the y-value of the player's location   *
- *                              int player_x --> the x-value of the player's location   *
- *                              int x_dimension --> the width of the maze               *
- *                  Return value: none                                                  *
- *                  Side effects: modifies the array containing the player's map        *
- ****************************************************************************************/
-void update_map(char *map, char *maze, int player_y, int player_x, int x_dimension)
-//  Requires "shared.h" for macros
+/*******************************************************************************************
+ * update_map():    Purpose: Removes "fog of war" from map based on player location.       *
+ *                  Parameters: struct player_map *map --> the player's map                *
+ *                              int player_y --> the y-value of the player's location      *
+ *                              int player_x --> the x-value of the player's location      *
+ *                  Return value: none                                                     *
+ *                  Side effects: modifies the player's map                                *
+ *******************************************************************************************/
+void update_map(struct player_map *map, int player_y, int player_x)
+//  Requires "render.h" for "struct player_map" and macros
 {
-    int i, j;
-
-    // Mark current position and surrounding four cardinal positions on player map:
-    i = player_y, j = player_x;
-    MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J;
-    i--;
-    MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J;
-    i++, i++;
-    MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J;
-    i--, j++;
-    MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J;
-    j--, j--;
-    MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : MAZE_OF_I_OF_J;
+    size_t cell = (size_t) player_y * map->x_dimension + player_x;
+
+    // Reveal current position and surrounding four cardinal positions on player map:
+    CELL_ADD(map->revealed, cell);
+    CELL_ADD(map->revealed, cell - map->x_dimension);
+    CELL_ADD(map->revealed, cell + map->x_dimension);
+    CELL_ADD(map->revealed, cell + 1);
+    CELL_ADD(map->revealed, cell - 1);
 
     // Mark player on map:
-    i = player_y, j = player_x;
-    MAP_OF_I_OF_J = '*';
+    map->player_y = player_y;
+    map->player_x = player_x;
 
     return;
 }
 
 
-/************************************************************************************
- * print_map():    Purpose: Prints player's map and its key.                        *
- *                 Parameters: char *map --> the array containing the player's map  *
- *                             int y_dimension --> the height of the maze           *
- *                             int x_dimension --> the width of the maze            *
- *                 Return value: none                                               *
- *                 Side effects: prints to stdout                                   *
- ************************************************************************************/
-void print_map(char *map, int y_dimension, int x_dimension)
-// Requires <stdio.h> for printf(),
-//  & requires "shared.h" for macros
+
+/************************************************************************************************************
+ * move_player():    Purpose: Applies the movement rules, for the game and for replays alike: the           *
+ *                            player may step onto floor or the Start, and wins by stepping onto            *
+ *                            the End; anything else is a wall.                                             *
+ *                   Parameters: const char *maze --> the array containing the maze                         *
+ *                               int x_dimension --> the width of the maze                                  *
+ *                               int command --> the movement, one of COMMAND_UP to COMMAND_RIGHT           *
+ *                               int *player_y --> pointer to the y-value of the player's location          *
+ *                               int *player_x --> pointer to the x-value of the player's location          *
+ *                   Return value: int --> MOVE_TAKEN, MOVE_BLOCKED, or MOVE_WON (the player stays put      *
+ *                                         for the last two)                                                *
+ *                   Side effects: - modifies int *player_y                                                 *
+ *                                 - modifies int *player_x                                                 *
+ ************************************************************************************************************/
+int move_player(const char *maze, int x_dimension, int command, int *player_y, int *player_x)
+// Requires "shared.h" for macros,
+//  & requires "input.h" for the COMMAND_ macros
 {
-    (void) printf("Current map:\n");
-    for (int i = 0; i < y_dimension; i++)
+    // Variable declarations:
+    const int step_y[4] = {-1, 1, 0, 0}, step_x[4] = {0, 0, -1, 1}; // by movement, as numbered in input.h
+    char target = maze[(size_t) (*player_y + step_y[command]) * x_dimension + *player_x + step_x[command]];
+
+    if (target == FLOOR || target == START)
     {
-        for (int j = 0; j < x_dimension; j++)
-            (void) printf("%c", MAP_OF_I_OF_J == '0' ? ' ' : MAP_OF_I_OF_J == '\0' ? ' ' : MAP_OF_I_OF_J);
-        (void) printf("\n");
+        *player_y += step_y[command];
+        *player_x += step_x[command];
+        return MOVE_TAKEN;
     }
-    (void) printf("\nKey:\n'*' = player | '1' = wall | 'S' = starting point | 'E' = exit\n\n");
-}
-
-
-/************************************************************************************
- * read_player():    Purpose: Prompts for and stores player commands.               *
- *                   Parameters: char *command --> the array to store a command     *
- *                               FILE *maze_file --> the file containing the maze   *
- *                   Return value: none                                             *
- *                   Side effects: - prints to stdout                               *
- *                                 - fetches from stdin                             *
- ************************************************************************************/
-void read_player(char *command, FILE *maze_file)
-// Requires <stdio.h> for the type "FILE *" and for printf(), scanf(), and getchar(),
-//  & requires "shared.h" for macros and error_check()
-{
-    (void) printf("Type command ('help' for help): ");
-    SCAN(SCAN_MAX, command)
+    return target == END ? MOVE_WON : MOVE_BLOCKED;
 }
 
-
-/********************************************************************************************************
- * obey_player():    Purpose: Enacts player commands.                                                   *
- *                   Parameters: char *command --> the array containing the current command             *
- *                               bool *movement --> pointer to a bool stating whether player has moved  *
- *                               char *maze --> the array containing the maze                           *
- *                               int y_dimension --> the height of the maze                             *
- *                               int x_dimension --> the width of the maze                              *
- *                               int *player_y --> pointer to the y-value of the player's location      *
- *                               int *player_x --> pointer to the x-value of the player's location      *
- *                               bool *won --> pointer to a bool stating whether the player has won     *
- *                               int start_y --> pointer to the y-value of the Start location           *
- *                               int start_x --> pointer to the x-value of the Start location           *
- *                               char *map --> the array containing the player's map                    *
- *                               FILE *maze_file --> the file containing the maze
- *                   Return value: none                                                                 *
- *                   Side effects: - modifies int *player_y                                             *
- *                                 - modifies bool *movement                                            *
- *                                 - modifies bool *won                                                 *
- *                                 - prints to stdout                                                   *
- *                                 - modifies int *player_x                                             *
- *                                 - modifies the array containing the player's map                     *
- *                                 - terminates the program                                             *
- ********************************************************************************************************/
-void obey_player(char *command, bool *movement, char *maze, int y_dimension, int x_dimension, int *player_y, int *player_x,
-                 bool *won, int start_y, int start_x, char *map, FILE *maze_file)
+/***********************************************************************************************************
+ * obey_player():    Purpose: Enacts player commands.                                                      *
+ *                   Parameters: int command --> the command, one of the COMMAND_ macros                   *
+ *                               char *maze --> the array containing the maze                              *
+ *                               int y_dimension --> the height of the maze                                *
+ *                               int x_dimension --> the width of the maze                                 *
+ *                               int *player_y --> pointer to the y-value of the player's location         *
+ *                               int *player_x --> pointer to the x-value of the player's location         *
+ *                               bool *won --> pointer to a bool stating whether the player has won        *
+ *                               int start_y --> pointer to the y-value of the Start location              *
+ *                               int start_x --> pointer to the x-value of the Start location              *
+ *                               struct player_map *map --> the player's map                               *
+ *                               FILE *maze_file --> the file containing the maze                          *
+ *                               const struct distance_field *field --> the maze's distance field          *
+ *                               uint64_t *steps_left --> pointer to the player's distance to the End      *
+ *                               char *message --> where to put anything to tell the player                *
+ *                   Return value: none                                                                    *
+ *                   Side effects: - modifies int *player_y                                                *
+ *                                 - modifies bool *won                                                    *
+ *                                 - modifies int *player_x                                                *
+ *                                 - modifies the player's map                                             *
+ *                                 - modifies uint64_t *steps_left                                         *
+ *                                 - modifies the message, which holds MAX_MESSAGE characters              *
+ *                                 - terminates the program                                                *
+ ***********************************************************************************************************/
+void obey_player(int command, char *maze, int y_dimension, int x_dimension, int *player_y, int *player_x, bool *won,
+                 int start_y, int start_x, struct player_map *map, FILE *maze_file, const struct distance_field *field, uint64_t *steps_left,
+                 char *message)
 // Requires <stdbool.h> for the macros "bool" and "true",
-//  requires <stdio.h> for the type "FILE *" and printf(),
+//  requires <stdio.h> for the type "FILE *" and printf() and snprintf(),
 //  requires <stdlib.h> for exit(),
+//  requires <stdint.h> for the type "uint64_t",
 //  requires "shared.h" for macros,
-//  & requires caseless_cmp()
+//  requires "solver.h" for next_step(), step_distance(), and "struct distance_field",
+//  requires <string.h> for memset(),
+//  requires "render.h" for "struct player_map" and macros,
+//  requires "input.h" for the COMMAND_ macros,
+//  & requires move_player()
 {
+    // Variable declarations:
     int i = *player_y, j = *player_x;
+    uint64_t cell = (uint64_t) i * x_dimension + j, next;
 
-    // Handle player movement:
-    if (caseless_cmp(command, "up") == true || caseless_cmp(command, "w") == true)
+    switch (command)
     {
-        if (UP == FLOOR || UP == START)
-        {
-            --*player_y;
-            *movement = true;
-        }
-        else if (UP == END)
-        {
-            *won = true;
-            *movement = true;
-        }
-        else
-            (void) printf("Cannot move into wall.\n");
-    }
-    else if (caseless_cmp(command, "down") == true || caseless_cmp(command, "s") == true)
-    {
-        if (DOWN == FLOOR || DOWN == START)
-        {
-            ++*player_y;
-            *movement = true;
-        }
-        else if (DOWN == END)
-        {
-            *won = true;
-            *movement = true;
-        }
-        else
-            (void) printf("Cannot move into wall.\n");
-    }
-    else if (caseless_cmp(command, "left") == true || caseless_cmp(command, "a") == true)
-    {
-        if (LEFT == FLOOR || LEFT == START)
-        {
-            --*player_x;
-            *movement = true;
-        }
-        else if (LEFT == END)
-        {
-            *won = true;
-            *movement = true;
-        }
-        else
-            (void) printf("Cannot move into wall.\n");
-    }
-    else if (caseless_cmp(command, "right") == true || caseless_cmp(command, "d") == true)
-    {
-        if (RIGHT == FLOOR || RIGHT == START)
-        {
-            ++*player_x;
-            *movement = true;
-        }
-        else if (RIGHT == END)
-        {
-            *won = true;
-            *movement = true;
-        }
-        else
-            (void) printf("Cannot move into wall.\n");
-    }
-    // Print help menu:
-    else if (caseless_cmp(command, "help") == true)
-    {
-        (void) printf("----Valid Commands----\n"
-                      "Function commands:\n"
-                      "\tHelp: prints this listing\n"
-                      "\tRestart: erases the map and places player back at start\n"
-                      "\tQuit: terminates the program\n"
-                      "Movement commands:\n"
-                      "\tUp or W: moves the player up one space\n"
-                      "\tDown or S: moves the player down one space\n"
-                      "\tLeft or A: moves the player left one space\n"
-                      "\tRight or D: moves the player right one space\n"
-                      "\nCommands are not case-sensitive.\n");
-    }
-    // Reset current maze:
-    else if (caseless_cmp(command, "restart") == true)
-    {
-        for (int i = 0; i < y_dimension; i++)
-            for (int j = 0; j < x_dimension; j++)
-                MAP_OF_I_OF_J = MAZE_OF_I_OF_J == BORDER ? WALL : '\0';
-        *player_y = start_y;
-        *player_x = start_x;
-        *movement = true;
-    }
-    // Quit game:
-    else if (caseless_cmp(command, "quit") == true)
-    {
-        CLEAR_CONSOLE;
-        (void) fclose(maze_file);
-        exit(0);
-    }
-    //  Default:
-    else
-    {
-        (void) printf("Unrecognized command. Type 'help' for help.\n");
+        // Handle player movement:
+        case COMMAND_UP:
+        case COMMAND_DOWN:
+        case COMMAND_LEFT:
+        case COMMAND_RIGHT:
+            switch (move_player(maze, x_dimension, command, player_y, player_x))
+            {
+                case MOVE_TAKEN:
+                    *steps_left = step_distance(field, *steps_left, (uint64_t) *player_y * x_dimension + *player_x);
+                    break;
+                case MOVE_WON:
+                    *won = true;
+                    break;
+                case MOVE_BLOCKED:
+                    (void) snprintf(message, MAX_MESSAGE, "Cannot move into wall.\n");
+                    break;
+            }
+            break;
+        // Print help menu:
+        case COMMAND_HELP:
+            (void) snprintf(message, MAX_MESSAGE,
+                            "----Valid Commands----\n"
+                            "Function commands:\n"
+                            "\tHelp or ?: prints this listing\n"
+                            "\tHint or H: shows the next step toward the exit, and how many steps are left\n"
+                            "\tRestart or R: erases the map and places player back at start\n"
+                            "\tMinimap or M: shows or hides the overview beside a map too large for the screen\n"
+                            "\tQuit or Q: terminates the program\n"
+                            "Movement commands:\n"
+                            "\tUp or W: moves the player up one space\n"
+                            "\tDown or S: moves the player down one space\n"
+                            "\tLeft or A: moves the player left one space\n"
+                            "\tRight or D: moves the player right one space\n"
+                            "\nAt a terminal, keys (and the arrow keys) act at once; otherwise, type a command and ENTER.\n"
+                            "A number after a movement repeats it (\"d12\"), and movements can be strung together\n"
+                            "(\"wwwddds\"); either way, the map is redrawn once, at the end.\n"
+                            "Commands are not case-sensitive.\n");
+            break;
+        // Show the way, from the distance field:
+        case COMMAND_HINT:
+            if (!field->reachable)
+                (void) snprintf(message, MAX_MESSAGE, "No hint: the exit cannot be reached from here.\n");
+            else
+            {
+                next = next_step(maze, field, cell, *steps_left);
+                (void) snprintf(message, MAX_MESSAGE, "Hint: go %s; %llu step%s to the exit.\n",
+                                next + x_dimension == cell ? "up" : next == cell + x_dimension ? "down"
+                                : next + 1 == cell ? "left" : "right",
+                                (unsigned long long) *steps_left, *steps_left == 1 ? "" : "s");
+            }
+            break;
+        // Reset current maze:
+        case COMMAND_RESTART:
+            // The border is implicit, so the map clears a word of cells at a time, without reading the maze:
+            (void) memset(map->revealed, 0, CELL_WORDS((size_t) y_dimension * x_dimension) * sizeof(uint64_t));
+            *player_y = start_y;
+            *player_x = start_x;
+            *steps_left = field->start_distance;
+            break;
+        // Quit game:
+        case COMMAND_QUIT:
+            CLEAR_CONSOLE;
+            (void) fclose(maze_file);
+            exit(0);
+        //  Default:
+        default:
+            (void) snprintf(message, MAX_MESSAGE, "Unrecognized command. Type 'help' (or press '?') for help.\n");
+            break;
     }
 
     return;
-}
\ No newline at end of file
+}
@@ -0,0 +1,442 @@
+/****************************************************************************************************
+ * Name: maze_file.c                                                                                *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements reading and writing of maze files (header and cell grid).                    *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for fileno() under -std=c99
+#include <stdio.h> // for the type "FILE *" and fread(), fwrite(), ftell(), and fileno()
+#include <stdint.h> // for the types "uint8_t", "uint16_t", "uint32_t", and "uint64_t"
+#include <stdlib.h> // for malloc() and free()
+#include <string.h> // for memcmp() and memcpy()
+#include <sys/mman.h> // for mmap() and munmap()
+#include <sys/stat.h> // for fstat() and "struct stat"
+#include "shared.h" // for macros
+#include "libmaze.h" // for the MAZE_ status codes
+#include "maze_file.h" // for header macros and "struct maze_header"
+#include "bitgrid.h" // for "struct bitgrid" and bitgrid_row_to_chars()
+#include "packed.h" // for the packed encoding's reader and writer
+
+/* Internal Function Prototypes */
+int read_cells(FILE *maze_file, struct maze_header *header, char **maze);
+void find_legacy_end(const char *maze, struct maze_header *header);
+
+/*************************************************************************************************
+ * write_header():    Purpose: Encodes a header in the current (versioned) format                *
+ *                             and writes it to file.                                            *
+ *                    Parameters: FILE *maze_file --> the file to write to                       *
+ *                                const struct maze_header *header --> the header to encode      *
+ *                    Return value: int --> MAZE_OK, or MAZE_ERROR_WRITE                         *
+ *                    Side effects: modifies the file pointed to by maze_file                    *
+ *************************************************************************************************/
+int write_header(FILE *maze_file, const struct maze_header *header)
+// Requires <stdio.h> for the type "FILE *" and fwrite(),
+//  requires <string.h> for memcpy(),
+//  requires "libmaze.h" for the status codes,
+//  requires "maze_file.h" for header macros,
+//  & requires put_u16(), put_u32(), and put_u64()
+{
+    uint8_t bytes[HEADER_SIZE] = {0};
+
+    // Layout: magic, version, encoding, header size, six little-endian 32-bit fields, the 64-bit seed,
+    //  then the algorithm:
+    (void) memcpy(bytes, HEADER_MAGIC, HEADER_MAGIC_SIZE);
+    bytes[4] = HEADER_VERSION;
+    bytes[5] = header->encoding;
+    put_u16(bytes + 6, HEADER_SIZE);
+    put_u32(bytes + 8, header->x_dimension);
+    put_u32(bytes + 12, header->y_dimension);
+    put_u32(bytes + 16, header->start_x);
+    put_u32(bytes + 20, header->start_y);
+    put_u32(bytes + 24, header->end_x);
+    put_u32(bytes + 28, header->end_y);
+    put_u64(bytes + 32, header->seed);
+    put_u32(bytes + 40, header->algorithm);
+
+    return fwrite(bytes, HEADER_SIZE, 1, maze_file) == 1 ? MAZE_OK : MAZE_ERROR_WRITE;
+}
+
+
+/*************************************************************************************************************
+ * read_header():    Purpose: Reads and decodes a header in either the legacy 4-byte format                  *
+ *                            or the current versioned format. Leaves the file position                      *
+ *                            indicator at the first cell of the maze.                                       *
+ *                   Parameters: FILE *maze_file --> the file to read from                                   *
+ *                               struct maze_header *header --> where to store the decoded header            *
+ *                   Return value: int --> MAZE_OK, MAZE_ERROR_READ, or MAZE_ERROR_FORMAT if the header      *
+ *                                         is not one this program could have written                        *
+ *                   Side effects: - moves the file position indicator for maze_file                         *
+ *                                 - modifies *header                                                        *
+ *************************************************************************************************************/
+int read_header(FILE *maze_file, struct maze_header *header)
+// Requires <stdio.h> for the type "FILE *" and fread(),
+//  requires <string.h> for memcmp(),
+//  requires "libmaze.h" for the status codes,
+//  requires "maze_file.h" for header macros,
+//  & requires get_u16(), get_u32(), and get_u64()
+{
+    uint8_t bytes[HEADER_SIZE_MAX];
+
+    if (fread(bytes, HEADER_MAGIC_SIZE, 1, maze_file) != 1)
+        return MAZE_ERROR_READ;
+
+    // Files without the magic bytes use the legacy header, one byte per field:
+    if (memcmp(bytes, HEADER_MAGIC, HEADER_MAGIC_SIZE) != 0)
+    {
+        header->version = 1;
+        header->encoding = ENCODING_CHARS;
+        header->size = LEGACY_HEADER_SIZE;
+        header->x_dimension = bytes[0];
+        header->y_dimension = bytes[1];
+        header->start_x = bytes[2];
+        header->start_y = bytes[3];
+        header->end_x = 0; // Legacy files do not record the End; find_legacy_end() locates it.
+        header->end_y = 0;
+        header->seed = 0;
+        header->algorithm = 0;
+    }
+    else
+    {
+        if (fread(bytes + HEADER_MAGIC_SIZE, 4, 1, maze_file) != 1)
+            return MAZE_ERROR_READ;
+        header->version = bytes[4];
+        header->encoding = bytes[5];
+        header->size = get_u16(bytes + 6);
+        if (header->version != HEADER_VERSION
+            || (header->encoding != ENCODING_CHARS && header->encoding != ENCODING_PACKED)
+            || header->size < HEADER_SIZE_SEEDLESS || header->size > HEADER_SIZE_MAX)
+            return MAZE_ERROR_FORMAT;
+
+        // Read the rest of the header, including any fields appended by newer writers:
+        if (fread(bytes + 8, header->size - 8, 1, maze_file) != 1)
+            return MAZE_ERROR_READ;
+        header->x_dimension = get_u32(bytes + 8);
+        header->y_dimension = get_u32(bytes + 12);
+        header->start_x = get_u32(bytes + 16);
+        header->start_y = get_u32(bytes + 20);
+        header->end_x = get_u32(bytes + 24);
+        header->end_y = get_u32(bytes + 28);
+        // Fields appended since the first version-2 headers are read only when the header is long enough:
+        header->seed = header->size >= 40 ? get_u64(bytes + 32) : 0;
+        header->algorithm = header->size >= 44 ? get_u32(bytes + 40) : 0;
+    }
+
+    // Reject dimensions this program could never have written:
+    if (header->x_dimension < 3 || header->y_dimension < 3
+        || header->x_dimension > MAX_DIMENSION || header->y_dimension > MAX_DIMENSION
+        || header->start_x >= header->x_dimension || header->start_y >= header->y_dimension
+        || header->end_x >= header->x_dimension || header->end_y >= header->y_dimension)
+        return MAZE_ERROR_FORMAT;
+
+    return MAZE_OK;
+}
+
+
+/***********************************************************************************************************
+ * load_maze():    Purpose: Reads a maze file (header and cells) into a heap-allocated grid.               *
+ *                 Parameters: FILE *maze_file --> the file to read from                                   *
+ *                             struct maze_header *header --> where to store the decoded header            *
+ *                             char **maze --> where to store the row-major grid; free() it when done      *
+ *                 Return value: int --> MAZE_OK, or the failure (nothing is then left to free)            *
+ *                 Side effects: - moves the file position indicator for maze_file                         *
+ *                               - modifies *header and *maze                                              *
+ *                               - allocates memory                                                        *
+ ***********************************************************************************************************/
+int load_maze(FILE *maze_file, struct maze_header *header, char **maze)
+// Requires <stdio.h> for the type "FILE *",
+//  requires "libmaze.h" for the status codes,
+//  & requires read_header() and read_cells()
+{
+    // Variable declarations:
+    int status = read_header(maze_file, header);
+
+    return status == MAZE_OK ? read_cells(maze_file, header, maze) : status;
+}
+
+
+/********************************************************************************************************
+ * map_maze():    Purpose: Maps a maze file read-only into memory and returns its cells in place,       *
+ *                         so pages are only read from disk as they are first touched and opening       *
+ *                         a maze takes the same time whatever its size. Falls back to reading the      *
+ *                         cells into a heap-allocated grid if the file cannot be mapped (a pipe,       *
+ *                         say, or a header not at the start of the file) or is packed.                 *
+ *                Parameters: FILE *maze_file --> the file to read from, positioned at its start        *
+ *                            struct maze_header *header --> where to store the decoded header          *
+ *                            char **maze --> where to store the row-major grid; pass it to             *
+ *                                            release_maze() when done                                  *
+ *                            size_t *mapped_length --> where to store the length of the mapping,       *
+ *                                                      or 0 if the cells were read instead             *
+ *                Return value: int --> MAZE_OK, or the failure (nothing is then left to release)       *
+ *                Side effects: - moves the file position indicator for maze_file                       *
+ *                              - modifies *header, *maze, and *mapped_length                           *
+ *                              - maps or allocates memory                                              *
+ ********************************************************************************************************/
+int map_maze(FILE *maze_file, struct maze_header *header, char **maze, size_t *mapped_length)
+// Requires <stdio.h> for the type "FILE *", ftell(), and fileno(),
+//  requires <sys/mman.h> for mmap(),
+//  requires <sys/stat.h> for fstat() and "struct stat",
+//  requires "libmaze.h" for the status codes,
+//  & requires read_header(), read_cells(), and find_legacy_end()
+{
+    // Variable declarations:
+    struct stat status;
+    size_t length;
+    char *file;
+    int result = read_header(maze_file, header);
+
+    *mapped_length = 0;
+    if (result != MAZE_OK)
+        return result;
+    length = header->size + (size_t) header->y_dimension * header->x_dimension;
+
+    // Map the whole file from its start, but only if it holds every cell as a char (touching a
+    //  page past the end of a mapped file is fatal):
+    if (header->encoding != ENCODING_CHARS || ftell(maze_file) != header->size || fstat(fileno(maze_file), &status) != 0
+        || !S_ISREG(status.st_mode) || (uint64_t) status.st_size < length)
+        return read_cells(maze_file, header, maze);
+    file = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileno(maze_file), 0);
+    if (file == MAP_FAILED)
+        return read_cells(maze_file, header, maze);
+
+    *mapped_length = length;
+    *maze = file + header->size;
+    if (header->version == 1)
+        find_legacy_end(*maze, header);
+    return MAZE_OK;
+}
+
+
+/**********************************************************************************************************
+ * release_maze():    Purpose: Frees a grid returned by map_maze(), unmapping it if it was mapped.        *
+ *                    Parameters: char *maze --> the grid                                                 *
+ *                                const struct maze_header *header --> the header map_maze() decoded      *
+ *                                size_t mapped_length --> the length map_maze() reported                 *
+ *                    Return value: none                                                                  *
+ *                    Side effects: unmaps or frees memory                                                *
+ **********************************************************************************************************/
+void release_maze(char *maze, const struct maze_header *header, size_t mapped_length)
+// Requires <stdlib.h> for free(),
+//  & requires <sys/mman.h> for munmap()
+{
+    if (mapped_length > 0)
+        (void) munmap(maze - header->size, mapped_length);
+    else
+        free(maze);
+}
+
+
+/************************************************************************************************************
+ * read_cells():    Purpose: Reads the cells following a decoded header into a heap-allocated grid,         *
+ *                           decoding them first if they are packed.                                        *
+ *                  Parameters: FILE *maze_file --> the file to read from, positioned after the header      *
+ *                              struct maze_header *header --> the decoded header                           *
+ *                              char **maze --> where to store the row-major grid; free() it when done      *
+ *                  Return value: int --> MAZE_OK, or the failure (nothing is then left to free)            *
+ *                  Side effects: - moves the file position indicator for maze_file                         *
+ *                                - modifies *header (the End of a legacy maze) and *maze                   *
+ *                                - allocates memory                                                        *
+ ************************************************************************************************************/
+int read_cells(FILE *maze_file, struct maze_header *header, char **maze)
+// Requires <stdio.h> for the type "FILE *" and fread(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires "packed.h" for read_packed_index(), read_packed_rows(), and "struct packed_index",
+//  requires "libmaze.h" for the status codes,
+//  & requires find_legacy_end()
+{
+    // Variable declarations:
+    size_t cells = (size_t) header->y_dimension * header->x_dimension;
+    struct packed_index index;
+    int status;
+
+    *maze = malloc(cells);
+    if (*maze == NULL)
+        return MAZE_ERROR_MEMORY;
+
+    // Packed mazes are decoded whole; char mazes are read as they are:
+    if (header->encoding == ENCODING_PACKED)
+    {
+        status = read_packed_index(maze_file, header, &index);
+        if (status == MAZE_OK)
+        {
+            status = read_packed_rows(maze_file, header, &index, 0, (int) header->y_dimension, *maze);
+            free(index.offsets);
+        }
+    }
+    else
+        status = fread(*maze, cells, 1, maze_file) == 1 ? MAZE_OK : MAZE_ERROR_READ;
+
+    if (status != MAZE_OK)
+    {
+        free(*maze);
+        return status;
+    }
+    if (header->version == 1)
+        find_legacy_end(*maze, header);
+    return MAZE_OK;
+}
+
+
+/**************************************************************************************************************
+ * find_legacy_end():    Purpose: Legacy headers carry no End coordinates, so finds the End in the grid.      *
+ *                       Parameters: const char *maze --> the row-major grid                                  *
+ *                                   struct maze_header *header --> the decoded legacy header                 *
+ *                       Return value: none                                                                   *
+ *                       Side effects: modifies *header                                                       *
+ **************************************************************************************************************/
+void find_legacy_end(const char *maze, struct maze_header *header)
+// Requires "shared.h" for macros
+{
+    // Variable declarations:
+    int x_dimension = (int) header->x_dimension;
+
+    for (int i = 0; i < (int) header->y_dimension; i++)
+        for (int j = 0; j < x_dimension; j++)
+            if (MAZE_OF_I_OF_J == END)
+            {
+                header->end_y = i;
+                header->end_x = j;
+            }
+}
+
+
+/********************************************************************************************************
+ * write_cells():    Purpose: Writes a maze's cells as one char each, row-major, expanding as many      *
+ *                            whole rows as fit in WRITE_BLOCK_SIZE bytes at a time so that each        *
+ *                            block costs one fwrite() and one check.                                   *
+ *                   Parameters: FILE *maze_file --> the file to write to                               *
+ *                               const struct bitgrid *grid --> the maze to write                       *
+ *                   Return value: int --> MAZE_OK, or the failure                                      *
+ *                   Side effects: modifies the file pointed to by maze_file                            *
+ ********************************************************************************************************/
+int write_cells(FILE *maze_file, const struct bitgrid *grid)
+// Requires <stdio.h> for the type "FILE *" and fwrite(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires "libmaze.h" for the status codes,
+//  & requires "bitgrid.h" for "struct bitgrid" and bitgrid_row_to_chars()
+{
+    // Variable declarations:
+    size_t x_dimension = (size_t) grid->x_dimension;
+    size_t block_rows = WRITE_BLOCK_SIZE / x_dimension, rows;
+    char *block;
+    int status = MAZE_OK;
+
+    // Size the block to whole rows, at least one and no more than the maze holds:
+    if (block_rows == 0)
+        block_rows = 1;
+    if (block_rows > (size_t) grid->y_dimension)
+        block_rows = (size_t) grid->y_dimension;
+    block = malloc(block_rows * x_dimension);
+    if (block == NULL)
+        return MAZE_ERROR_MEMORY;
+
+    // Expand and write the maze a block of rows at a time:
+    for (int i = 0; i < grid->y_dimension && status == MAZE_OK; i += (int) rows)
+    {
+        rows = (size_t) (grid->y_dimension - i) < block_rows ? (size_t) (grid->y_dimension - i) : block_rows;
+        for (size_t k = 0; k < rows; k++)
+            bitgrid_row_to_chars(grid, i + (int) k, block + k * x_dimension);
+        if (fwrite(block, rows * x_dimension, 1, maze_file) != 1)
+            status = MAZE_ERROR_WRITE;
+    }
+
+    free(block);
+    return status;
+}
+
+
+/************************************************************************************************************
+ * write_packed_cells():    Purpose: Writes a maze's cells in the packed encoding, a row at a time.         *
+ *                          Parameters: FILE *maze_file --> the file, positioned just after the header      *
+ *                                      const struct bitgrid *grid --> the maze to write                    *
+ *                          Return value: int --> MAZE_OK, or the failure                                   *
+ *                          Side effects: modifies the file pointed to by maze_file                         *
+ ************************************************************************************************************/
+int write_packed_cells(FILE *maze_file, const struct bitgrid *grid)
+// Requires <stdio.h> for the type "FILE *",
+//  requires <stdlib.h> for malloc() and free(),
+//  requires "libmaze.h" for the status codes,
+//  requires "bitgrid.h" for "struct bitgrid" and bitgrid_row_to_chars(),
+//  & requires "packed.h" for packed_begin(), packed_put_row(), packed_finish(), and "struct packed_writer"
+{
+    // Variable declarations:
+    struct packed_writer writer;
+    char *row = malloc((size_t) grid->x_dimension);
+    int status = row == NULL ? MAZE_ERROR_MEMORY
+                 : packed_begin(&writer, maze_file, grid->y_dimension, grid->x_dimension);
+
+    if (status == MAZE_OK)
+    {
+        for (int i = 0; i < grid->y_dimension && status == MAZE_OK; i++)
+        {
+            bitgrid_row_to_chars(grid, i, row);
+            status = packed_put_row(&writer, row);
+        }
+        status = packed_finish(&writer);
+    }
+
+    free(row);
+    return status;
+}
+
+
+/********************************************************************************************************************
+ * put_u16(), put_u32(), put_u64():    Purpose: Store an unsigned integer as little-endian bytes.                   *
+ *                                     Parameters: uint8_t *bytes --> where to store the value                      *
+ *                                                 uint16_t / uint32_t / uint64_t value --> the value to store      *
+ *                                     Return value: none                                                           *
+ *                                     Side effects: modifies the bytes pointed to by bytes                         *
+ ********************************************************************************************************************/
+void put_u16(uint8_t *bytes, uint16_t value)
+// Requires <stdint.h> for the types "uint8_t" and "uint16_t"
+{
+    bytes[0] = (uint8_t) value;
+    bytes[1] = (uint8_t) (value >> 8);
+}
+
+void put_u32(uint8_t *bytes, uint32_t value)
+// Requires <stdint.h> for the types "uint8_t" and "uint32_t"
+{
+    for (int k = 0; k < 4; k++)
+        bytes[k] = (uint8_t) (value >> (8 * k));
+}
+
+void put_u64(uint8_t *bytes, uint64_t value)
+// Requires <stdint.h> for the types "uint8_t" and "uint64_t"
+{
+    for (int k = 0; k < 8; k++)
+        bytes[k] = (uint8_t) (value >> (8 * k));
+}
+
+
+/***************************************************************************************************************
+ * get_u16(), get_u32(), get_u64():    Purpose: Load an unsigned integer from little-endian bytes.             *
+ *                                     Parameters: const uint8_t *bytes --> where the value is stored          *
+ *                                     Return value: uint16_t / uint32_t / uint64_t --> the decoded value      *
+ *                                     Side effects: none                                                      *
+ ***************************************************************************************************************/
+uint16_t get_u16(const uint8_t *bytes)
+// Requires <stdint.h> for the types "uint8_t" and "uint16_t"
+{
+    return (uint16_t) (bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t *bytes)
+// Requires <stdint.h> for the types "uint8_t" and "uint32_t"
+{
+    uint32_t value = 0;
+
+    for (int k = 3; k >= 0; k--)
+        value = (value << 8) | bytes[k];
+    return value;
+}
+
+uint64_t get_u64(const uint8_t *bytes)
+// Requires <stdint.h> for the types "uint8_t" and "uint64_t"
+{
+    uint64_t value = 0;
+
+    for (int k = 7; k >= 0; k--)
+        value = (value << 8) | bytes[k];
+    return value;
+}
\ No newline at end of file
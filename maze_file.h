@@ -0,0 +1,59 @@
+/****************************************************************************************************
+ * Name: maze_file.h                                                                                *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for maze_file.c                                                             *
+ ****************************************************************************************************/
+
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stddef.h> // for the type "size_t"
+#include <stdint.h> // for the types "uint8_t", "uint16_t", "uint32_t", and "uint64_t"
+#include "bitgrid.h" // for "struct bitgrid"
+
+/* Object-Like Macros */
+#define LEGACY_HEADER_SIZE 4 // x_dimension, y_dimension, start_x, start_y; one byte each
+#define HEADER_MAGIC "MAZE"
+#define HEADER_MAGIC_SIZE 4
+#define HEADER_VERSION 2
+#define HEADER_SIZE 44
+#define HEADER_SIZE_SEEDLESS 32 // size of the first version-2 headers, written before the seed was recorded
+#define HEADER_SIZE_MAX 256 // largest header a reader will accept; leaves room for appended fields
+#define ENCODING_CHARS 0 // one char per cell, row-major
+#define ENCODING_PACKED 1 // one entropy-coded bit per cell, in blocks of rows behind an index (see packed.c)
+#define WRITE_BLOCK_SIZE (1 << 20) // bytes of cells gathered before each fwrite(); always at least one row
+
+/* Structures */
+struct maze_header
+{
+    uint8_t version; // 1 for the legacy 4-byte header, HEADER_VERSION otherwise
+    uint8_t encoding; // how the cells following the header are stored
+    uint16_t size; // number of bytes the header occupies in the file
+    uint32_t x_dimension;
+    uint32_t y_dimension;
+    uint32_t start_x;
+    uint32_t start_y;
+    uint32_t end_x;
+    uint32_t end_y;
+    uint64_t seed; // the generation seed; 0 when the file does not record one
+    uint32_t algorithm; // the ALGORITHM_ macro (see generation.h) the maze was generated with
+};
+
+/* Function Prototypes */
+int write_header(FILE *maze_file, const struct maze_header *header);
+int read_header(FILE *maze_file, struct maze_header *header);
+int load_maze(FILE *maze_file, struct maze_header *header, char **maze);
+int map_maze(FILE *maze_file, struct maze_header *header, char **maze, size_t *mapped_length);
+void release_maze(char *maze, const struct maze_header *header, size_t mapped_length);
+void put_u16(uint8_t *bytes, uint16_t value);
+void put_u32(uint8_t *bytes, uint32_t value);
+void put_u64(uint8_t *bytes, uint64_t value);
+uint16_t get_u16(const uint8_t *bytes);
+uint32_t get_u32(const uint8_t *bytes);
+uint64_t get_u64(const uint8_t *bytes);
+int write_cells(FILE *maze_file, const struct bitgrid *grid);
+int write_packed_cells(FILE *maze_file, const struct bitgrid *grid);
+
+#endif
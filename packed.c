@@ -0,0 +1,533 @@
+/****************************************************************************************************
+ * Name: packed.c                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements the packed maze encoding: one bit per cell, entropy-coded in blocks of rows  *
+ *          with an adaptive binary range coder, behind an index of where each block starts.        *
+ ****************************************************************************************************/
+
+#include <stdio.h> // for the type "FILE *" and fread(), fwrite(), ftell(), and fseek()
+#include <stdlib.h> // for malloc(), calloc(), realloc(), and free()
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <string.h> // for memset()
+#include <stdint.h> // for the types "uint8_t", "uint16_t", "uint32_t", and "uint64_t"
+#include "shared.h" // for macros
+#include "libmaze.h" // for the MAZE_ status codes
+#include "maze_file.h" // for "struct maze_header", put_u32(), put_u64(), get_u32(), and get_u64()
+#include "packed.h" // for "struct packed_writer", "struct packed_index", and macros
+
+/* Object-Like Macros */
+#define PROBABILITY_BITS 11
+#define PROBABILITY_ONE (1 << PROBABILITY_BITS)
+#define ADAPTATION_SHIFT 4 // larger adapts more slowly but settles closer
+#define RANGE_TOP (1u << 24)
+#define RANGE_FLUSH_BYTES 5
+#define INDEX_FIXED_SIZE 8 // block_rows and blocks, before the offsets
+
+/* Parameterized Macros */
+#define BLOCK_COUNT(y_dimension) (((y_dimension) + PACKED_BLOCK_ROWS - 1) / PACKED_BLOCK_ROWS)
+#define INDEX_SIZE(blocks) (INDEX_FIXED_SIZE + 8 * ((size_t) (blocks) + 1))
+#define IS_OPEN(cell) ((cell) == FLOOR || (cell) == START || (cell) == END)
+
+/* Internal Function Prototypes */
+void reset_model(struct packed_model *model);
+unsigned cell_context(uint8_t *const *context, int p);
+void rotate_context(uint8_t **context);
+void encode_bit(struct packed_writer *writer, uint16_t *probability, int bit);
+void shift_low(struct packed_writer *writer);
+void write_index(struct packed_writer *writer);
+
+/***********************************************************************************************************
+ * packed_begin():    Purpose: Starts writing a maze in the packed encoding, reserving space for the       *
+ *                             block index just after the header.                                          *
+ *                    Parameters: struct packed_writer *writer --> the writer to start                     *
+ *                                FILE *maze_file --> the file, positioned just after the header           *
+ *                                int y_dimension --> the height of the maze (in characters)               *
+ *                                int x_dimension --> the width of the maze (in characters)                *
+ *                    Return value: int --> MAZE_OK, or the failure; the writer then holds nothing to      *
+ *                                          free, and must not be used                                     *
+ *                    Side effects: - modifies *writer and allocates its buffers                           *
+ *                                  - modifies the file pointed to by maze_file                            *
+ ***********************************************************************************************************/
+int packed_begin(struct packed_writer *writer, FILE *maze_file, int y_dimension, int x_dimension)
+// Requires <stdio.h> for the type "FILE *" and ftell(),
+//  requires <stdlib.h> for malloc(), calloc(), and free(),
+//  requires "libmaze.h" for the status codes,
+//  & requires write_index()
+{
+    // Variable declarations:
+    size_t padded = (size_t) x_dimension + 2 * PACKED_MARGIN;
+
+    writer->maze_file = maze_file;
+    writer->y_dimension = y_dimension;
+    writer->x_dimension = x_dimension;
+    writer->row = 0;
+    writer->status = MAZE_OK;
+    writer->offsets = calloc((size_t) BLOCK_COUNT(y_dimension) + 1, sizeof(uint64_t));
+    writer->context_rows = calloc(3 * padded, 1);
+    writer->block_capacity = (size_t) x_dimension * PACKED_BLOCK_ROWS / 8 + RANGE_FLUSH_BYTES;
+    writer->block = malloc(writer->block_capacity);
+    if (writer->offsets == NULL || writer->context_rows == NULL || writer->block == NULL)
+        writer->status = MAZE_ERROR_MEMORY;
+    else
+    {
+        writer->context[0] = writer->context_rows;
+        writer->context[1] = writer->context[0] + padded;
+        writer->context[2] = writer->context[1] + padded;
+    }
+
+    // The index is written now as a placeholder, and again once every block's offset is known:
+    writer->index_position = writer->status == MAZE_OK ? ftell(maze_file) : 0;
+    if (writer->index_position < 0)
+        writer->status = MAZE_ERROR_SEEK;
+    write_index(writer);
+
+    if (writer->status != MAZE_OK)
+    {
+        free(writer->offsets);
+        free(writer->context_rows);
+        free(writer->block);
+    }
+    return writer->status;
+}
+
+
+/**********************************************************************************************************
+ * packed_put_row():    Purpose: Codes the next row of the maze, and writes out its block once the        *
+ *                               block is complete. Each interior cell costs one bit, coded with a        *
+ *                               probability learned for the arrangement of the ten neighbours            *
+ *                               coded before it; the border is implied by the dimensions, and the        *
+ *                               Start and End by the header.                                             *
+ *                      Parameters: struct packed_writer *writer --> the writer                           *
+ *                                  const char *row --> the row's cells, one char each                    *
+ *                      Return value: int --> MAZE_OK, or the writer's first failure, after which         *
+ *                                            nothing more is written (packed_finish() is still due)      *
+ *                      Side effects: - modifies *writer                                                  *
+ *                                    - modifies the file pointed to by the writer                        *
+ **********************************************************************************************************/
+int packed_put_row(struct packed_writer *writer, const char *row)
+// Requires <stdio.h> for ftell() and fwrite(),
+//  requires <string.h> for memset(),
+//  requires "shared.h" for macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires reset_model(), cell_context(), rotate_context(), encode_bit(), and shift_low()
+{
+    // Variable declarations:
+    FILE *maze_file = writer->maze_file;
+    int x_dimension = writer->x_dimension;
+    uint8_t *current;
+    long position;
+    int bit;
+
+    if (writer->status != MAZE_OK)
+        return writer->status;
+
+    // A block starts from scratch, so that it can later be decoded on its own:
+    if (writer->row % PACKED_BLOCK_ROWS == 0)
+    {
+        position = ftell(maze_file);
+        if (position < 0)
+            return writer->status = MAZE_ERROR_SEEK;
+        writer->offsets[writer->row / PACKED_BLOCK_ROWS] = (uint64_t) position;
+        reset_model(&writer->model);
+        memset(writer->context_rows, 0, 3 * ((size_t) x_dimension + 2 * PACKED_MARGIN));
+        writer->low = 0;
+        writer->range = 0xFFFFFFFF;
+        writer->cache = 0;
+        writer->cache_size = 1;
+        writer->block_length = 0;
+    }
+
+    // Code the interior cells; border rows carry nothing:
+    current = writer->context[2] + PACKED_MARGIN;
+    memset(current, 0, (size_t) x_dimension);
+    if (writer->row > 0 && writer->row < writer->y_dimension - 1)
+        for (int j = 1; j < x_dimension - 1; j++)
+        {
+            bit = IS_OPEN(row[j]);
+            encode_bit(writer, &writer->model.probability[cell_context(writer->context, j + PACKED_MARGIN)], bit);
+            current[j] = (uint8_t) bit;
+        }
+    rotate_context(writer->context);
+    writer->row++;
+
+    // Flush the range coder and write the block once it is complete:
+    if (writer->row % PACKED_BLOCK_ROWS == 0 || writer->row == writer->y_dimension)
+    {
+        for (int k = 0; k < RANGE_FLUSH_BYTES; k++)
+            shift_low(writer);
+        if (writer->status == MAZE_OK && writer->block_length > 0
+            && fwrite(writer->block, writer->block_length, 1, maze_file) != 1)
+            writer->status = MAZE_ERROR_WRITE;
+    }
+
+    return writer->status;
+}
+
+
+/**********************************************************************************************************
+ * packed_finish():    Purpose: Completes a packed maze by filling in the block index, and frees the      *
+ *                              writer's buffers.                                                         *
+ *                     Parameters: struct packed_writer *writer --> the writer, after every row           *
+ *                     Return value: int --> MAZE_OK, or the writer's first failure                       *
+ *                     Side effects: - modifies the file pointed to by the writer, and leaves it          *
+ *                                     positioned after the maze                                          *
+ *                                   - frees the writer's buffers, even after a failure                   *
+ **********************************************************************************************************/
+int packed_finish(struct packed_writer *writer)
+// Requires <stdio.h> for ftell() and fseek(),
+//  requires <stdlib.h> for free(),
+//  requires "libmaze.h" for the status codes,
+//  & requires write_index()
+{
+    // Variable declarations:
+    FILE *maze_file = writer->maze_file;
+    long end = writer->status == MAZE_OK ? ftell(maze_file) : 0;
+
+    if (end < 0 || (writer->status == MAZE_OK && fseek(maze_file, writer->index_position, SEEK_SET) != 0))
+        writer->status = MAZE_ERROR_SEEK;
+    if (writer->status == MAZE_OK)
+    {
+        writer->offsets[BLOCK_COUNT(writer->y_dimension)] = (uint64_t) end;
+        write_index(writer);
+        if (fseek(maze_file, end, SEEK_SET) != 0 && writer->status == MAZE_OK)
+            writer->status = MAZE_ERROR_SEEK;
+    }
+
+    free(writer->offsets);
+    free(writer->context_rows);
+    free(writer->block);
+    return writer->status;
+}
+
+
+/*************************************************************************************************************
+ * read_packed_index():    Purpose: Reads and checks the block index of a packed maze.                       *
+ *                         Parameters: FILE *maze_file --> the file, positioned just after the header        *
+ *                                     const struct maze_header *header --> the decoded header               *
+ *                                     struct packed_index *index --> where to store the index               *
+ *                         Return value: int --> MAZE_OK, or the failure (nothing is then left to free)      *
+ *                         Side effects: - moves the file position indicator for maze_file                   *
+ *                                       - modifies *index and allocates its offsets; free() them            *
+ *************************************************************************************************************/
+int read_packed_index(FILE *maze_file, const struct maze_header *header, struct packed_index *index)
+// Requires <stdio.h> for the type "FILE *" and fread(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <stdbool.h> for the type "bool",
+//  requires "libmaze.h" for the status codes,
+//  & requires "maze_file.h" for get_u32() and get_u64()
+{
+    // Variable declarations:
+    uint8_t fixed[INDEX_FIXED_SIZE], *bytes;
+    size_t length;
+    bool valid = true;
+
+    if (fread(fixed, INDEX_FIXED_SIZE, 1, maze_file) != 1)
+        return MAZE_ERROR_READ;
+    index->block_rows = get_u32(fixed);
+    index->blocks = get_u32(fixed + 4);
+    if (index->block_rows != PACKED_BLOCK_ROWS || index->blocks != BLOCK_COUNT(header->y_dimension))
+        return MAZE_ERROR_FORMAT;
+
+    length = INDEX_SIZE(index->blocks) - INDEX_FIXED_SIZE;
+    bytes = malloc(length);
+    index->offsets = malloc(((size_t) index->blocks + 1) * sizeof(uint64_t));
+    if (bytes == NULL || index->offsets == NULL || fread(bytes, length, 1, maze_file) != 1)
+    {
+        free(bytes);
+        free(index->offsets);
+        return bytes == NULL || index->offsets == NULL ? MAZE_ERROR_MEMORY : MAZE_ERROR_READ;
+    }
+
+    // Blocks follow the index, in order:
+    for (uint32_t b = 0; b <= index->blocks; b++)
+    {
+        index->offsets[b] = get_u64(bytes + 8 * (size_t) b);
+        if (b == 0)
+            valid = index->offsets[0] == header->size + INDEX_SIZE(index->blocks);
+        else
+            valid = valid && index->offsets[b] >= index->offsets[b - 1];
+    }
+    free(bytes);
+    if (!valid)
+    {
+        free(index->offsets);
+        return MAZE_ERROR_FORMAT;
+    }
+
+    return MAZE_OK;
+}
+
+
+/*********************************************************************************************************
+ * read_packed_rows():    Purpose: Decodes a range of rows of a packed maze into chars, reading and      *
+ *                                 decoding only the blocks that hold them.                              *
+ *                        Parameters: FILE *maze_file --> the file to read from                          *
+ *                                    const struct maze_header *header --> the decoded header            *
+ *                                    const struct packed_index *index --> the decoded block index       *
+ *                                    int first_row --> the first row to decode                          *
+ *                                    int rows --> how many rows to decode                               *
+ *                                    char *cells --> where to store them, row-major                     *
+ *                        Return value: int --> MAZE_OK, or the failure                                  *
+ *                        Side effects: - moves the file position indicator for maze_file                *
+ *                                      - modifies the cells                                             *
+ *********************************************************************************************************/
+int read_packed_rows(FILE *maze_file, const struct maze_header *header, const struct packed_index *index,
+                     int first_row, int rows, char *cells)
+// Requires <stdio.h> for the type "FILE *", fread(), and fseek(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <string.h> for memset(),
+//  requires "shared.h" for macros,
+//  requires "libmaze.h" for the status codes,
+//  & requires reset_model(), cell_context(), and rotate_context()
+{
+    // Variable declarations:
+    int x_dimension = (int) header->x_dimension, y_dimension = (int) header->y_dimension;
+    size_t padded = (size_t) x_dimension + 2 * PACKED_MARGIN, length, next;
+    uint8_t *context[3], *context_rows, *current, *block = NULL;
+    struct packed_model model;
+    uint32_t range, code, bound;
+    uint16_t *probability;
+    char *row;
+    int bit, status = MAZE_OK;
+
+    context_rows = malloc(3 * padded);
+    if (context_rows == NULL)
+        return MAZE_ERROR_MEMORY;
+    context[0] = context_rows;
+    context[1] = context[0] + padded;
+    context[2] = context[1] + padded;
+
+    for (int b = first_row / PACKED_BLOCK_ROWS; b * PACKED_BLOCK_ROWS < first_row + rows && status == MAZE_OK; b++)
+    {
+        // Read the block whole, and start the range decoder on it:
+        length = (size_t) (index->offsets[b + 1] - index->offsets[b]);
+        free(block);
+        block = malloc(length + RANGE_FLUSH_BYTES);
+        status = block == NULL ? MAZE_ERROR_MEMORY
+                 : fseek(maze_file, (long) index->offsets[b], SEEK_SET) != 0 ? MAZE_ERROR_SEEK
+                 : length > 0 && fread(block, length, 1, maze_file) != 1 ? MAZE_ERROR_READ : MAZE_OK;
+        if (status != MAZE_OK)
+            break;
+        memset(block + length, 0, RANGE_FLUSH_BYTES); // a damaged block decodes to nonsense, not a crash
+        reset_model(&model);
+        memset(context_rows, 0, 3 * padded);
+        range = 0xFFFFFFFF;
+        code = 0;
+        for (next = 0; next < RANGE_FLUSH_BYTES; next++)
+            code = (code << 8) | block[next];
+
+        for (int i = b * PACKED_BLOCK_ROWS; i < (b + 1) * PACKED_BLOCK_ROWS && i < y_dimension; i++)
+        {
+            current = context[2] + PACKED_MARGIN;
+            memset(current, 0, (size_t) x_dimension);
+            if (i > 0 && i < y_dimension - 1)
+                for (int j = 1; j < x_dimension - 1; j++)
+                {
+                    probability = &model.probability[cell_context(context, j + PACKED_MARGIN)];
+                    bound = (range >> PROBABILITY_BITS) * *probability;
+                    if (code < bound)
+                    {
+                        range = bound;
+                        *probability += (PROBABILITY_ONE - *probability) >> ADAPTATION_SHIFT;
+                        bit = 0;
+                    }
+                    else
+                    {
+                        code -= bound;
+                        range -= bound;
+                        *probability -= *probability >> ADAPTATION_SHIFT;
+                        bit = 1;
+                    }
+                    while (range < RANGE_TOP)
+                    {
+                        range <<= 8;
+                        code = (code << 8) | (next < length + RANGE_FLUSH_BYTES ? block[next++] : 0);
+                    }
+                    current[j] = (uint8_t) bit;
+                }
+
+            // Expand the row into chars if it was asked for:
+            if (i >= first_row && i < first_row + rows)
+            {
+                row = cells + (size_t) (i - first_row) * x_dimension;
+                for (int j = 0; j < x_dimension; j++)
+                    row[j] = i == 0 || i == y_dimension - 1 || j == 0 || j == x_dimension - 1 ? BORDER
+                             : current[j] ? FLOOR : WALL;
+                if (i == (int) header->start_y)
+                    row[header->start_x] = START;
+                if (i == (int) header->end_y)
+                    row[header->end_x] = END;
+            }
+            rotate_context(context);
+        }
+    }
+
+    free(block);
+    free(context_rows);
+    return status;
+}
+
+
+/****************************************************************************************
+ * reset_model():    Purpose: Sets every context's probability back to even.            *
+ *                   Parameters: struct packed_model *model --> the model to reset      *
+ *                   Return value: none                                                 *
+ *                   Side effects: modifies *model                                      *
+ ****************************************************************************************/
+void reset_model(struct packed_model *model)
+{
+    for (int k = 0; k < PACKED_CONTEXTS; k++)
+        model->probability[k] = PROBABILITY_ONE / 2;
+}
+
+
+/********************************************************************************************************
+ * cell_context():    Purpose: Gathers the open bits of the ten cells above and to the left of a        *
+ *                             cell (two rows up and two columns either side), which are all coded      *
+ *                             before it.                                                               *
+ *                    Parameters: uint8_t *const *context --> the rows two up, one up, and current      *
+ *                                int p --> the cell's padded column                                    *
+ *                    Return value: unsigned --> the context, 0 to PACKED_CONTEXTS - 1                  *
+ *                    Side effects: none                                                                *
+ ********************************************************************************************************/
+unsigned cell_context(uint8_t *const *context, int p)
+{
+    return context[1][p] | context[2][p - 1] << 1 | context[1][p - 1] << 2 | context[1][p + 1] << 3
+           | context[2][p - 2] << 4 | context[0][p] << 5 | context[1][p - 2] << 6 | context[1][p + 2] << 7
+           | context[0][p - 1] << 8 | context[0][p + 1] << 9;
+}
+
+
+/******************************************************************************************************
+ * rotate_context():    Purpose: Moves the context rows up by one once a row has been coded; the      *
+ *                               oldest row's storage becomes the next current row.                   *
+ *                      Parameters: uint8_t **context --> the rows two up, one up, and current        *
+ *                      Return value: none                                                            *
+ *                      Side effects: modifies the context pointers                                   *
+ ******************************************************************************************************/
+void rotate_context(uint8_t **context)
+{
+    uint8_t *oldest = context[0];
+
+    context[0] = context[1];
+    context[1] = context[2];
+    context[2] = oldest;
+}
+
+
+/**************************************************************************************************************
+ * encode_bit():    Purpose: Range-codes one bit with an adaptive probability, then adapts it.                *
+ *                  Parameters: struct packed_writer *writer --> the writer                                   *
+ *                              uint16_t *probability --> the probability of a 0, out of PROBABILITY_ONE      *
+ *                              int bit --> the bit to code                                                   *
+ *                  Return value: none                                                                        *
+ *                  Side effects: modifies *writer and *probability                                           *
+ **************************************************************************************************************/
+void encode_bit(struct packed_writer *writer, uint16_t *probability, int bit)
+// Requires shift_low()
+{
+    uint32_t bound = (writer->range >> PROBABILITY_BITS) * *probability;
+
+    if (bit == 0)
+    {
+        writer->range = bound;
+        *probability += (PROBABILITY_ONE - *probability) >> ADAPTATION_SHIFT;
+    }
+    else
+    {
+        writer->low += bound;
+        writer->range -= bound;
+        *probability -= *probability >> ADAPTATION_SHIFT;
+    }
+    while (writer->range < RANGE_TOP)
+    {
+        writer->range <<= 8;
+        shift_low(writer);
+    }
+}
+
+
+/***********************************************************************************************************
+ * shift_low():    Purpose: Moves the top byte of the range coder's low end out to the block,              *
+ *                          holding back runs of 0xFF until any carry into them is known.                  *
+ *                 Parameters: struct packed_writer *writer --> the writer                                 *
+ *                 Return value: none                                                                      *
+ *                 Side effects: modifies *writer, growing its block buffer as needed (if that fails,      *
+ *                               the writer's status says so and the byte is dropped)                      *
+ ***********************************************************************************************************/
+void shift_low(struct packed_writer *writer)
+// Requires <stdlib.h> for realloc(),
+//  & requires "libmaze.h" for the status codes
+{
+    // Variable declarations:
+    uint8_t carry, pending;
+    uint8_t *grown;
+
+    if ((uint32_t) writer->low < 0xFF000000 || (writer->low >> 32) != 0)
+    {
+        carry = (uint8_t) (writer->low >> 32);
+        pending = writer->cache;
+        do
+        {
+            if (writer->block_length == writer->block_capacity)
+            {
+                grown = realloc(writer->block, writer->block_capacity * 2);
+                if (grown == NULL)
+                {
+                    writer->status = MAZE_ERROR_MEMORY;
+                    writer->block_length = 0;
+                }
+                else
+                {
+                    writer->block = grown;
+                    writer->block_capacity *= 2;
+                }
+            }
+            writer->block[writer->block_length++] = (uint8_t) (pending + carry);
+            pending = 0xFF;
+        } while (--writer->cache_size != 0);
+        writer->cache = (uint8_t) (writer->low >> 24);
+    }
+    writer->cache_size++;
+    writer->low = (writer->low & 0x00FFFFFF) << 8;
+}
+
+
+/*********************************************************************************************************
+ * write_index():    Purpose: Encodes the block index (rows per block, number of blocks, then the        *
+ *                            offset of each block and of the end) and writes it to file.                *
+ *                   Parameters: struct packed_writer *writer --> the writer                             *
+ *                   Return value: none                                                                  *
+ *                   Side effects: - modifies the file pointed to by the writer                          *
+ *                                 - sets the writer's status if memory runs out or the file cannot      *
+ *                                   be written; does nothing if it is already set                       *
+ *********************************************************************************************************/
+void write_index(struct packed_writer *writer)
+// Requires <stdio.h> for fwrite(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires "libmaze.h" for the status codes,
+//  & requires "maze_file.h" for put_u32() and put_u64()
+{
+    // Variable declarations:
+    int blocks = BLOCK_COUNT(writer->y_dimension);
+    uint8_t *bytes;
+
+    if (writer->status != MAZE_OK)
+        return;
+    bytes = malloc(INDEX_SIZE(blocks));
+    if (bytes == NULL)
+    {
+        writer->status = MAZE_ERROR_MEMORY;
+        return;
+    }
+    put_u32(bytes, PACKED_BLOCK_ROWS);
+    put_u32(bytes + 4, (uint32_t) blocks);
+    for (int b = 0; b <= blocks; b++)
+        put_u64(bytes + INDEX_FIXED_SIZE + 8 * (size_t) b, writer->offsets[b]);
+    if (fwrite(bytes, INDEX_SIZE(blocks), 1, writer->maze_file) != 1)
+        writer->status = MAZE_ERROR_WRITE;
+
+    free(bytes);
+    return;
+}
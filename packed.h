@@ -0,0 +1,67 @@
+/****************************************************************************************************
+ * Name: packed.h                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for packed.c                                                                *
+ ****************************************************************************************************/
+
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stdint.h> // for the types "uint8_t", "uint16_t", "uint32_t", and "uint64_t"
+#include <stddef.h> // for the type "size_t"
+#include "maze_file.h" // for "struct maze_header"
+
+/* Object-Like Macros */
+#define PACKED_BLOCK_ROWS 64 // rows per independently decodable block
+#define PACKED_CONTEXT_CELLS 10 // neighbours each cell's probability is conditioned on
+#define PACKED_CONTEXTS (1 << PACKED_CONTEXT_CELLS)
+#define PACKED_MARGIN 2 // columns of padding either side of a context row
+
+/* Structures */
+// Adaptive probabilities of a cell being open, one per arrangement of its already-coded neighbours.
+// They start even at each block, so that blocks can be decoded on their own.
+struct packed_model
+{
+    uint16_t probability[PACKED_CONTEXTS];
+};
+
+// Writes a maze in the packed encoding one row at a time, so that a maze being generated row by row
+// never needs to be held whole. The block index is reserved up front and filled in by packed_finish().
+struct packed_writer
+{
+    FILE *maze_file;
+    int y_dimension, x_dimension;
+    int row; // rows put so far
+    int status; // MAZE_OK, or the first failure (see libmaze.h), after which nothing more is written
+    long index_position; // where the block index starts in the file
+    uint64_t *offsets; // start of each block in the file, then the end of the last
+    uint8_t *context[3]; // open bits of the two rows above and of the current row, padded
+    uint8_t *context_rows; // the storage behind context[], which rotates through it
+    struct packed_model model;
+    uint8_t *block; // the coded bytes of the current block
+    size_t block_length, block_capacity;
+    uint64_t low; // range coder state
+    uint32_t range;
+    uint8_t cache;
+    uint64_t cache_size;
+};
+
+// Where each block of a packed maze starts, read from the block index after the header.
+struct packed_index
+{
+    uint32_t block_rows;
+    uint32_t blocks;
+    uint64_t *offsets; // blocks + 1 entries
+};
+
+/* Function Prototypes */
+int packed_begin(struct packed_writer *writer, FILE *maze_file, int y_dimension, int x_dimension);
+int packed_put_row(struct packed_writer *writer, const char *row);
+int packed_finish(struct packed_writer *writer);
+int read_packed_index(FILE *maze_file, const struct maze_header *header, struct packed_index *index);
+int read_packed_rows(FILE *maze_file, const struct maze_header *header, const struct packed_index *index,
+                     int first_row, int rows, char *cells);
+
+#endif
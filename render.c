@@ -0,0 +1,660 @@
+/****************************************************************************************************
+ * Name: render.c                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements windowed, incremental drawing of the player's map, with a minimap.           *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for write() and "STDOUT_FILENO" under -std=c99
+#include <stdio.h> // for fflush() and snprintf()
+#include <stdlib.h> // for malloc(), calloc(), realloc(), free(), getenv(), and atoi()
+#include <string.h> // for memcpy(), memset(), and strlen()
+#include <stdint.h> // for the types "uint32_t" and "uint64_t" and the macro "SIZE_MAX"
+#include <unistd.h> // for write() and "STDOUT_FILENO"
+#include <sys/ioctl.h> // for ioctl(), "struct winsize", and "TIOCGWINSZ"
+#include "shared.h" // for macros and error_check()
+#include "render.h" // for "struct renderer"
+
+/* Object-Like Macros */
+#define OUTPUT_MINIMUM 4096 // bytes preallocated for a frame; the buffer doubles when full
+#define VISITS_MINIMUM 64 // positions preallocated for a batch of moves; the list doubles when full
+#define MAP_TITLE "Current map:"
+#define WINDOW_TITLE "Current map (rows %d-%d of %d, columns %d-%d of %d):"
+#define MAP_KEY "\nKey:\n"
+#define MAP_LEGEND "'*' = player | '1' = wall | 'S' = starting point | 'E' = exit"
+#define MAP_FIRST_ROW 2 // screen row of the window's top row, below the title
+#define PROMPT_ROW_OFFSET 6 // screen row of the prompt, less the window's height: title, blank, key, legend, blank
+#define RESERVED_ROWS (PROMPT_ROW_OFFSET + 1) // screen rows that are not the window: the above, and one for messages
+#define SCROLL_MARGIN 4 // the window is centred again once the player is within a quarter of it from an edge
+#define MINIMAP_ROWS 12
+#define MINIMAP_COLUMNS 24 // twice the rows, as terminal characters are about twice as tall as they are wide
+#define MINIMAP_SEPARATOR " |" // between the window and the minimap
+#define MINIMAP_EXPLORED '.'
+#define MINIMAP_UNEXPLORED ' '
+#define CLEAR_SCREEN "\033[H\033[2J" // unlike CLEAR_CONSOLE, leaves the scrollback alone
+#define CLEAR_BELOW "\033[J"
+
+/* Parameterized Macros */
+// Unexplored cells and floor both show as blanks:
+#define DISPLAYED(cell) ((cell) == FLOOR || (cell) == '\0' ? ' ' : (cell))
+#define SMALLER(a, b) ((a) < (b) ? (a) : (b))
+#define CLAMP(value, low, high) ((value) < (low) ? (low) : (value) > (high) ? (high) : (value))
+// A revealed cell shows as it is in the maze, but for the border, which shows as wall:
+#define REVEALED(maze, cell) ((maze)[cell] == BORDER ? WALL : (maze)[cell])
+#define ON_BORDER(renderer, y, x) ((y) == 0 || (y) == (renderer)->y_dimension - 1 || (x) == 0 || (x) == (renderer)->x_dimension - 1)
+
+/* Internal Function Prototypes */
+void lay_out(struct renderer *renderer);
+void terminal_size(int *rows, int *columns);
+bool off_centre(const struct renderer *renderer, int y, int x);
+char drawn_cell(const struct renderer *renderer, const struct player_map *map, int y, int x);
+void record_cell(struct renderer *renderer, const struct player_map *map, int y, int x);
+void check_around(struct renderer *renderer, const struct player_map *map, int y, int x, bool draw);
+char block_character(const struct renderer *renderer, int block_y, int block_x);
+void draw_block(struct renderer *renderer, int y, int x);
+void append(struct renderer *renderer, const char *bytes, size_t length);
+void move_cursor(struct renderer *renderer, int row, int column);
+
+/**************************************************************************************************************
+ * init_renderer():    Purpose: Prepares a renderer for a map of the given size, and sizes the minimap's      *
+ *                              blocks so that the whole map fits in it. Nothing is drawn until               *
+ *                              render_reset() and render_map().                                              *
+ *                     Parameters: struct renderer *renderer --> the renderer                                 *
+ *                                 int y_dimension --> the height of the map                                  *
+ *                                 int x_dimension --> the width of the map                                   *
+ *                     Return value: none                                                                     *
+ *                     Side effects: - modifies *renderer                                                     *
+ *                                   - terminates program if memory runs out                                  *
+ **************************************************************************************************************/
+void init_renderer(struct renderer *renderer, int y_dimension, int x_dimension)
+// Requires <stdlib.h> for malloc() and calloc(),
+//  & requires "shared.h" for error_check()
+{
+    renderer->y_dimension = y_dimension;
+    renderer->x_dimension = x_dimension;
+    renderer->drawn = calloc(CELL_WORDS((size_t) y_dimension * x_dimension), sizeof(uint64_t));
+    renderer->stars[0] = SIZE_MAX;
+    renderer->stars[1] = SIZE_MAX;
+    renderer->output = malloc(OUTPUT_MINIMUM);
+    renderer->length = 0;
+    renderer->capacity = OUTPUT_MINIMUM;
+    renderer->cursor_row = 0;
+    renderer->cursor_column = 0;
+    renderer->player_y = 0;
+    renderer->player_x = 0;
+    renderer->screen_rows = 0;
+    renderer->screen_columns = SIZE_MAX;
+    renderer->top = 0;
+    renderer->left = 0;
+    renderer->view_rows = y_dimension;
+    renderer->view_columns = x_dimension;
+    renderer->visits = malloc(VISITS_MINIMUM * 2 * sizeof(int));
+    renderer->visit_count = 0;
+    renderer->visit_capacity = VISITS_MINIMUM;
+    renderer->scrolled = false;
+    renderer->minimap = true;
+    renderer->minimap_shown = false;
+
+    // Round the blocks up, then drop any minimap rows or columns that rounding left empty:
+    renderer->block_rows = (y_dimension + MINIMAP_ROWS - 1) / MINIMAP_ROWS;
+    renderer->block_columns = (x_dimension + MINIMAP_COLUMNS - 1) / MINIMAP_COLUMNS;
+    renderer->minimap_rows = (y_dimension + renderer->block_rows - 1) / renderer->block_rows;
+    renderer->minimap_columns = (x_dimension + renderer->block_columns - 1) / renderer->block_columns;
+    renderer->explored = calloc((size_t) renderer->minimap_rows * renderer->minimap_columns, sizeof(uint32_t));
+    renderer->minimap_frame = malloc((size_t) renderer->minimap_rows * renderer->minimap_columns);
+    error_check("malloc()", 1, renderer->drawn != NULL && renderer->output != NULL && renderer->visits != NULL
+                && renderer->explored != NULL && renderer->minimap_frame != NULL, NULL);
+}
+
+
+/*******************************************************************************************************
+ * map_cell():    Purpose: Gives a cell of the player's map: the player, the cell as it is in the      *
+ *                         maze once revealed, wall for the border, and '\0' for anything else.        *
+ *                Parameters: const struct player_map *map --> the player's map                        *
+ *                            int y --> the row of the cell                                            *
+ *                            int x --> the column of the cell                                         *
+ *                Return value: char --> the cell                                                      *
+ *                Side effects: none                                                                   *
+ *******************************************************************************************************/
+char map_cell(const struct player_map *map, int y, int x)
+// Requires "shared.h" for macros,
+//  & requires "render.h" for macros
+{
+    // Variable declarations:
+    size_t cell = (size_t) y * map->x_dimension + x;
+
+    if (y == map->player_y && x == map->player_x)
+        return '*';
+    if (CELL_IN(map->revealed, cell))
+        return REVEALED(map->maze, cell);
+    return y == 0 || y == map->y_dimension - 1 || x == 0 || x == map->x_dimension - 1 ? WALL : '\0';
+}
+
+
+/********************************************************************************************************
+ * render_reset():    Purpose: Takes the whole map as already drawn, and counts its explored cells      *
+ *                             for the minimap. This is the one step that costs as much as the map      *
+ *                             is large, so it is only for the first frame and after a restart; as      *
+ *                             it copies and walks a bit per cell, even then it is quick.               *
+ *                    Parameters: struct renderer *renderer --> the renderer                            *
+ *                                const struct player_map *map --> the player's map                     *
+ *                    Return value: none                                                                *
+ *                    Side effects: modifies *renderer                                                  *
+ ********************************************************************************************************/
+void render_reset(struct renderer *renderer, const struct player_map *map)
+// Requires <string.h> for memcpy() and memset(),
+//  requires <stdint.h> for the types "uint32_t" and "uint64_t",
+//  & requires "render.h" for macros
+{
+    // Variable declarations:
+    int x_dimension = renderer->x_dimension, i, j;
+    size_t words = CELL_WORDS((size_t) renderer->y_dimension * x_dimension), cell;
+    uint32_t *explored = renderer->explored;
+
+    (void) memcpy(renderer->drawn, map->revealed, words * sizeof(uint64_t));
+    renderer->stars[0] = (size_t) map->player_y * x_dimension + map->player_x;
+    renderer->stars[1] = SIZE_MAX;
+    (void) memset(explored, 0, (size_t) renderer->minimap_rows * renderer->minimap_columns * sizeof(uint32_t));
+
+    // Only the revealed cells are visited, a word of them at a time; the border is known from the start,
+    //  so only the cells inside it count as explored:
+    for (size_t w = 0; w < words; w++)
+        for (uint64_t bits = map->revealed[w]; bits != 0; bits &= bits - 1)
+        {
+            cell = w * 64 + (size_t) __builtin_ctzll(bits);
+            i = (int) (cell / x_dimension);
+            j = (int) (cell % x_dimension);
+            if (!ON_BORDER(renderer, i, j))
+                explored[(i / renderer->block_rows) * renderer->minimap_columns + j / renderer->block_columns]++;
+        }
+}
+
+
+/*********************************************************************************************************
+ * render_map():    Purpose: Queues a whole frame: clears the screen, then draws the title, the          *
+ *                           window centred on the player (the whole map, if it fits the terminal),      *
+ *                           the minimap beside it, and the key, leaving the cursor on the prompt's      *
+ *                           row. The frame costs as much as the screen is large, whatever the map.      *
+ *                  Parameters: struct renderer *renderer --> the renderer                               *
+ *                              const struct player_map *map --> the player's map                        *
+ *                              int y --> the row of the player                                          *
+ *                              int x --> the column of the player                                       *
+ *                  Return value: none                                                                   *
+ *                  Side effects: modifies *renderer                                                     *
+ *********************************************************************************************************/
+void render_map(struct renderer *renderer, const struct player_map *map, int y, int x)
+// Requires <stdio.h> for snprintf(),
+//  requires <string.h> for strlen(),
+//  requires "shared.h" for macros,
+//  & requires check_around(), lay_out(), record_cell(), map_cell(), block_character(), and append()
+{
+    // Variable declarations:
+    char title[128], shown;
+    int bottom, right;
+    size_t cell;
+
+    // The cells around the positions visited since the last frame may lie outside the new window:
+    for (size_t v = 0; v < renderer->visit_count; v++)
+        check_around(renderer, map, renderer->visits[2 * v], renderer->visits[2 * v + 1], false);
+    renderer->visit_count = 0;
+    renderer->scrolled = false;
+
+    lay_out(renderer);
+    renderer->player_y = y;
+    renderer->player_x = x;
+    renderer->top = CLAMP(y - renderer->view_rows / 2, 0, renderer->y_dimension - renderer->view_rows);
+    renderer->left = CLAMP(x - renderer->view_columns / 2, 0, renderer->x_dimension - renderer->view_columns);
+    bottom = renderer->top + renderer->view_rows;
+    right = renderer->left + renderer->view_columns;
+
+    // Text is cut to the terminal's width, as a line that wrapped would push every row after it down:
+    append(renderer, CLEAR_SCREEN, strlen(CLEAR_SCREEN));
+    if (renderer->view_rows == renderer->y_dimension && renderer->view_columns == renderer->x_dimension)
+        (void) snprintf(title, sizeof(title), MAP_TITLE);
+    else
+        (void) snprintf(title, sizeof(title), WINDOW_TITLE, renderer->top + 1, bottom, renderer->y_dimension,
+                        renderer->left + 1, right, renderer->x_dimension);
+    append(renderer, title, SMALLER(strlen(title), renderer->screen_columns));
+    append(renderer, "\n", 1);
+    for (int i = renderer->top; i < bottom; i++)
+    {
+        for (int j = renderer->left; j < right; j++)
+        {
+            // Most cells were drawn as they are already, which takes no more than a look at their bits:
+            cell = (size_t) i * renderer->x_dimension + j;
+            if (CELL_IN(map->revealed, cell) != CELL_IN(renderer->drawn, cell) || cell == renderer->stars[0]
+                || cell == renderer->stars[1] || (i == y && j == x))
+                record_cell(renderer, map, i, j);
+            shown = DISPLAYED(map_cell(map, i, j));
+            append(renderer, &shown, 1);
+        }
+        if (renderer->minimap_shown && i - renderer->top < renderer->minimap_rows)
+        {
+            append(renderer, MINIMAP_SEPARATOR, strlen(MINIMAP_SEPARATOR));
+            for (int k = 0; k < renderer->minimap_columns; k++)
+            {
+                shown = block_character(renderer, i - renderer->top, k);
+                renderer->minimap_frame[(i - renderer->top) * renderer->minimap_columns + k] = shown;
+                append(renderer, &shown, 1);
+            }
+        }
+        append(renderer, "\n", 1);
+    }
+    append(renderer, MAP_KEY, strlen(MAP_KEY));
+    append(renderer, MAP_LEGEND, SMALLER(strlen(MAP_LEGEND), renderer->screen_columns));
+    append(renderer, "\n\n", 2);
+    renderer->cursor_row = renderer->view_rows + PROMPT_ROW_OFFSET;
+    renderer->cursor_column = 1;
+}
+
+
+/*****************************************************************************************************
+ * render_visit():    Purpose: Notes a position the player is leaving, so that the next              *
+ *                             render_move() checks the cells around it. However many moves a        *
+ *                             batch makes, they then cost one frame, with only what differs at      *
+ *                             the end.                                                              *
+ *                    Parameters: struct renderer *renderer --> the renderer                         *
+ *                                int y --> the row of the position                                  *
+ *                                int x --> the column of the position                               *
+ *                    Return value: none                                                             *
+ *                    Side effects: - modifies *renderer                                             *
+ *                                  - terminates program if memory runs out                          *
+ *****************************************************************************************************/
+void render_visit(struct renderer *renderer, int y, int x)
+// Requires <stdlib.h> for realloc(),
+//  & requires "shared.h" for error_check()
+{
+    // Variable declarations:
+    int *grown;
+
+    if (renderer->visit_count == renderer->visit_capacity)
+    {
+        grown = realloc(renderer->visits, 2 * renderer->visit_capacity * 2 * sizeof(int));
+        error_check("malloc()", 1, grown != NULL, NULL);
+        renderer->visits = grown;
+        renderer->visit_capacity *= 2;
+    }
+    renderer->visits[2 * renderer->visit_count] = y;
+    renderer->visits[2 * renderer->visit_count + 1] = x;
+    renderer->visit_count++;
+}
+
+
+/*******************************************************************************************************
+ * render_move():    Purpose: Queues what changed since the last frame: the cells of the plus          *
+ *                            shapes (a cell and its four neighbours, the most update_map() can        *
+ *                            change) around each visited position and the player's, where they        *
+ *                            differ from what is on screen, and the minimap's blocks that hold        *
+ *                            them. Once the player nears an edge of the window, or a message has      *
+ *                            scrolled the screen, the window is drawn whole instead.                  *
+ *                   Parameters: struct renderer *renderer --> the renderer                            *
+ *                               const struct player_map *map --> the player's map                     *
+ *                               int y --> the row of the player                                       *
+ *                               int x --> the column of the player                                    *
+ *                   Return value: none                                                                *
+ *                   Side effects: modifies *renderer                                                  *
+ *******************************************************************************************************/
+void render_move(struct renderer *renderer, const struct player_map *map, int y, int x)
+// Requires render_visit(), render_map(), off_centre(), and check_around()
+{
+    render_visit(renderer, y, x);
+    if (renderer->scrolled || off_centre(renderer, y, x))
+    {
+        render_map(renderer, map, y, x);
+        return;
+    }
+    renderer->player_y = y;
+    renderer->player_x = x;
+    for (size_t v = 0; v < renderer->visit_count; v++)
+        check_around(renderer, map, renderer->visits[2 * v], renderer->visits[2 * v + 1], true);
+    renderer->visit_count = 0;
+}
+
+/********************************************************************************************************
+ * render_flush():    Purpose: Ends a frame: parks the cursor on the prompt's row, clears anything      *
+ *                             left below it (old prompts and messages), adds the message for the       *
+ *                             player, and sends the whole frame to the terminal with one write().      *
+ *                    Parameters: struct renderer *renderer --> the renderer                            *
+ *                                const char *message --> lines to show above the prompt, or ""         *
+ *                    Return value: none                                                                *
+ *                    Side effects: - modifies *renderer                                                *
+ *                                  - writes to stdout                                                  *
+ ********************************************************************************************************/
+void render_flush(struct renderer *renderer, const char *message)
+// Requires <stdio.h> for fflush(),
+//  requires <string.h> for strlen(),
+//  requires <unistd.h> for write() and "STDOUT_FILENO",
+//  & requires append() and move_cursor()
+{
+    // Variable declarations:
+    size_t written = 0;
+    ssize_t result;
+    int lines = 0;
+
+    move_cursor(renderer, renderer->view_rows + PROMPT_ROW_OFFSET, 1);
+    append(renderer, CLEAR_BELOW, strlen(CLEAR_BELOW));
+    append(renderer, message, strlen(message));
+
+    // A message too tall for the rows below the window scrolls the screen, so the next frame is drawn whole:
+    for (size_t k = 0; message[k] != '\0'; k++)
+        lines += message[k] == '\n';
+    if (renderer->screen_rows != 0 && renderer->view_rows + PROMPT_ROW_OFFSET + lines > renderer->screen_rows)
+        renderer->scrolled = true;
+
+    // Anything printed through stdio must reach the terminal first:
+    (void) fflush(stdout);
+    while (written < renderer->length)
+    {
+        result = write(STDOUT_FILENO, renderer->output + written, renderer->length - written);
+        if (result <= 0)
+            break;
+        written += (size_t) result;
+    }
+    renderer->length = 0;
+
+    // The prompt and the player's typing move the cursor, so its position is unknown until the next escape:
+    renderer->cursor_row = 0;
+    renderer->cursor_column = 0;
+}
+
+
+/***********************************************************************************
+ * free_renderer():    Purpose: Releases a renderer's storage.                     *
+ *                     Parameters: struct renderer *renderer --> the renderer      *
+ *                     Return value: none                                          *
+ *                     Side effects: frees the renderer's buffers                  *
+ ***********************************************************************************/
+void free_renderer(struct renderer *renderer)
+// Requires <stdlib.h> for free()
+{
+    free(renderer->drawn);
+    free(renderer->output);
+    free(renderer->visits);
+    free(renderer->explored);
+    free(renderer->minimap_frame);
+}
+
+
+/***************************************************************************************************
+ * lay_out():    Purpose: Sizes the window to the terminal, less the rows the title, key, and      *
+ *                        prompt need, and makes room for the minimap beside it when the map       *
+ *                        does not fit. When stdout is not a terminal, the window is the map.      *
+ *               Parameters: struct renderer *renderer --> the renderer                            *
+ *               Return value: none                                                                *
+ *               Side effects: modifies *renderer                                                  *
+ ***************************************************************************************************/
+void lay_out(struct renderer *renderer)
+// Requires <string.h> for strlen(),
+//  & requires terminal_size()
+{
+    // Variable declarations:
+    int rows, columns, minimap_width = renderer->minimap_columns + (int) strlen(MINIMAP_SEPARATOR);
+
+    terminal_size(&rows, &columns);
+    renderer->screen_rows = rows;
+    renderer->screen_columns = columns == 0 ? SIZE_MAX : (size_t) columns;
+    renderer->view_rows = rows == 0 ? renderer->y_dimension : SMALLER(renderer->y_dimension, rows - RESERVED_ROWS);
+    renderer->view_columns = columns == 0 ? renderer->x_dimension : SMALLER(renderer->x_dimension, columns);
+    if (renderer->view_rows < 1)
+        renderer->view_rows = 1;
+
+    // The minimap only goes up if the window keeps at least as many columns as it takes:
+    renderer->minimap_shown = renderer->minimap && renderer->view_rows >= renderer->minimap_rows
+                              && (renderer->view_rows < renderer->y_dimension || renderer->view_columns < renderer->x_dimension)
+                              && (columns == 0 || columns - minimap_width >= minimap_width);
+    if (renderer->minimap_shown && columns != 0)
+        renderer->view_columns = SMALLER(renderer->x_dimension, columns - minimap_width);
+}
+
+
+/*************************************************************************************************************
+ * terminal_size():    Purpose: Finds the size of the terminal on stdout, or failing that, the               *
+ *                              size in the LINES and COLUMNS environment variables.                         *
+ *                     Parameters: int *rows --> where to put the number of rows, or 0 if unknown            *
+ *                                 int *columns --> where to put the number of columns, or 0 if unknown      *
+ *                     Return value: none                                                                    *
+ *                     Side effects: none                                                                    *
+ *************************************************************************************************************/
+void terminal_size(int *rows, int *columns)
+// Requires <stdlib.h> for getenv() and atoi(),
+//  requires <unistd.h> for "STDOUT_FILENO",
+//  & requires <sys/ioctl.h> for ioctl(), "struct winsize", and "TIOCGWINSZ"
+{
+    // Variable declarations:
+    struct winsize size;
+    const char *lines = getenv("LINES"), *width = getenv("COLUMNS");
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0)
+    {
+        *rows = size.ws_row;
+        *columns = size.ws_col;
+        return;
+    }
+    *rows = lines == NULL || atoi(lines) < 0 ? 0 : atoi(lines);
+    *columns = width == NULL || atoi(width) < 0 ? 0 : atoi(width);
+}
+
+
+/*********************************************************************************************************
+ * off_centre():    Purpose: Decides whether the window must move: whether the player is within          *
+ *                           a quarter of the window from an edge it can still scroll past.              *
+ *                  Parameters: const struct renderer *renderer --> the renderer                         *
+ *                              int y --> the row of the player                                          *
+ *                              int x --> the column of the player                                       *
+ *                  Return value: bool --> true if the window should be centred on the player again      *
+ *                  Side effects: none                                                                   *
+ *********************************************************************************************************/
+bool off_centre(const struct renderer *renderer, int y, int x)
+// Requires <stdbool.h> for the macro "bool"
+{
+    // Variable declarations:
+    int row_margin = renderer->view_rows / SCROLL_MARGIN, column_margin = renderer->view_columns / SCROLL_MARGIN;
+
+    return (y - renderer->top < row_margin && renderer->top > 0)
+           || (renderer->top + renderer->view_rows - 1 - y < row_margin && renderer->top + renderer->view_rows < renderer->y_dimension)
+           || (x - renderer->left < column_margin && renderer->left > 0)
+           || (renderer->left + renderer->view_columns - 1 - x < column_margin
+               && renderer->left + renderer->view_columns < renderer->x_dimension);
+}
+
+
+/*******************************************************************************************************
+ * drawn_cell():    Purpose: Gives a cell of the map as last drawn, in or out of the window, read      *
+ *                           as map_cell() reads the player's map.                                     *
+ *                  Parameters: const struct renderer *renderer --> the renderer                       *
+ *                              const struct player_map *map --> the player's map                      *
+ *                              int y --> the row of the cell                                          *
+ *                              int x --> the column of the cell                                       *
+ *                  Return value: char --> the cell                                                    *
+ *                  Side effects: none                                                                 *
+ *******************************************************************************************************/
+char drawn_cell(const struct renderer *renderer, const struct player_map *map, int y, int x)
+// Requires "shared.h" for macros,
+//  & requires "render.h" for macros
+{
+    // Variable declarations:
+    size_t cell = (size_t) y * renderer->x_dimension + x;
+
+    if (cell == renderer->stars[0] || cell == renderer->stars[1])
+        return '*';
+    if (CELL_IN(renderer->drawn, cell))
+        return REVEALED(map->maze, cell);
+    return ON_BORDER(renderer, y, x) ? WALL : '\0';
+}
+
+
+/*******************************************************************************************************
+ * record_cell():    Purpose: Takes a cell of the map as drawn, counting it for its minimap block      *
+ *                            if this is the first time it has been seen, and following the            *
+ *                            player.                                                                  *
+ *                   Parameters: struct renderer *renderer --> the renderer                            *
+ *                               const struct player_map *map --> the player's map                     *
+ *                               int y --> the row of the cell                                         *
+ *                               int x --> the column of the cell                                      *
+ *                   Return value: none                                                                *
+ *                   Side effects: modifies *renderer                                                  *
+ *******************************************************************************************************/
+void record_cell(struct renderer *renderer, const struct player_map *map, int y, int x)
+// Requires <stdint.h> for the macro "SIZE_MAX",
+//  & requires "render.h" for macros
+{
+    // Variable declarations:
+    size_t cell = (size_t) y * renderer->x_dimension + x;
+
+    if (CELL_IN(map->revealed, cell) && !CELL_IN(renderer->drawn, cell))
+    {
+        CELL_ADD(renderer->drawn, cell);
+        if (!ON_BORDER(renderer, y, x))
+            renderer->explored[(y / renderer->block_rows) * renderer->minimap_columns + x / renderer->block_columns]++;
+    }
+    // The player's last position is always visited, so it is drawn again within the frame that moves it:
+    if (y == map->player_y && x == map->player_x)
+    {
+        if (renderer->stars[0] != cell && renderer->stars[1] != cell)
+            renderer->stars[renderer->stars[0] == SIZE_MAX ? 0 : 1] = cell;
+    }
+    else
+        for (int k = 0; k < 2; k++)
+            if (renderer->stars[k] == cell)
+                renderer->stars[k] = SIZE_MAX;
+}
+
+
+/********************************************************************************************************
+ * check_around():    Purpose: Takes the cells of the plus shape around a position as drawn, and        *
+ *                             if asked, queues those in the window that look different on screen,      *
+ *                             each preceded by a cursor escape only where the cursor is not            *
+ *                             already there, with the minimap's blocks that hold them.                 *
+ *                    Parameters: struct renderer *renderer --> the renderer                            *
+ *                                const struct player_map *map --> the player's map                     *
+ *                                int y --> the row of the centre cell                                  *
+ *                                int x --> the column of the centre cell                               *
+ *                                bool draw --> whether to queue the changes, or only take them         *
+ *                    Return value: none                                                                *
+ *                    Side effects: modifies *renderer                                                  *
+ ********************************************************************************************************/
+void check_around(struct renderer *renderer, const struct player_map *map, int y, int x, bool draw)
+// Requires "shared.h" for macros,
+//  & requires map_cell(), drawn_cell(), record_cell(), draw_block(), append(), and move_cursor()
+{
+    // Variable declarations:
+    int rows[5] = {y - 1, y, y, y, y + 1}, columns[5] = {x, x - 1, x, x + 1, x}; // in screen order
+    char was, shown;
+
+    for (int k = 0; k < 5; k++)
+    {
+        if (rows[k] < 0 || rows[k] >= renderer->y_dimension || columns[k] < 0 || columns[k] >= renderer->x_dimension)
+            continue;
+        was = DISPLAYED(drawn_cell(renderer, map, rows[k], columns[k]));
+        shown = DISPLAYED(map_cell(map, rows[k], columns[k]));
+        record_cell(renderer, map, rows[k], columns[k]);
+        if (!draw)
+            continue;
+        draw_block(renderer, rows[k], columns[k]);
+        if (was == shown || rows[k] < renderer->top || rows[k] >= renderer->top + renderer->view_rows
+            || columns[k] < renderer->left || columns[k] >= renderer->left + renderer->view_columns)
+            continue;
+        move_cursor(renderer, MAP_FIRST_ROW + rows[k] - renderer->top, 1 + columns[k] - renderer->left);
+        append(renderer, &shown, 1);
+        renderer->cursor_column++;
+    }
+}
+
+
+/*************************************************************************************************************
+ * block_character():    Purpose: Chooses the minimap's character for a block.                               *
+ *                       Parameters: const struct renderer *renderer --> the renderer                        *
+ *                                   int block_y --> the row of the block                                    *
+ *                                   int block_x --> the column of the block                                 *
+ *                       Return value: char --> '*' for the player's block, else whether it is explored      *
+ *                       Side effects: none                                                                  *
+ *************************************************************************************************************/
+char block_character(const struct renderer *renderer, int block_y, int block_x)
+// Requires nothing
+{
+    if (renderer->player_y / renderer->block_rows == block_y && renderer->player_x / renderer->block_columns == block_x)
+        return '*';
+    return renderer->explored[block_y * renderer->minimap_columns + block_x] > 0 ? MINIMAP_EXPLORED : MINIMAP_UNEXPLORED;
+}
+
+
+/**************************************************************************************************
+ * draw_block():    Purpose: Queues the minimap's block holding a cell, if the minimap is on      *
+ *                           screen and the block's character has changed.                        *
+ *                  Parameters: struct renderer *renderer --> the renderer                        *
+ *                              int y --> the row of the cell                                     *
+ *                              int x --> the column of the cell                                  *
+ *                  Return value: none                                                            *
+ *                  Side effects: modifies *renderer                                              *
+ **************************************************************************************************/
+void draw_block(struct renderer *renderer, int y, int x)
+// Requires <string.h> for strlen(),
+//  & requires block_character(), append(), and move_cursor()
+{
+    // Variable declarations:
+    int block_y = y / renderer->block_rows, block_x = x / renderer->block_columns;
+    char shown;
+
+    if (!renderer->minimap_shown)
+        return;
+    shown = block_character(renderer, block_y, block_x);
+    if (renderer->minimap_frame[block_y * renderer->minimap_columns + block_x] == shown)
+        return;
+    move_cursor(renderer, MAP_FIRST_ROW + block_y,
+                1 + renderer->view_columns + (int) strlen(MINIMAP_SEPARATOR) + block_x);
+    append(renderer, &shown, 1);
+    renderer->minimap_frame[block_y * renderer->minimap_columns + block_x] = shown;
+    renderer->cursor_column++;
+}
+
+
+/*****************************************************************************************************
+ * append():    Purpose: Adds bytes to the frame being gathered, doubling the buffer when full.      *
+ *              Parameters: struct renderer *renderer --> the renderer                               *
+ *                          const char *bytes --> the bytes to add                                   *
+ *                          size_t length --> how many there are                                     *
+ *              Return value: none                                                                   *
+ *              Side effects: - modifies *renderer                                                   *
+ *                            - terminates program if memory runs out                                *
+ *****************************************************************************************************/
+void append(struct renderer *renderer, const char *bytes, size_t length)
+// Requires <stdlib.h> for realloc(),
+//  requires <string.h> for memcpy(),
+//  & requires "shared.h" for error_check()
+{
+    // Variable declarations:
+    char *grown;
+
+    while (renderer->length + length > renderer->capacity)
+    {
+        grown = realloc(renderer->output, 2 * renderer->capacity);
+        error_check("malloc()", 1, grown != NULL, NULL);
+        renderer->output = grown;
+        renderer->capacity *= 2;
+    }
+    (void) memcpy(renderer->output + renderer->length, bytes, length);
+    renderer->length += length;
+}
+
+
+/***********************************************************************************************************
+ * move_cursor():    Purpose: Queues a cursor-positioning escape, unless the cursor is already there.      *
+ *                   Parameters: struct renderer *renderer --> the renderer                                *
+ *                               int row --> the screen row, 1-based                                       *
+ *                               int column --> the screen column, 1-based                                 *
+ *                   Return value: none                                                                    *
+ *                   Side effects: modifies *renderer                                                      *
+ ***********************************************************************************************************/
+void move_cursor(struct renderer *renderer, int row, int column)
+// Requires <stdio.h> for snprintf(),
+//  & requires append()
+{
+    // Variable declarations:
+    char escape[32];
+
+    if (renderer->cursor_row == row && renderer->cursor_column == column)
+        return;
+    append(renderer, escape, (size_t) snprintf(escape, sizeof(escape), "\033[%d;%dH", row, column));
+    renderer->cursor_row = row;
+    renderer->cursor_column = column;
+}
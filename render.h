@@ -0,0 +1,72 @@
+/****************************************************************************************************
+ * Name: render.h                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for render.c                                                                *
+ ****************************************************************************************************/
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stddef.h> // for the type "size_t"
+#include <stdbool.h> // for the type "bool"
+#include <stdint.h> // for the types "uint32_t" and "uint64_t"
+
+/* Parameterized Macros */
+// Sets of cells, one bit each, row-major:
+#define CELL_WORDS(cells) (((size_t) (cells) + 63) / 64)
+#define CELL_IN(set, cell) (((set)[(cell) / 64] >> ((cell) % 64)) & 1)
+#define CELL_ADD(set, cell) ((set)[(cell) / 64] |= (uint64_t) 1 << ((cell) % 64))
+
+/* Structures */
+// The player's map: the maze as far as the player has seen it, with the player on it. The border is
+//  known from the start; any other cell is '\0' until revealed, and then shows as it is in the maze.
+//  The maze itself is only read where revealed, so a mapped maze stays on disk until explored.
+struct player_map
+{
+    const char *maze;
+    uint64_t *revealed; // CELL_WORDS(y_dimension * x_dimension) words
+    int y_dimension;
+    int x_dimension;
+    int player_y, player_x;
+};
+
+// What the terminal shows of the player's map, so that each frame sends only the cells that changed,
+//  gathered into one buffer and written with a single write(). A map larger than the terminal is shown
+//  through a window that follows the player, beside a minimap of the explored blocks.
+struct renderer
+{
+    int y_dimension;
+    int x_dimension;
+    uint64_t *drawn; // the revealed cells as last drawn, in or out of the window
+    size_t stars[2]; // the cells drawn as the player, or SIZE_MAX: where it is, and where it was until redrawn
+    char *output; // escapes and characters waiting for the next write()
+    size_t length, capacity;
+    int cursor_row, cursor_column; // where the terminal's cursor is, 1-based
+    int player_y, player_x; // where the player was last drawn
+    int *visits; // positions the player has passed through since the last frame, as row and column pairs
+    size_t visit_count, visit_capacity;
+    bool scrolled; // whether a message has scrolled the screen since the last frame
+    int screen_rows; // the terminal's height, or 0 when stdout is not a terminal (so nothing scrolls)
+    size_t screen_columns; // the terminal's width, or SIZE_MAX when stdout is not a terminal
+    int top, left; // the map cell in the window's top-left corner
+    int view_rows, view_columns; // how much of the map the window shows
+    bool minimap; // whether the player wants the minimap
+    bool minimap_shown; // whether it is on screen: only when the map does not fit, and there is room
+    int minimap_rows, minimap_columns;
+    int block_rows, block_columns; // map cells per minimap character
+    uint32_t *explored; // explored cells in each block of the minimap
+    char *minimap_frame; // the character on screen for each block
+};
+
+/* Function Prototypes */
+void init_renderer(struct renderer *renderer, int y_dimension, int x_dimension);
+char map_cell(const struct player_map *map, int y, int x);
+void render_reset(struct renderer *renderer, const struct player_map *map);
+void render_map(struct renderer *renderer, const struct player_map *map, int y, int x);
+void render_visit(struct renderer *renderer, int y, int x);
+void render_move(struct renderer *renderer, const struct player_map *map, int y, int x);
+void render_flush(struct renderer *renderer, const char *message);
+void free_renderer(struct renderer *renderer);
+
+#endif
@@ -0,0 +1,131 @@
+/****************************************************************************************************
+ * Name: rng.c                                                                                      *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements a small, fast, seedable pseudo-random number generator (xoshiro256**).       *
+ ****************************************************************************************************/
+
+#include <stdio.h> // for the type "FILE *" and fopen(), fread(), and fclose()
+#include <stdint.h> // for the type "uint64_t"
+#include <time.h> // for time() and clock()
+#include "rng.h" // for "struct rng"
+
+/* Parameterized Macros */
+#define ROTATE_LEFT(x, k) (((x) << (k)) | ((x) >> (64 - (k))))
+
+/* Internal Function Prototypes */
+uint64_t splitmix64(uint64_t *x);
+
+/*************************************************************************************************
+ * rng_seed():    Purpose: Expands a 64-bit seed into a full generator state.                    *
+ *                Parameters: struct rng *rng --> the generator to seed                          *
+ *                            uint64_t seed --> any value; equal seeds give equal sequences      *
+ *                Return value: none                                                             *
+ *                Side effects: modifies *rng                                                    *
+ *************************************************************************************************/
+void rng_seed(struct rng *rng, uint64_t seed)
+// Requires "rng.h" for "struct rng",
+//  & requires splitmix64()
+{
+    // splitmix64 never yields an all-zero state, which xoshiro cannot leave:
+    for (int k = 0; k < 4; k++)
+        rng->state[k] = splitmix64(&seed);
+}
+
+
+/***********************************************************************************
+ * rng_next():    Purpose: Advances the generator and returns 64 random bits.      *
+ *                Parameters: struct rng *rng --> the generator to advance         *
+ *                Return value: uint64_t --> the next output                       *
+ *                Side effects: modifies *rng                                      *
+ ***********************************************************************************/
+uint64_t rng_next(struct rng *rng)
+// Requires <stdint.h> for the type "uint64_t",
+//  & requires "rng.h" for "struct rng"
+{
+    uint64_t *s = rng->state;
+    uint64_t result = ROTATE_LEFT(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = ROTATE_LEFT(s[3], 45);
+
+    return result;
+}
+
+
+/******************************************************************************************************
+ * rng_below():    Purpose: Returns a uniformly distributed value in [0, bound).                      *
+ *                 Parameters: struct rng *rng --> the generator to draw from                         *
+ *                             uint64_t bound --> one past the largest value wanted (at least 1)      *
+ *                 Return value: uint64_t --> the value drawn                                         *
+ *                 Side effects: modifies *rng                                                        *
+ ******************************************************************************************************/
+uint64_t rng_below(struct rng *rng, uint64_t bound)
+// Requires <stdint.h> for the type "uint64_t",
+//  & requires rng_next()
+{
+    // Variable declarations:
+    uint64_t threshold = -bound % bound; // (2^64 - bound) % bound: the values that would bias the modulo
+    uint64_t value;
+
+    do
+        value = rng_next(rng);
+    while (value < threshold);
+
+    return value % bound;
+}
+
+
+/********************************************************************************************
+ * random_seed():    Purpose: Picks a seed for runs where the user did not supply one.      *
+ *                            Uses the system entropy source when there is one.             *
+ *                   Parameters: none                                                       *
+ *                   Return value: uint64_t --> the seed                                    *
+ *                   Side effects: reads /dev/urandom                                       *
+ ********************************************************************************************/
+uint64_t random_seed(void)
+// Requires <stdio.h> for the type "FILE *" and fopen(), fread(), and fclose(),
+//  requires <time.h> for time() and clock(),
+//  & requires splitmix64()
+{
+    // Variable declarations:
+    uint64_t seed = 0;
+    FILE *entropy;
+
+    entropy = fopen("/dev/urandom", "rb");
+    if (entropy != NULL)
+    {
+        if (fread(&seed, sizeof(seed), 1, entropy) == 1)
+        {
+            (void) fclose(entropy);
+            return seed;
+        }
+        (void) fclose(entropy);
+    }
+
+    // Fall back on the clock, mixed with a stack address (which varies between runs on most systems):
+    seed = (uint64_t) time(NULL) ^ ((uint64_t) clock() << 32) ^ (uint64_t) (uintptr_t) &seed;
+    return splitmix64(&seed);
+}
+
+
+/*****************************************************************************************************
+ * splitmix64():    Purpose: Steps a splitmix64 generator; used to spread seeds over the state.      *
+ *                  Parameters: uint64_t *x --> the splitmix64 state                                 *
+ *                  Return value: uint64_t --> the next output                                       *
+ *                  Side effects: modifies *x                                                        *
+ *****************************************************************************************************/
+uint64_t splitmix64(uint64_t *x)
+// Requires <stdint.h> for the type "uint64_t"
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
@@ -0,0 +1,26 @@
+/****************************************************************************************************
+ * Name: rng.h                                                                                      *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for rng.c                                                                   *
+ ****************************************************************************************************/
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h> // for the type "uint64_t"
+
+/* Structures */
+// State of one xoshiro256** generator. Each generation carries its own, so no two threads share one.
+struct rng
+{
+    uint64_t state[4];
+};
+
+/* Function Prototypes */
+void rng_seed(struct rng *rng, uint64_t seed);
+uint64_t rng_next(struct rng *rng);
+uint64_t rng_below(struct rng *rng, uint64_t bound);
+uint64_t random_seed(void);
+
+#endif
@@ -0,0 +1,940 @@
+/****************************************************************************************************
+ * Name: serve.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements the maze server, a long-running process that keeps a pool of ready mazes     *
+ *          for each size class, refilled by generator threads, and hands them out over a UNIX      *
+ *          domain socket; and the client that fetches one. A request for a pooled size costs a     *
+ *          copy into the socket rather than a generation. Each connection is answered on a thread  *
+ *          of its own, so neither a generation nor a slow client holds up the others.              *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for open_memstream(), sigaction(), pselect(), and MSG_NOSIGNAL under -std=c99
+#include <stdio.h> // for the type "FILE *" and printf(), snprintf(), sscanf(), fopen(), fwrite(), fclose(), and open_memstream()
+#include <stdlib.h> // for malloc(), free(), and qsort()
+#include <string.h> // for memset(), strcmp(), strcpy(), and strlen()
+#include <stdint.h> // for the type "uint64_t"
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <errno.h> // for errno and its macros
+#include <signal.h> // for the type "sig_atomic_t", sigaction(), and the signal set functions
+#include <pthread.h> // for the type "pthread_t", pthread_create(), pthread_join(), pthread_detach(), and the mutex and condition functions
+#include <unistd.h> // for close() and unlink()
+#include <fcntl.h> // for fcntl() and its macros
+#include <sys/select.h> // for pselect() and the "fd_set" macros
+#include <sys/socket.h> // for socket(), bind(), listen(), accept(), connect(), send(), recv(), and setsockopt()
+#include <sys/un.h> // for "struct sockaddr_un"
+#include <sys/stat.h> // for lstat() and S_ISSOCK()
+#include <sys/time.h> // for "struct timeval"
+#include "shared.h" // for macros, error_check(), seconds_now(), percentile(), and compare_times()
+#include "generation.h" // for init_generation(), draw_maze(), and "struct generation_context"
+#include "cache.h" // for cache_key(), cache_fetch(), cache_store(), and macros
+#include "libmaze.h" // for the status codes and maze_error_message()
+#include "stats.h" // for the STATS_ format macros
+#include "serve.h" // for "struct serve_options" and macros
+
+/* Object-Like Macros */
+// The protocol is one request per connection, each a line of text:
+//  "GET <width> <height>" --> "OK <length>" and the <length> bytes of the maze file, or "ERROR <reason>"
+//  "STATS" --> one line of JSON: requests served, their latency percentiles, and refill throughput
+#define MAX_REQUEST 64 // longest request line, with its newline
+#define MAX_REPLY 4096 // longest reply line (the statistics)
+#define LATENCY_WINDOW 65536 // the latest requests whose latencies make up the percentiles
+#define CLIENT_TIMEOUT 5 // seconds a client may stall in sending its request or taking its maze
+#define BACKLOG 64 // connections the socket queues while MAX_CLIENTS are answered
+#define FETCH_BUFFER 65536 // bytes the client receives at a time
+
+/* Parameterized Macros */
+// Appends to a reply being written, dropping whatever does not fit:
+#define APPEND(text, used, size, ...) \
+    ((used) < (size) ? (used) += (size_t) snprintf((text) + (used), (size) - (used), __VA_ARGS__) : (used))
+
+/* Structures */
+// One maze ready to send: the whole file, header and all, exactly as draw_maze() writes it.
+struct ready_maze
+{
+    char *bytes;
+    size_t length;
+};
+
+// The ready mazes of one size, in a ring of options->pool slots:
+struct size_class
+{
+    int width, height;
+    struct ready_maze *ring;
+    int first; // the oldest ready maze
+    int count; // ready mazes
+    int pending; // mazes being generated for the class
+};
+
+// State shared by the request loop, the threads answering connections, and the generator threads:
+struct server
+{
+    const struct serve_options *options;
+    struct size_class *classes; // guarded by lock
+    uint64_t next_seed; // guarded by lock
+    bool stopping; // guarded by lock
+    uint64_t refilled, refilled_cells; // generated by the threads; guarded by lock
+    double refill_seconds; // spent generating them, summed over the threads; guarded by lock
+    pthread_mutex_t lock;
+    pthread_cond_t not_full; // signalled when a pool has room, and when the server is stopping
+    int clients; // connections being answered; guarded by lock
+    pthread_cond_t client_done; // signalled when a connection has been answered
+    uint64_t served, from_pool, generated_on_request; // guarded by lock
+    double *latencies; // a ring of the latest LATENCY_WINDOW latencies, in seconds; guarded by lock
+};
+
+// One connection to answer, handed to the thread that answers it:
+struct client_request
+{
+    struct server *server;
+    int client;
+    double start; // seconds_now() when it was accepted
+};
+
+/* Global Variables */
+// Set by SIGINT or SIGTERM, which stop the server once the requests in hand are answered:
+volatile sig_atomic_t stop_requested = 0;
+
+/* Internal Function Prototypes */
+void request_stop(int signal_number);
+int open_listener(const char *socket_path);
+int connect_server(const char *socket_path);
+void *fill_pools(void *argument);
+struct size_class *emptiest_pool(struct server *server);
+int make_maze(const struct serve_options *options, int width, int height, uint64_t seed, struct ready_maze *maze);
+void accept_client(struct server *server, int client);
+void *answer_client(void *argument);
+void answer_request(struct server *server, int client, double start);
+void describe_server(struct server *server, int format, char *text, size_t size);
+bool read_line(int socket, char *line, size_t size);
+bool send_all(int socket, const char *bytes, size_t length);
+
+/***********************************************************************************************************
+ * run_server():    Purpose: Serves mazes on a UNIX domain socket until SIGINT or SIGTERM. Generator       *
+ *                           threads keep up to options->pool mazes of each size class ready; a            *
+ *                           request takes the oldest, and only a size that is not kept (up to             *
+ *                           options->max_on_demand cells), or whose pool has run dry, is generated        *
+ *                           while the client waits. Up to MAX_CLIENTS connections are answered at         *
+ *                           once, each on a thread of its own. On stopping, waits for them, then          *
+ *                           prints the requests' latency percentiles and the threads' refill              *
+ *                           throughput.                                                                   *
+ *                  Parameters: const struct serve_options *options --> what to keep ready, and where      *
+ *                  Return value: int --> 0, or 1 if the socket could not be opened                        *
+ *                  Side effects: - creates the socket, and removes it on stopping                         *
+ *                                - starts and joins options->threads threads, and starts a thread         *
+ *                                  for each connection                                                    *
+ *                                - handles SIGINT and SIGTERM                                             *
+ *                                - allocates memory for the pools, and frees it on stopping               *
+ *                                - prints to stdout                                                       *
+ *                                - terminates program if memory runs out, or a thread or lock cannot      *
+ *                                  be set up, while starting                                              *
+ ***********************************************************************************************************/
+int run_server(const struct serve_options *options)
+// Requires <stdio.h> for printf() and fflush(),
+//  requires <stdlib.h> for malloc() and free(),
+//  requires <string.h> for memset(),
+//  requires <errno.h> for errno and its macros,
+//  requires <signal.h> for sigaction() and the signal set functions,
+//  requires <pthread.h> for pthread_create(), pthread_join(), pthread_sigmask(), and the mutex and condition functions,
+//  requires <unistd.h> for close() and unlink(),
+//  requires <fcntl.h> for fcntl() and its macros,
+//  requires <sys/select.h> for pselect() and the "fd_set" macros,
+//  requires <sys/socket.h> for accept(),
+//  requires "shared.h" for error_check() and seconds_now(),
+//  requires "stats.h" for macros,
+//  requires "serve.h" for "struct serve_options",
+//  & requires request_stop(), open_listener(), fill_pools(), accept_client(), and describe_server()
+{
+    // Variable declarations:
+    struct server server;
+    struct sigaction action;
+    sigset_t signals, previous;
+    pthread_t *workers;
+    char report[MAX_REPLY];
+    fd_set waiting;
+    int listener, client, ready;
+
+    listener = open_listener(options->socket_path);
+    if (listener < 0)
+        return 1;
+
+    (void) memset(&server, 0, sizeof(server));
+    server.options = options;
+    server.next_seed = options->seed;
+    server.classes = malloc((size_t) options->size_count * sizeof(struct size_class));
+    server.latencies = malloc(LATENCY_WINDOW * sizeof(double));
+    workers = malloc((size_t) options->threads * sizeof(pthread_t));
+    error_check("malloc()", 1, server.classes != NULL && server.latencies != NULL && workers != NULL, NULL);
+    for (int k = 0; k < options->size_count; k++)
+    {
+        server.classes[k].width = options->widths[k];
+        server.classes[k].height = options->heights[k];
+        server.classes[k].ring = malloc((size_t) options->pool * sizeof(struct ready_maze));
+        error_check("malloc()", 1, server.classes[k].ring != NULL, NULL);
+        server.classes[k].first = server.classes[k].count = server.classes[k].pending = 0;
+    }
+    error_check("pthread_mutex_init()", 0, pthread_mutex_init(&server.lock, NULL), NULL);
+    error_check("pthread_cond_init()", 0, pthread_cond_init(&server.not_full, NULL), NULL);
+    error_check("pthread_cond_init()", 0, pthread_cond_init(&server.client_done, NULL), NULL);
+
+    // Stop on SIGINT or SIGTERM. They are blocked everywhere but inside pselect(), which unblocks them only
+    //  while it waits, so that one arriving just before the wait still interrupts it; the threads started
+    //  from here inherit the block:
+    (void) memset(&action, 0, sizeof(action));
+    action.sa_handler = request_stop;
+    (void) sigemptyset(&action.sa_mask);
+    (void) sigaction(SIGINT, &action, NULL);
+    (void) sigaction(SIGTERM, &action, NULL);
+    (void) sigemptyset(&signals);
+    (void) sigaddset(&signals, SIGINT);
+    (void) sigaddset(&signals, SIGTERM);
+    (void) pthread_sigmask(SIG_BLOCK, &signals, &previous);
+    for (int k = 0; k < options->threads; k++)
+        error_check("pthread_create()", 0, pthread_create(&workers[k], NULL, fill_pools, &server), NULL);
+
+    (void) printf("Serving %d size%s on %s, up to %d ready of each, refilled by %d thread%s; stop with Ctrl-C\n",
+                  options->size_count, options->size_count == 1 ? "" : "s", options->socket_path, options->pool,
+                  options->threads, options->threads == 1 ? "" : "s");
+    (void) fflush(stdout);
+    while (!stop_requested)
+    {
+        FD_ZERO(&waiting);
+        FD_SET(listener, &waiting);
+        ready = pselect(listener + 1, &waiting, NULL, NULL, NULL, &previous);
+        if (ready < 0 && errno != EINTR)
+        {
+            (void) printf("pselect() failed; stopping\n");
+            break;
+        }
+        if (ready <= 0)
+            continue;
+
+        // The listener does not block, in case the connection is gone by now; the connection itself does:
+        client = accept(listener, NULL, NULL);
+        if (client >= 0)
+        {
+            (void) fcntl(client, F_SETFL, fcntl(client, F_GETFL) & ~O_NONBLOCK);
+            accept_client(&server, client);
+        }
+        else if (errno != EINTR && errno != ECONNABORTED && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            (void) printf("accept() failed; stopping\n");
+            break;
+        }
+    }
+
+    // Let the connections be answered and the threads finish the mazes in hand, then report on the whole run:
+    (void) pthread_mutex_lock(&server.lock);
+    while (server.clients > 0)
+        (void) pthread_cond_wait(&server.client_done, &server.lock);
+    server.stopping = true;
+    (void) pthread_cond_broadcast(&server.not_full);
+    (void) pthread_mutex_unlock(&server.lock);
+    for (int k = 0; k < options->threads; k++)
+        (void) pthread_join(workers[k], NULL);
+    (void) close(listener);
+    (void) unlink(options->socket_path);
+    describe_server(&server, STATS_TEXT, report, sizeof(report));
+    (void) printf("%s", report);
+    (void) pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    for (int k = 0; k < options->size_count; k++)
+    {
+        for (int m = 0; m < server.classes[k].count; m++)
+            free(server.classes[k].ring[(server.classes[k].first + m) % options->pool].bytes);
+        free(server.classes[k].ring);
+    }
+    (void) pthread_cond_destroy(&server.not_full);
+    (void) pthread_cond_destroy(&server.client_done);
+    (void) pthread_mutex_destroy(&server.lock);
+    free(server.classes);
+    free(server.latencies);
+    free(workers);
+    return 0;
+}
+
+
+/********************************************************************************************************
+ * fetch_maze():    Purpose: Asks a server for a maze and saves it to file, as the game would have      *
+ *                           written it. Prints how long the request took.                              *
+ *                  Parameters: const char *socket_path --> where the server listens                    *
+ *                              int width --> the width of the maze (in characters)                     *
+ *                              int height --> the height of the maze (in characters)                   *
+ *                              const char *maze_filename --> the file to create or overwrite           *
+ *                  Return value: int --> 0, or 1 if the server could not be reached or refused         *
+ *                  Side effects: - creates or overwrites the file                                      *
+ *                                - prints to stdout                                                    *
+ *                                - terminates program if the file cannot be written                    *
+ ********************************************************************************************************/
+int fetch_maze(const char *socket_path, int width, int height, const char *maze_filename)
+// Requires <stdio.h> for the type "FILE *" and printf(), snprintf(), sscanf(), fopen(), fwrite(), and fclose(),
+//  requires <string.h> for strlen(),
+//  requires <unistd.h> for close(),
+//  requires <sys/socket.h> for recv(),
+//  requires "shared.h" for error_check() and seconds_now(),
+//  & requires connect_server(), read_line(), and send_all()
+{
+    // Variable declarations:
+    char line[MAX_REPLY] = {0}, buffer[FETCH_BUFFER];
+    double start = seconds_now();
+    int server = connect_server(socket_path);
+    size_t length = 0, received = 0, wanted;
+    FILE *maze_file;
+    ssize_t got = 0;
+
+    if (server < 0)
+    {
+        (void) printf("No server is listening on %s\n", socket_path);
+        return 1;
+    }
+    (void) snprintf(line, sizeof(line), "GET %d %d\n", width, height);
+    if (!send_all(server, line, strlen(line)) || !read_line(server, line, sizeof(line))
+        || sscanf(line, "OK %zu", &length) != 1)
+    {
+        (void) printf("The server did not send a maze: %s\n", line[0] != '\0' ? line : "no reply");
+        (void) close(server);
+        return 1;
+    }
+
+    maze_file = fopen(maze_filename, "wb");
+    error_check("fopen()", 1, maze_file != NULL, maze_file);
+    while (received < length)
+    {
+        wanted = length - received < sizeof(buffer) ? length - received : sizeof(buffer);
+        got = recv(server, buffer, wanted, 0);
+        if (got <= 0)
+            break;
+        error_check("fwrite()", 1, (int) fwrite(buffer, (size_t) got, 1, maze_file), maze_file);
+        received += (size_t) got;
+    }
+    (void) close(server);
+    error_check("fclose()", 0, fclose(maze_file), NULL);
+
+    if (received < length)
+    {
+        (void) printf("The server closed the connection %zu bytes early\n", length - received);
+        return 1;
+    }
+    (void) printf("Fetched %s (%zu bytes) in %.3f ms\n", maze_filename, length, (seconds_now() - start) * 1000);
+    return 0;
+}
+
+
+/*********************************************************************************************************
+ * fetch_stats():    Purpose: Asks a server for its statistics, and prints them (one line of JSON).      *
+ *                   Parameters: const char *socket_path --> where the server listens                    *
+ *                   Return value: int --> 0, or 1 if the server could not be reached                    *
+ *                   Side effects: prints to stdout                                                      *
+ *********************************************************************************************************/
+int fetch_stats(const char *socket_path)
+// Requires <stdio.h> for printf(),
+//  requires <unistd.h> for close(),
+//  & requires connect_server(), read_line(), and send_all()
+{
+    // Variable declarations:
+    char line[MAX_REPLY];
+    int server = connect_server(socket_path);
+    bool answered;
+
+    if (server < 0)
+    {
+        (void) printf("No server is listening on %s\n", socket_path);
+        return 1;
+    }
+    answered = send_all(server, "STATS\n", 6) && read_line(server, line, sizeof(line));
+    (void) close(server);
+    if (!answered)
+    {
+        (void) printf("The server did not answer\n");
+        return 1;
+    }
+    (void) printf("%s\n", line);
+    return 0;
+}
+
+
+/*******************************************************************************************************
+ * request_stop():    Purpose: Signal handler: asks the server to stop after the requests in hand.     *
+ *                    Parameters: int signal_number --> the signal (SIGINT or SIGTERM)                 *
+ *                    Return value: none                                                               *
+ *                    Side effects: sets stop_requested                                                *
+ *******************************************************************************************************/
+void request_stop(int signal_number)
+// Requires <signal.h> for the type "sig_atomic_t"
+{
+    (void) signal_number;
+    stop_requested = 1;
+}
+
+
+/*********************************************************************************************************
+ * open_listener():    Purpose: Creates the server's socket and listens on it, without blocking. A       *
+ *                              socket left behind by a server that is gone is replaced; a live          *
+ *                              server's, or any other file, is not.                                     *
+ *                     Parameters: const char *socket_path --> where to listen                           *
+ *                     Return value: int --> the listening socket, or -1 (having said why)               *
+ *                     Side effects: - creates the socket file, first removing a stale one               *
+ *                                   - prints to stdout on failure                                       *
+ *********************************************************************************************************/
+int open_listener(const char *socket_path)
+// Requires <stdio.h> for printf(),
+//  requires <string.h> for memset(), strcpy(), and strlen(),
+//  requires <unistd.h> for close() and unlink(),
+//  requires <fcntl.h> for fcntl() and its macros,
+//  requires <sys/socket.h> for socket(), bind(), and listen(),
+//  requires <sys/un.h> for "struct sockaddr_un",
+//  requires <sys/stat.h> for lstat() and S_ISSOCK(),
+//  & requires connect_server()
+{
+    // Variable declarations:
+    struct sockaddr_un address;
+    struct stat existing;
+    int listener;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        (void) printf("Socket path too long (%d characters at most)\n", (int) sizeof(address.sun_path) - 1);
+        return -1;
+    }
+    if (lstat(socket_path, &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode))
+        {
+            (void) printf("%s already exists, and is not a socket\n", socket_path);
+            return -1;
+        }
+        listener = connect_server(socket_path);
+        if (listener >= 0)
+        {
+            (void) close(listener);
+            (void) printf("A server is already listening on %s\n", socket_path);
+            return -1;
+        }
+        (void) unlink(socket_path);
+    }
+
+    (void) memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    (void) strcpy(address.sun_path, socket_path);
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0
+        || listen(listener, BACKLOG) != 0 || fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK) != 0)
+    {
+        (void) printf("Cannot listen on %s\n", socket_path);
+        if (listener >= 0)
+            (void) close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+
+/*********************************************************************************************************
+ * connect_server():    Purpose: Connects to a server's socket.                                          *
+ *                      Parameters: const char *socket_path --> where the server listens                 *
+ *                      Return value: int --> the connected socket, or -1 if no server is listening      *
+ *                      Side effects: opens a socket                                                     *
+ *********************************************************************************************************/
+int connect_server(const char *socket_path)
+// Requires <string.h> for memset(), strcpy(), and strlen(),
+//  requires <unistd.h> for close(),
+//  requires <sys/socket.h> for socket() and connect(),
+//  & requires <sys/un.h> for "struct sockaddr_un"
+{
+    // Variable declarations:
+    struct sockaddr_un address;
+    int server;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+        return -1;
+    (void) memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    (void) strcpy(address.sun_path, socket_path);
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server >= 0 && connect(server, (struct sockaddr *) &address, sizeof(address)) != 0)
+    {
+        (void) close(server);
+        server = -1;
+    }
+    return server;
+}
+
+
+/*************************************************************************************************************
+ * fill_pools():    Purpose: Generator thread: keeps generating a maze for the emptiest pool with room,      *
+ *                           until the server stops. A thread that cannot generate (for want of              *
+ *                           memory) says so and stops; requests are then generated on demand.               *
+ *                  Parameters: void *argument --> the shared "struct server"                                *
+ *                  Return value: void * --> NULL                                                            *
+ *                  Side effects: - modifies the server (under its lock)                                     *
+ *                                - allocates the mazes it adds to the pools                                 *
+ *                                - prints to stdout if it stops early                                       *
+ *************************************************************************************************************/
+void *fill_pools(void *argument)
+// Requires <stdio.h> for printf(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <pthread.h> for the mutex and condition functions,
+//  requires "shared.h" for seconds_now(),
+//  requires "libmaze.h" for the status codes and maze_error_message(),
+//  & requires emptiest_pool() and make_maze()
+{
+    // Variable declarations:
+    struct server *server = argument;
+    struct size_class *class;
+    struct ready_maze maze;
+    uint64_t seed;
+    double start, elapsed;
+    int status = MAZE_OK;
+
+    (void) pthread_mutex_lock(&server->lock);
+    for (;;)
+    {
+        while (!server->stopping && (class = emptiest_pool(server)) == NULL)
+            (void) pthread_cond_wait(&server->not_full, &server->lock);
+        if (server->stopping)
+            break;
+        class->pending++;
+        seed = server->next_seed++;
+        (void) pthread_mutex_unlock(&server->lock);
+
+        start = seconds_now();
+        status = make_maze(server->options, class->width, class->height, seed, &maze);
+        elapsed = seconds_now() - start;
+
+        (void) pthread_mutex_lock(&server->lock);
+        class->pending--;
+        if (status != MAZE_OK)
+            break;
+        class->ring[(class->first + class->count) % server->options->pool] = maze;
+        class->count++;
+        server->refilled++;
+        server->refilled_cells += (uint64_t) class->width * class->height;
+        server->refill_seconds += elapsed;
+    }
+    (void) pthread_mutex_unlock(&server->lock);
+
+    if (status != MAZE_OK)
+        (void) printf("A generator thread stopped: %s\n", maze_error_message(status));
+    return NULL;
+}
+
+
+/**********************************************************************************************************
+ * emptiest_pool():    Purpose: Picks the size class to generate for next: the one with the fewest        *
+ *                              mazes ready or in hand, if any has room for another.                      *
+ *                     Parameters: struct server *server --> the server, whose lock the caller holds      *
+ *                     Return value: struct size_class * --> the size class, or NULL if every pool        *
+ *                                                           is full                                      *
+ *                     Side effects: none                                                                 *
+ **********************************************************************************************************/
+struct size_class *emptiest_pool(struct server *server)
+// Requires "serve.h" for "struct serve_options"
+{
+    // Variable declarations:
+    struct size_class *emptiest = NULL, *class;
+
+    for (int k = 0; k < server->options->size_count; k++)
+    {
+        class = &server->classes[k];
+        if (class->count + class->pending < server->options->pool
+            && (emptiest == NULL || class->count + class->pending < emptiest->count + emptiest->pending))
+            emptiest = class;
+    }
+    return emptiest;
+}
+
+
+/**********************************************************************************************************
+ * make_maze():    Purpose: Generates a maze into memory, as the whole file draw_maze() would write;      *
+ *                          or, if the options name a cache holding it, copies it from there (a           *
+ *                          large maze generated afresh is added to the cache).                           *
+ *                 Parameters: const struct serve_options *options --> the algorithm and encoding         *
+ *                             int width --> the width of the maze (in characters)                        *
+ *                             int height --> the height of the maze (in characters)                      *
+ *                             uint64_t seed --> the seed to generate from                                *
+ *                             struct ready_maze *maze --> where to store the file's bytes; free()        *
+ *                                                         them when done                                 *
+ *                 Return value: int --> MAZE_OK, or the failure (nothing is then left to free)           *
+ *                 Side effects: - allocates memory                                                       *
+ *                               - modifies *maze                                                         *
+ *                               - may add entries to the cache and remove others                         *
+ **********************************************************************************************************/
+int make_maze(const struct serve_options *options, int width, int height, uint64_t seed, struct ready_maze *maze)
+// Requires <stdio.h> for the type "FILE *" and open_memstream() and fclose(),
+//  requires <stdlib.h> for free(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires "generation.h" for init_generation(), draw_maze(), and "struct generation_context",
+//  requires "cache.h" for cache_key(), cache_fetch(), cache_store(), and macros,
+//  & requires "libmaze.h" for the status codes
+{
+    // Variable declarations:
+    struct generation_context context;
+    FILE *stream;
+    uint64_t key = 0;
+    bool cacheable = options->cache.directory != NULL && (uint64_t) width * height >= CACHE_MINIMUM, hit = false;
+    int status = MAZE_OK;
+
+    maze->bytes = NULL;
+    maze->length = 0;
+    stream = open_memstream(&maze->bytes, &maze->length);
+    if (stream == NULL)
+        return MAZE_ERROR_MEMORY;
+
+    init_generation(&context, seed);
+    context.algorithm = options->algorithm;
+    context.threads = 1; // the server's threads already generate side by side
+    context.encoding = options->encoding;
+    if (cacheable)
+    {
+        key = cache_key(&context, height, width);
+        status = cache_fetch(&options->cache, key, stream, &hit);
+    }
+    if (status == MAZE_OK && !hit)
+        status = draw_maze(stream, height, width, &context);
+
+    // The stream's length is taken at its position, which draw_maze() leaves after the maze:
+    if (fclose(stream) != 0 && status == MAZE_OK)
+        status = MAZE_ERROR_MEMORY;
+    if (status != MAZE_OK)
+    {
+        free(maze->bytes);
+        maze->bytes = NULL;
+    }
+    else if (cacheable && !hit)
+        cache_store(&options->cache, key, maze->bytes, maze->length);
+    return status;
+}
+
+
+/**********************************************************************************************************
+ * accept_client():    Purpose: Starts a thread to answer a connection just accepted, first waiting, if       *
+ *                              MAX_CLIENTS are being answered, for one of them to finish. If no thread       *
+ *                              can be started, answers it here.                                              *
+ *                     Parameters: struct server *server --> the server                                       *
+ *                                 int client --> the connection                                              *
+ *                     Return value: none                                                                     *
+ *                     Side effects: - starts a detached thread, which closes the connection                  *
+ *                                   - modifies the server (under its lock)                                   *
+ *                                   - frees the request if it is answered here, and closes the connection    *
+ **********************************************************************************************************/
+void accept_client(struct server *server, int client)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <pthread.h> for pthread_create(), pthread_detach(), and the mutex and condition functions,
+//  requires <unistd.h> for close(),
+//  requires "shared.h" for seconds_now(),
+//  & requires answer_client() and answer_request()
+{
+    // Variable declarations:
+    struct client_request *request = malloc(sizeof(struct client_request));
+    double start = seconds_now();
+    pthread_t thread;
+    int started = -1;
+
+    (void) pthread_mutex_lock(&server->lock);
+    while (server->clients == MAX_CLIENTS)
+        (void) pthread_cond_wait(&server->client_done, &server->lock);
+    server->clients++;
+    (void) pthread_mutex_unlock(&server->lock);
+
+    if (request != NULL)
+    {
+        *request = (struct client_request) {server, client, start};
+        started = pthread_create(&thread, NULL, answer_client, request);
+    }
+    if (started == 0)
+    {
+        (void) pthread_detach(thread);
+        return;
+    }
+
+    // Without a thread of its own, the connection holds up the others while it is answered:
+    free(request);
+    answer_request(server, client, start);
+    (void) close(client);
+    (void) pthread_mutex_lock(&server->lock);
+    server->clients--;
+    (void) pthread_mutex_unlock(&server->lock);
+}
+
+
+/*********************************************************************************************************
+ * answer_client():    Purpose: Connection thread: answers one request, closes the connection, and       *
+ *                              counts it answered.                                                      *
+ *                     Parameters: void *argument --> the "struct client_request", which it frees        *
+ *                     Return value: void * --> NULL                                                     *
+ *                     Side effects: - reads from, writes to, and closes the connection                  *
+ *                                   - modifies the server (under its lock)                              *
+ *********************************************************************************************************/
+void *answer_client(void *argument)
+// Requires <stdlib.h> for free(),
+//  requires <pthread.h> for the mutex and condition functions,
+//  requires <unistd.h> for close(),
+//  & requires answer_request()
+{
+    // Variable declarations:
+    struct client_request *request = argument;
+    struct server *server = request->server;
+
+    answer_request(server, request->client, request->start);
+    (void) close(request->client);
+    free(request);
+
+    (void) pthread_mutex_lock(&server->lock);
+    server->clients--;
+    (void) pthread_cond_signal(&server->client_done);
+    (void) pthread_mutex_unlock(&server->lock);
+    return NULL;
+}
+
+
+/*********************************************************************************************************
+ * answer_request():    Purpose: Reads one request from a client and answers it. A maze of a pooled      *
+ *                               size comes from its pool when one is ready; any other is generated      *
+ *                               now, from the server's next seed, unless it is of a size not kept       *
+ *                               and larger than options->max_on_demand cells. Counts each maze          *
+ *                               sent, and how long it took from accepting the connection.               *
+ *                      Parameters: struct server *server --> the server                                 *
+ *                                  int client --> the client's connection                               *
+ *                                  double start --> seconds_now() when it was accepted                  *
+ *                      Return value: none                                                               *
+ *                      Side effects: - reads from and writes to the connection                          *
+ *                                    - modifies the server (its pools under its lock)                   *
+ *********************************************************************************************************/
+void answer_request(struct server *server, int client, double start)
+// Requires <stdio.h> for snprintf() and sscanf(),
+//  requires <stdlib.h> for free(),
+//  requires <string.h> for strcmp() and strlen(),
+//  requires <stdint.h> for the type "uint64_t",
+//  requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <pthread.h> for the mutex and condition functions,
+//  requires <sys/socket.h> for setsockopt(),
+//  requires <sys/time.h> for "struct timeval",
+//  requires "shared.h" for macros and seconds_now(),
+//  requires "libmaze.h" for the status codes and maze_error_message(),
+//  requires "stats.h" for macros,
+//  & requires make_maze(), describe_server(), read_line(), and send_all()
+{
+    // Variable declarations:
+    char request[MAX_REQUEST], reply[MAX_REPLY];
+    struct timeval timeout = {CLIENT_TIMEOUT, 0};
+    struct size_class *class = NULL;
+    struct ready_maze maze = {NULL, 0};
+    int width, height, status = MAZE_OK;
+    uint64_t seed = 0;
+    bool pooled = false;
+
+    // A client that stalls is dropped rather than left to hold up the others:
+    (void) setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    (void) setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    if (!read_line(client, request, sizeof(request)))
+        return;
+    if (strcmp(request, "STATS") == 0)
+    {
+        describe_server(server, STATS_JSON, reply, sizeof(reply));
+        (void) send_all(client, reply, strlen(reply));
+        return;
+    }
+    if (sscanf(request, "GET %d %d", &width, &height) != 2 || width < MIN_DIMENSION || width > MAX_DIMENSION
+        || height < MIN_DIMENSION || height > MAX_DIMENSION)
+    {
+        (void) snprintf(reply, sizeof(reply), "ERROR expected \"GET <width> <height>\" (%d to %d) or \"STATS\"\n",
+                        MIN_DIMENSION, MAX_DIMENSION);
+        (void) send_all(client, reply, strlen(reply));
+        return;
+    }
+
+    // A size that is not kept is only generated on request if it is small enough (the sizes are fixed at start):
+    for (int k = 0; k < server->options->size_count && class == NULL; k++)
+        if (server->classes[k].width == width && server->classes[k].height == height)
+            class = &server->classes[k];
+    if (class == NULL && (uint64_t) width * height > server->options->max_on_demand)
+    {
+        (void) snprintf(reply, sizeof(reply), "ERROR %dx%d is not kept, and only mazes of up to %llu cells are"
+                        " generated on request\n", width, height, (unsigned long long) server->options->max_on_demand);
+        (void) send_all(client, reply, strlen(reply));
+        return;
+    }
+
+    // Take the oldest ready maze of that size, if it is kept and one is ready:
+    (void) pthread_mutex_lock(&server->lock);
+    if (class != NULL && class->count > 0)
+    {
+        maze = class->ring[class->first];
+        class->first = (class->first + 1) % server->options->pool;
+        class->count--;
+        pooled = true;
+        (void) pthread_cond_signal(&server->not_full);
+    }
+    else
+        seed = server->next_seed++;
+    (void) pthread_mutex_unlock(&server->lock);
+    if (!pooled)
+        status = make_maze(server->options, width, height, seed, &maze);
+
+    if (status != MAZE_OK)
+    {
+        (void) snprintf(reply, sizeof(reply), "ERROR %s\n", maze_error_message(status));
+        (void) send_all(client, reply, strlen(reply));
+        return;
+    }
+    (void) snprintf(reply, sizeof(reply), "OK %zu\n", maze.length);
+    (void) (send_all(client, reply, strlen(reply)) && send_all(client, maze.bytes, maze.length));
+    free(maze.bytes);
+
+    (void) pthread_mutex_lock(&server->lock);
+    server->latencies[server->served % LATENCY_WINDOW] = seconds_now() - start;
+    server->served++;
+    if (pooled)
+        server->from_pool++;
+    else
+        server->generated_on_request++;
+    (void) pthread_mutex_unlock(&server->lock);
+}
+
+
+/*********************************************************************************************************
+ * describe_server():    Purpose: Writes the server's statistics: mazes served, the 50th and 99th        *
+ *                                percentile latencies of the latest LATENCY_WINDOW of them, the         *
+ *                                threads' refill throughput (per second spent generating, on            *
+ *                                one thread), and how many mazes of each size are ready.                *
+ *                       Parameters: struct server *server --> the server                                *
+ *                                   int format --> STATS_TEXT (lines) or STATS_JSON (one line)          *
+ *                                   char *text --> where to write them, ending in a newline             *
+ *                                   size_t size --> the space there (what does not fit is dropped)      *
+ *                       Return value: none                                                              *
+ *                       Side effects: - modifies the text                                               *
+ *                                     - terminates program if memory runs out                           *
+ *********************************************************************************************************/
+void describe_server(struct server *server, int format, char *text, size_t size)
+// Requires <stdio.h> for snprintf(),
+//  requires <stdlib.h> for malloc(), free(), and qsort(),
+//  requires <string.h> for memcpy(),
+//  requires <pthread.h> for the mutex functions,
+//  requires "shared.h" for error_check(), percentile(), and compare_times(),
+//  & requires "stats.h" for macros
+{
+    // Variable declarations:
+    double *sorted = malloc(LATENCY_WINDOW * sizeof(double)), p50 = 0, p99 = 0, mazes_per_s, cells_per_s;
+    size_t used = 0;
+    int count;
+
+    error_check("malloc()", 1, sorted != NULL, NULL);
+    (void) pthread_mutex_lock(&server->lock);
+    count = server->served < LATENCY_WINDOW ? (int) server->served : LATENCY_WINDOW;
+    (void) memcpy(sorted, server->latencies, (size_t) count * sizeof(double));
+    (void) pthread_mutex_unlock(&server->lock);
+    if (count > 0)
+    {
+        qsort(sorted, (size_t) count, sizeof(double), compare_times);
+        p50 = percentile(sorted, count, 0.5) * 1000;
+        p99 = percentile(sorted, count, 0.99) * 1000;
+    }
+    free(sorted);
+
+    (void) pthread_mutex_lock(&server->lock);
+    mazes_per_s = server->refill_seconds > 0 ? server->refilled / server->refill_seconds : 0;
+    cells_per_s = server->refill_seconds > 0 ? server->refilled_cells / server->refill_seconds : 0;
+    if (format == STATS_JSON)
+    {
+        APPEND(text, used, size, "{\"served\": %llu, \"from_pool\": %llu, \"generated_on_request\": %llu, "
+                                 "\"p50_ms\": %.3f, \"p99_ms\": %.3f, \"refilled\": %llu, \"refilled_cells\": %llu, "
+                                 "\"refill_seconds\": %.3f, \"refill_mazes_per_s\": %.1f, \"refill_cells_per_s\": %.0f, "
+                                 "\"ready\": [", (unsigned long long) server->served,
+               (unsigned long long) server->from_pool, (unsigned long long) server->generated_on_request, p50, p99,
+               (unsigned long long) server->refilled, (unsigned long long) server->refilled_cells,
+               server->refill_seconds, mazes_per_s, cells_per_s);
+        for (int k = 0; k < server->options->size_count; k++)
+            APPEND(text, used, size, "%s{\"width\": %d, \"height\": %d, \"count\": %d}", k > 0 ? ", " : "",
+                   server->classes[k].width, server->classes[k].height, server->classes[k].count);
+        APPEND(text, used, size, "]}\n");
+    }
+    else
+    {
+        APPEND(text, used, size, "Served %llu mazes (%llu from the pool, %llu generated on request); latency p50 "
+                                 "%.3f ms, p99 %.3f ms\n", (unsigned long long) server->served,
+               (unsigned long long) server->from_pool, (unsigned long long) server->generated_on_request, p50, p99);
+        APPEND(text, used, size, "Refilled %llu mazes (%llu cells) in %.3f s of generation: %.1f mazes/s, "
+                                 "%.0f cells/s per thread\n", (unsigned long long) server->refilled,
+               (unsigned long long) server->refilled_cells, server->refill_seconds, mazes_per_s, cells_per_s);
+        APPEND(text, used, size, "Ready:");
+        for (int k = 0; k < server->options->size_count; k++)
+            APPEND(text, used, size, " %dx%d %d/%d", server->classes[k].width, server->classes[k].height,
+                   server->classes[k].count, server->options->pool);
+        APPEND(text, used, size, "\n");
+    }
+    (void) pthread_mutex_unlock(&server->lock);
+
+    // Whatever was cut short still ends its last line:
+    if (used >= size)
+        text[size - 2] = '\n';
+}
+
+
+/*********************************************************************************************************
+ * read_line():    Purpose: Reads one line from a connection, without its newline.                       *
+ *                 Parameters: int socket --> the connection                                             *
+ *                             char *line --> where to store the line                                    *
+ *                             size_t size --> the space there, including the terminator                 *
+ *                 Return value: bool --> false if the connection closed, timed out, or sent a line      *
+ *                                        too long, before a whole line arrived                          *
+ *                 Side effects: - reads from the connection                                             *
+ *                               - modifies the line                                                     *
+ *********************************************************************************************************/
+bool read_line(int socket, char *line, size_t size)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <errno.h> for errno and its macros,
+//  & requires <sys/socket.h> for recv()
+{
+    // Variable declarations:
+    size_t length = 0;
+    ssize_t got;
+    char next;
+
+    while (length + 1 < size)
+    {
+        got = recv(socket, &next, 1, 0);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            break;
+        if (next == '\n')
+        {
+            line[length] = '\0';
+            return true;
+        }
+        line[length++] = next;
+    }
+    line[length] = '\0';
+    return false;
+}
+
+
+/****************************************************************************************************
+ * send_all():    Purpose: Sends every byte given on a connection. A client that has gone away      *
+ *                         fails the send rather than raising SIGPIPE.                              *
+ *                Parameters: int socket --> the connection                                         *
+ *                            const char *bytes --> what to send                                    *
+ *                            size_t length --> how many bytes                                      *
+ *                Return value: bool --> true if all were sent                                      *
+ *                Side effects: writes to the connection                                            *
+ ****************************************************************************************************/
+bool send_all(int socket, const char *bytes, size_t length)
+// Requires <stdbool.h> for the macros "bool", "false", and "true",
+//  requires <errno.h> for errno and its macros,
+//  & requires <sys/socket.h> for send() and the macro "MSG_NOSIGNAL"
+{
+    // Variable declarations:
+    size_t sent = 0;
+    ssize_t got;
+
+    while (sent < length)
+    {
+        got = send(socket, bytes + sent, length - sent, MSG_NOSIGNAL);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return false;
+        sent += (size_t) got;
+    }
+    return true;
+}
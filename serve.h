@@ -0,0 +1,45 @@
+/****************************************************************************************************
+ * Name: serve.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for serve.c                                                                 *
+ ****************************************************************************************************/
+
+#ifndef SERVE_H
+#define SERVE_H
+
+#include <stdint.h> // for the type "uint64_t"
+#include "cache.h" // for "struct maze_cache"
+
+/* Object-Like Macros */
+#define MAX_SIZE_CLASSES 32 // most sizes one server keeps mazes ready for
+#define MAX_POOL 1024 // most ready mazes kept for one size
+#define DEFAULT_POOL 4
+#define DEFAULT_ON_DEMAND 1000000 // most cells in a maze of a size not kept that is generated on request
+#define MAX_CLIENTS 64 // connections answered at once; more wait in the socket's queue
+
+/* Structures */
+// What a server keeps ready: up to pool mazes of each size class, which its generator threads refill
+// as requests drain them. Mazes are generated from seed, seed + 1, and so on, in the order the threads
+// start them.
+struct serve_options
+{
+    const char *socket_path;
+    int size_count;
+    int widths[MAX_SIZE_CLASSES];
+    int heights[MAX_SIZE_CLASSES];
+    int pool;
+    int threads;
+    int algorithm; // one of the ALGORITHM_ macros (see generation.h)
+    int encoding; // one of the ENCODING_ macros (see maze_file.h)
+    uint64_t seed;
+    uint64_t max_on_demand; // most cells in a maze of a size not kept; larger ones are refused
+    struct maze_cache cache; // where mazes already generated are copied from, and new ones kept
+};
+
+/* Function Prototypes */
+int run_server(const struct serve_options *options);
+int fetch_maze(const char *socket_path, int width, int height, const char *maze_filename);
+int fetch_stats(const char *socket_path);
+
+#endif
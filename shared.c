@@ -2,27 +2,34 @@
  * Name: shared.c                                                                                   *
  * Date created: 2021-12-19                                                                         *
  * Author: Ryan Wells                                                                               *
- * Purpose: Implements the error_check() function. Header file contains shared macros.              *
+ * Purpose: Implements the error_check(), status_check(), seconds_now(), and percentile()           *
+ *          functions. Header file contains shared macros.                                          *
  ****************************************************************************************************/
 
+#define _POSIX_C_SOURCE 200809L // for clock_gettime() under -std=c99
 #include <stdio.h> // for the type "FILE *"
-#include <string.h> // for strcmp()
+#include <string.h> // for strcmp(), strncmp(), and strerror()
 #include <stdlib.h> // for exit()
+#include <time.h> // for clock_gettime()
+#include "libmaze.h" // for the status codes and maze_error_message()
 #define CLEAR_CONSOLE (void) printf("\033[H\033[2J\033[3J"); // ANSI escapes for clearing screen and scrollback.
 
 /********************************************************************************************************
- * error_check():    Purpose: Checks for errors returned by scanf(), fwrite(), fread(), or fseek()      *
+ * error_check():    Purpose: Checks for errors returned by scanf(), fwrite(), fread(), fseek(),        *
+ *                            malloc(), read_header(), fopen(), fclose(), or any pthread_ function      *
+ *                            (which returns 0, or the error number)                                    *
  *                   Parameters: char *function_name --> a string containing a function name            *
  *                               int check_against --> the desired return value                         *
  *                               int return_value --> the actual return value                           *
- *                               FILE *maze_file --> the currently open file to close before exiting    *
+ *                               FILE *maze_file --> the currently open file to close before exiting,   *
+ *                                                   or NULL if there is none                           *
  *                   Return value: none                                                                 *
- *                   Side effects: - closes maze_file                                                   *
+ *                   Side effects: - closes maze_file (if not NULL)                                     *
  *                                 - prints to stdout                                                   *
  *                                 - terminates program                                                 *
  ********************************************************************************************************/
 void error_check(char *function_name, int check_against, int return_value, FILE *maze_file)
-// Requires <string.h> for strcmp(),
+// Requires <string.h> for strcmp(), strncmp(), and strerror(),
 //  requires <stdio.h> for printf() and fclose()
 //  & requires <stdlib.h> for exit()
 {
@@ -33,7 +40,8 @@ void error_check(char *function_name, int check_against, int return_value, FILE
             CLEAR_CONSOLE;
             (void) printf("Error 1: Could not read input from stdin.\n");
             (void) printf("scanf() returned %d, but should have returned %d\n", return_value, check_against);
-            (void) fclose(maze_file);
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
             exit(1);
         }
 
@@ -42,7 +50,8 @@ void error_check(char *function_name, int check_against, int return_value, FILE
             CLEAR_CONSOLE;
             (void) printf("Error 2: Write-to-file error.\n");
             (void) printf("fwrite() returned %d, but should have returned %d\n", return_value, check_against);
-            (void) fclose(maze_file);
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
             exit(2);
         }
 
@@ -51,7 +60,8 @@ void error_check(char *function_name, int check_against, int return_value, FILE
             CLEAR_CONSOLE;
             (void) printf("Error 3: Read-from-file error.\n");
             (void) printf("fread() returned %d, but should have returned %d\n", return_value, check_against);
-            (void) fclose(maze_file);
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
             exit(3);
         }
 
@@ -60,10 +70,159 @@ void error_check(char *function_name, int check_against, int return_value, FILE
             CLEAR_CONSOLE;
             (void) printf("Error 4: File-position error.\n");
             (void) printf("fseek() returned %d, but should have returned %d\n", return_value, check_against);
-            (void) fclose(maze_file);
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
             exit(4);
         }
+
+        if (strcmp(function_name, "malloc()") == 0)
+        {
+            CLEAR_CONSOLE;
+            (void) printf("Error 5: Out of memory.\n");
+            (void) printf("Could not allocate storage for the maze.\n");
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
+            exit(5);
+        }
+
+        if (strcmp(function_name, "read_header()") == 0)
+        {
+            CLEAR_CONSOLE;
+            (void) printf("Error 6: Invalid maze file.\n");
+            (void) printf("The file header is not a recognized maze header.\n");
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
+            exit(6);
+        }
+
+        if (strcmp(function_name, "fopen()") == 0)
+        {
+            CLEAR_CONSOLE;
+            (void) printf("Error 7: Could not open file.\n");
+            (void) printf("A maze file could not be created.\n");
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
+            exit(7);
+        }
+
+        if (strcmp(function_name, "fclose()") == 0)
+        {
+            CLEAR_CONSOLE;
+            (void) printf("Error 8: Write-to-file error.\n");
+            (void) printf("fclose() returned %d, but should have returned %d\n", return_value, check_against);
+            exit(8);
+        }
+
+        if (strncmp(function_name, "pthread_", 8) == 0)
+        {
+            CLEAR_CONSOLE;
+            (void) printf("Error 10: Could not start a thread or set up its lock.\n");
+            (void) printf("%s returned %d (%s), but should have returned %d\n", function_name, return_value,
+                          strerror(return_value), check_against);
+            if (maze_file != NULL)
+                (void) fclose(maze_file);
+            exit(10);
+        }
     }
 
     return;
-}
\ No newline at end of file
+}
+
+
+/************************************************************************************************************
+ * status_check():    Purpose: Checks a status code returned by the maze library (see libmaze.h),           *
+ *                             reporting a failure as error_check() reports the call that failed.           *
+ *                    Parameters: int status --> the status code                                            *
+ *                                FILE *maze_file --> the currently open file to close before exiting,      *
+ *                                                    or NULL if there is none                              *
+ *                    Return value: none                                                                    *
+ *                    Side effects: - closes maze_file (if not NULL)                                        *
+ *                                  - prints to stdout                                                      *
+ *                                  - terminates program                                                    *
+ ************************************************************************************************************/
+void status_check(int status, FILE *maze_file)
+// Requires <stdio.h> for printf() and fclose(),
+//  requires <stdlib.h> for exit(),
+//  requires "libmaze.h" for the status codes and maze_error_message(),
+//  & requires error_check()
+{
+    switch (status)
+    {
+        case MAZE_OK:
+            return;
+        case MAZE_ERROR_WRITE:
+            error_check("fwrite()", 1, 0, maze_file);
+            break;
+        case MAZE_ERROR_READ:
+            error_check("fread()", 1, 0, maze_file);
+            break;
+        case MAZE_ERROR_SEEK:
+            error_check("fseek()", 0, -1, maze_file);
+            break;
+        case MAZE_ERROR_MEMORY:
+            error_check("malloc()", 1, 0, maze_file);
+            break;
+        case MAZE_ERROR_FORMAT:
+            error_check("read_header()", 1, 0, maze_file);
+            break;
+    }
+
+    // Anything else is a call this program should never have made:
+    CLEAR_CONSOLE;
+    (void) printf("Error 9: %s.\n", maze_error_message(status));
+    if (maze_file != NULL)
+        (void) fclose(maze_file);
+    exit(9);
+}
+
+
+/******************************************************************************************
+ * seconds_now():    Purpose: Reads a monotonic clock, for timing.                        *
+ *                   Parameters: none                                                     *
+ *                   Return value: double --> seconds since an arbitrary fixed point      *
+ *                   Side effects: none                                                   *
+ ******************************************************************************************/
+double seconds_now(void)
+// Requires <time.h> for clock_gettime() and "struct timespec"
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/*****************************************************************************************************************
+ * percentile():    Purpose: Finds a percentile of sorted timings: the median is the mean of the middle two      *
+ *                           of an even count, and any other percentile is the nearest rank.                     *
+ *                  Parameters: const double *sorted --> the timings, in ascending order                         *
+ *                              int count --> how many there are (at least 1)                                    *
+ *                              double fraction --> the percentile, as a fraction (0.5 for the median)           *
+ *                  Return value: double --> the timing at that percentile                                       *
+ *                  Side effects: none                                                                           *
+ *****************************************************************************************************************/
+double percentile(const double *sorted, int count, double fraction)
+{
+    // Variable declarations:
+    int rank = (int) (fraction * count + 0.999999); // rounded up, counting from 1
+
+    if (fraction == 0.5 && count % 2 == 0)
+        return (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    return sorted[rank < 1 ? 0 : rank - 1];
+}
+
+
+/***************************************************************************************************************
+ * compare_times():    Purpose: Orders two timings for qsort(), ascending.                                     *
+ *                     Parameters: const void *a, const void *b --> pointers to the two timings (double)       *
+ *                     Return value: int --> negative, zero, or positive as *a is less than, equal to, or      *
+ *                                           greater than *b                                                   *
+ *                     Side effects: none                                                                      *
+ ***************************************************************************************************************/
+int compare_times(const void *a, const void *b)
+{
+    // Variable declarations:
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
@@ -6,18 +6,24 @@
  ****************************************************************************************************/
 
 #include <stdio.h> // for the type "FILE *"
+#include <stddef.h> // for the type "size_t"
 
-#define HEADER_SIZE 4
+#define MIN_DIMENSION 10
+#define MAX_DIMENSION 100000 // grids are heap-allocated, so this is bounded by memory rather than the stack
 #define BORDER 'B'
 #define WALL '1'
 #define FLOOR '0'
 #define START 'S'
 #define END 'E'
-#define MAZE_OF_I_OF_J *(maze + ((i * x_dimension) + j))
+#define MAZE_OF_I_OF_J *(maze + (((size_t) i * x_dimension) + j))
 #define UP (*(&MAZE_OF_I_OF_J - x_dimension))
 #define DOWN (*(&MAZE_OF_I_OF_J + x_dimension))
 #define LEFT (*(&MAZE_OF_I_OF_J - 1))
 #define RIGHT (*(&MAZE_OF_I_OF_J + 1))
 #define CLEAR_CONSOLE (void) printf("\033[H\033[2J\033[3J"); // ANSI escapes for clearing screen and scrollback.
 
-void error_check(char *function_name, int check_against, int return_value, FILE *maze_file);
\ No newline at end of file
+void error_check(char *function_name, int check_against, int return_value, FILE *maze_file);
+void status_check(int status, FILE *maze_file);
+double seconds_now(void);
+double percentile(const double *sorted, int count, double fraction);
+int compare_times(const void *a, const void *b);
\ No newline at end of file
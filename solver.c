@@ -0,0 +1,1081 @@
+/****************************************************************************************************
+ * Name: solver.c                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements shortest-path search (breadth-first, A*, bidirectional) and distance fields.*
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for fileno() and "st_mtim" under -std=c99
+#include <stdio.h> // for the type "FILE *" and fopen(), fclose(), fread(), fwrite(), fgetc(), and fileno()
+#include <stdlib.h> // for malloc(), calloc(), realloc(), and free()
+#include <stdbool.h> // for the macros "bool", "false", and "true"
+#include <stdint.h> // for the types "uint8_t", "uint32_t", and "uint64_t" and their "_MAX" macros
+#include <string.h> // for memcmp(), memcpy(), memset(), strcat(), strcpy(), and strlen()
+#include <sys/stat.h> // for fstat() and "struct stat"
+#include "shared.h" // for macros and error_check()
+#include "maze_file.h" // for "struct maze_header" and put_/get_ functions
+#include "solver.h" // for "struct solution", "struct distance_field", and macros
+
+/* Object-Like Macros */
+#define FRONTIER_MINIMUM 4096 // entries preallocated for the queue or heap; it doubles when full
+#define CACHE_MAGIC "MDST"
+#define CACHE_MAGIC_SIZE 4
+#define CACHE_VERSION 1
+#define CACHE_HEADER_SIZE 48
+#define DIRECTIONS 4 // up, down, left, right: a direction's opposite is itself XOR 1
+#define NO_SET UINT32_MAX // a run of open cells not yet joined to a set
+#define SLOT_FREED UINT64_MAX // a junction table slot whose junction has been expanded
+#define SLOT_HASH 0x9E3779B97F4A7C15ULL // 2^64 over the golden ratio, odd
+
+/* Parameterized Macros */
+#define PASSABLE(cell) ((cell) == FLOOR || (cell) == START || (cell) == END)
+#define VISITED(visited, cell) (((visited)[(cell) / 64] >> ((cell) % 64)) & 1)
+#define VISIT(visited, cell) ((visited)[(cell) / 64] |= (uint64_t) 1 << ((cell) % 64))
+#define DISTANCE(a, b) ((a) > (b) ? (a) - (b) : (b) - (a))
+#define FIELD_BYTES(cells) ((size_t) ((cells) + 3) / 4)
+#define FIELD_GET(field, cell) (((field)->steps[(cell) / 4] >> ((cell) % 4 * 2)) & 3)
+#define FIELD_SET(field, cell, residue) ((field)->steps[(cell) / 4] |= (uint8_t) ((residue) << ((cell) % 4 * 2)))
+// The directions open from a cell off the edge of the grid, a bit each:
+#define EXITS(maze, cell, x) ((unsigned) PASSABLE((maze)[(cell) - (x)])           \
+                             | (unsigned) PASSABLE((maze)[(cell) + (x)]) << 1    \
+                             | (unsigned) PASSABLE((maze)[(cell) - 1]) << 2      \
+                             | (unsigned) PASSABLE((maze)[(cell) + 1]) << 3)
+#define SLOT(cell, slots) ((size_t) (((cell) * SLOT_HASH) >> 32) & ((slots) - 1))
+
+/* Structures */
+// Breadth-first frontier: a ring of cells that doubles when full.
+struct cell_queue
+{
+    uint64_t *cells;
+    size_t capacity, head, count; // capacity is a power of 2
+};
+
+// A* frontier entry: estimated total length, length so far, and the cell.
+struct frontier_entry
+{
+    uint64_t estimate;
+    uint64_t length;
+    uint64_t cell;
+};
+
+// Corridor search frontier entry: a junction, its distance from its side's end, and the direction it was
+//  entered by (DIRECTIONS for the end itself).
+struct junction
+{
+    uint64_t cell;
+    uint64_t distance;
+    int from;
+};
+
+// Corridor search frontier: a ring of junctions that doubles when full, indexed by cell in an open-addressed
+//  table so that the other side can tell when it arrives at one.
+struct junction_queue
+{
+    struct junction *entries;
+    size_t capacity, head, count; // capacity is a power of 2
+    uint64_t *keys; // per slot: 0 if never used, SLOT_FREED once expanded, and otherwise the cell + 1
+    uint64_t *distances;
+    size_t slots, used; // slots is a power of 2, used counts freed slots as well
+};
+
+/* Internal Function Prototypes */
+void solve_bfs(const char *maze, const struct maze_header *header, uint64_t *visited, struct solution *solution);
+void solve_astar(const char *maze, const struct maze_header *header, uint64_t *visited, struct solution *solution);
+void solve_bidirectional(const char *maze, const struct maze_header *header, struct solution *solution);
+bool loop_free(const char *maze, const struct maze_header *header, uint64_t *open_cells);
+void open_row(const char *row, uint64_t x_dimension, uint64_t *open);
+uint32_t find_run_set(uint32_t *sets, uint32_t set);
+unsigned end_exits(const char *maze, const struct maze_header *header, uint64_t cell);
+void enqueue(struct cell_queue *queue, uint64_t cell);
+uint64_t dequeue(struct cell_queue *queue);
+void push_junction(struct junction_queue *queue, struct junction junction);
+struct junction pop_junction(struct junction_queue *queue);
+bool pending_junction(const struct junction_queue *queue, uint64_t cell, uint64_t *distance);
+void index_junctions(struct junction_queue *queue, size_t slots);
+bool load_distance_field(const char *cache_filename, FILE *maze_file, const struct maze_header *header,
+                         struct distance_field *field);
+void save_distance_field(const char *cache_filename, FILE *maze_file, const struct maze_header *header,
+                         const struct distance_field *field);
+void fingerprint_maze(FILE *maze_file, const struct maze_header *header, const struct distance_field *field,
+                      uint8_t *bytes);
+int neighbours(const char *maze, const struct maze_header *header, uint64_t cell, uint64_t *next);
+uint64_t heuristic(const struct maze_header *header, uint64_t cell);
+bool entry_before(const struct frontier_entry *a, const struct frontier_entry *b);
+
+/**********************************************************************************************************
+ * solve_maze():    Purpose: Finds a shortest path from the Start to the End of a maze, keeping one       *
+ *                           visited bit per cell and a flat frontier that only grows when full. The      *
+ *                           search from both ends keeps no visited bits at all, and so is only made      *
+ *                           in a maze with no loops: it searches any other breadth-first.                *
+ *                  Parameters: const char *maze --> the row-major grid, BORDER round the edge            *
+ *                              const struct maze_header *header --> its dimensions, Start, and End       *
+ *                              int method --> SOLVER_BFS, SOLVER_ASTAR, or SOLVER_BIDIRECTIONAL          *
+ *                              struct solution *solution --> where to store the result                   *
+ *                  Return value: none                                                                    *
+ *                  Side effects: - modifies *solution                                                    *
+ *                                - terminates program if memory runs out                                 *
+ **********************************************************************************************************/
+void solve_maze(const char *maze, const struct maze_header *header, int method, struct solution *solution)
+// Requires <stdlib.h> for calloc() and free(),
+//  requires "shared.h" for macros and error_check(),
+//  & requires solve_bfs(), solve_astar(), solve_bidirectional(), and loop_free()
+{
+    // Variable declarations:
+    uint64_t cells = (uint64_t) header->y_dimension * header->x_dimension;
+    uint64_t *visited;
+
+    solution->solved = false;
+    solution->path_length = 0;
+    solution->expanded = 0;
+    solution->open_cells = 0;
+    solution->method = method;
+
+    if (method == SOLVER_BIDIRECTIONAL)
+    {
+        // The check for loops counts the open cells as it goes:
+        if (loop_free(maze, header, &solution->open_cells))
+        {
+            solve_bidirectional(maze, header, solution);
+            return;
+        }
+        solution->method = SOLVER_BFS;
+    }
+    else
+        for (uint64_t cell = 0; cell < cells; cell++)
+            solution->open_cells += PASSABLE(maze[cell]);
+
+    visited = calloc((size_t) (cells / 64 + 1), sizeof(uint64_t));
+    error_check("malloc()", 1, visited != NULL, NULL);
+    if (solution->method == SOLVER_ASTAR)
+        solve_astar(maze, header, visited, solution);
+    else
+        solve_bfs(maze, header, visited, solution);
+
+    free(visited);
+    return;
+}
+
+
+/********************************************************************************************************
+ * open_distance_field():    Purpose: Makes a maze's distance field ready for hints: loads it from      *
+ *                                    the cache beside the maze file if one matches, and otherwise      *
+ *                                    builds it, caching it for next time if the maze is large. With    *
+ *                                    no filename, it is built and no cache is read or written.         *
+ *                           Parameters: const char *maze --> the grid                                  *
+ *                                       const struct maze_header *header --> its header                *
+ *                                       FILE *maze_file --> the file the maze was read from            *
+ *                                       const char *maze_filename --> that file's name, or NULL        *
+ *                                       struct distance_field *field --> where to store the field      *
+ *                           Return value: none                                                         *
+ *                           Side effects: - modifies *field                                            *
+ *                                         - may create or overwrite the cache file                     *
+ *                                         - terminates program if memory runs out                      *
+ ********************************************************************************************************/
+void open_distance_field(const char *maze, const struct maze_header *header, FILE *maze_file,
+                         const char *maze_filename, struct distance_field *field)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires <string.h> for strcat(), strcpy(), and strlen(),
+//  requires "shared.h" for error_check(),
+//  & requires build_distance_field(), load_distance_field(), and save_distance_field()
+{
+    // Variable declarations:
+    uint64_t cells = (uint64_t) header->y_dimension * header->x_dimension;
+    char *cache_filename;
+
+    if (maze_filename == NULL || cells < DISTANCE_CACHE_MINIMUM)
+    {
+        build_distance_field(maze, header, field);
+        return;
+    }
+
+    cache_filename = malloc(strlen(maze_filename) + sizeof(DISTANCE_CACHE_SUFFIX));
+    error_check("malloc()", 1, cache_filename != NULL, NULL);
+    (void) strcat(strcpy(cache_filename, maze_filename), DISTANCE_CACHE_SUFFIX);
+    if (!load_distance_field(cache_filename, maze_file, header, field))
+    {
+        build_distance_field(maze, header, field);
+        save_distance_field(cache_filename, maze_file, header, field);
+    }
+    free(cache_filename);
+}
+
+
+/*********************************************************************************************************
+ * build_distance_field():    Purpose: Computes every cell's distance to the End with one                *
+ *                                     breadth-first search from the End, a layer at a time.             *
+ *                                     Cells the search never reaches keep residue 0; no walk            *
+ *                                     from the Start can reach them either.                             *
+ *                            Parameters: const char *maze --> the grid                                  *
+ *                                        const struct maze_header *header --> its header                *
+ *                                        struct distance_field *field --> where to store the field      *
+ *                            Return value: none                                                         *
+ *                            Side effects: - modifies *field                                            *
+ *                                          - terminates program if memory runs out                      *
+ *********************************************************************************************************/
+void build_distance_field(const char *maze, const struct maze_header *header, struct distance_field *field)
+// Requires <stdlib.h> for malloc(), calloc(), and free(),
+//  requires "shared.h" for error_check(),
+//  & requires neighbours(), enqueue(), and dequeue()
+{
+    // Variable declarations:
+    uint64_t cells = (uint64_t) header->y_dimension * header->x_dimension;
+    uint64_t start = (uint64_t) header->start_y * header->x_dimension + header->start_x;
+    uint64_t end = (uint64_t) header->end_y * header->x_dimension + header->end_x;
+    uint64_t *visited = calloc((size_t) (cells / 64 + 1), sizeof(uint64_t)), cell, next[4];
+    struct cell_queue queue = {malloc(FRONTIER_MINIMUM * sizeof(uint64_t)), FRONTIER_MINIMUM, 0, 0};
+    size_t layer;
+    int found;
+
+    *field = (struct distance_field) {calloc(FIELD_BYTES(cells), 1), header->x_dimension, cells, false, 0};
+    error_check("malloc()", 1, visited != NULL && queue.cells != NULL && field->steps != NULL, NULL);
+    VISIT(visited, end);
+    enqueue(&queue, end);
+
+    for (uint64_t depth = 0; queue.count > 0; depth++)
+        for (layer = queue.count; layer > 0; layer--)
+        {
+            cell = dequeue(&queue);
+            FIELD_SET(field, cell, depth % 4);
+            if (cell == start)
+            {
+                field->reachable = true;
+                field->start_distance = depth;
+            }
+
+            found = neighbours(maze, header, cell, next);
+            for (int k = 0; k < found; k++)
+                if (!VISITED(visited, next[k]))
+                {
+                    VISIT(visited, next[k]);
+                    enqueue(&queue, next[k]);
+                }
+        }
+
+    free(visited);
+    free(queue.cells);
+}
+
+
+/*************************************************************************************************************
+ * next_step():    Purpose: Finds the neighbour of a cell that lies one step nearer the End, by              *
+ *                          looking at no more than its four neighbours.                                     *
+ *                 Parameters: const char *maze --> the grid                                                 *
+ *                             const struct distance_field *field --> the maze's distance field              *
+ *                             uint64_t cell --> the cell, which must be able to reach the End               *
+ *                             uint64_t distance --> the cell's distance to the End (at least 1)             *
+ *                 Return value: uint64_t --> the neighbouring cell (the cell itself if none is nearer)      *
+ *                 Side effects: none                                                                        *
+ *************************************************************************************************************/
+uint64_t next_step(const char *maze, const struct distance_field *field, uint64_t cell, uint64_t distance)
+// Requires "shared.h" for macros
+{
+    // Variable declarations:
+    uint64_t x_dimension = field->x_dimension, j = cell % x_dimension;
+    uint64_t candidates[4] = {cell - x_dimension, cell + x_dimension, cell - 1, cell + 1};
+    bool inside[4] = {cell >= x_dimension, cell + x_dimension < field->cells, j > 0, j + 1 < x_dimension};
+
+    // Every open neighbour is one step nearer or further, so the residue picks out a nearer one:
+    for (int k = 0; k < 4; k++)
+        if (inside[k] && PASSABLE(maze[candidates[k]]) && FIELD_GET(field, candidates[k]) == (distance - 1) % 4)
+            return candidates[k];
+    return cell;
+}
+
+
+/*********************************************************************************************************
+ * step_distance():    Purpose: Gives the distance to the End of a cell neighbouring one whose           *
+ *                              distance is known, in constant time.                                     *
+ *                     Parameters: const struct distance_field *field --> the maze's distance field      *
+ *                                 uint64_t distance --> the known cell's distance to the End            *
+ *                                 uint64_t cell --> an open neighbour of the known cell                 *
+ *                     Return value: uint64_t --> the neighbour's distance to the End                    *
+ *                     Side effects: none                                                                *
+ *********************************************************************************************************/
+uint64_t step_distance(const struct distance_field *field, uint64_t distance, uint64_t cell)
+{
+    return FIELD_GET(field, cell) == (distance - 1) % 4 ? distance - 1 : distance + 1;
+}
+
+
+/*****************************************************************************************
+ * free_distance_field():    Purpose: Releases a distance field's storage.               *
+ *                           Parameters: struct distance_field *field --> the field      *
+ *                           Return value: none                                          *
+ *                           Side effects: frees field->steps                            *
+ *****************************************************************************************/
+void free_distance_field(struct distance_field *field)
+// Requires <stdlib.h> for free()
+{
+    free(field->steps);
+    field->steps = NULL;
+}
+
+
+/******************************************************************************************************
+ * solve_bfs():    Purpose: Breadth-first search, a layer at a time, so that the distance is the      *
+ *                          number of layers and no per-cell distance is stored. The queue is a       *
+ *                          ring buffer of cell indices.                                              *
+ *                 Parameters: const char *maze --> the grid                                          *
+ *                             const struct maze_header *header --> its header                        *
+ *                             uint64_t *visited --> a cleared bit per cell                           *
+ *                             struct solution *solution --> where to store the result                *
+ *                 Return value: none                                                                 *
+ *                 Side effects: - modifies *visited and *solution                                    *
+ *                               - terminates program if memory runs out                              *
+ ******************************************************************************************************/
+void solve_bfs(const char *maze, const struct maze_header *header, uint64_t *visited, struct solution *solution)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires "shared.h" for error_check(),
+//  & requires neighbours(), enqueue(), and dequeue()
+{
+    // Variable declarations:
+    uint64_t start = (uint64_t) header->start_y * header->x_dimension + header->start_x;
+    uint64_t end = (uint64_t) header->end_y * header->x_dimension + header->end_x;
+    struct cell_queue queue = {malloc(FRONTIER_MINIMUM * sizeof(uint64_t)), FRONTIER_MINIMUM, 0, 0};
+    uint64_t cell, next[4];
+    size_t layer;
+    int found;
+
+    error_check("malloc()", 1, queue.cells != NULL, NULL);
+    VISIT(visited, start);
+    enqueue(&queue, start);
+
+    for (uint64_t depth = 0; queue.count > 0; depth++)
+        for (layer = queue.count; layer > 0; layer--)
+        {
+            cell = dequeue(&queue);
+            solution->expanded++;
+            if (cell == end)
+            {
+                solution->solved = true;
+                solution->path_length = depth;
+                free(queue.cells);
+                return;
+            }
+
+            found = neighbours(maze, header, cell, next);
+            for (int k = 0; k < found; k++)
+                if (!VISITED(visited, next[k]))
+                {
+                    VISIT(visited, next[k]);
+                    enqueue(&queue, next[k]);
+                }
+        }
+
+    free(queue.cells);
+    return;
+}
+
+
+/*******************************************************************************************************
+ * solve_astar():    Purpose: A* search with the Manhattan distance to the End, which never            *
+ *                            overestimates on a grid of single steps, so the first time the End       *
+ *                            leaves the frontier its length is a shortest one. The frontier is a      *
+ *                            binary heap in a flat array; a cell may sit in it more than once,        *
+ *                            and later copies are skipped once the cell has been expanded.            *
+ *                   Parameters: const char *maze --> the grid                                         *
+ *                               const struct maze_header *header --> its header                       *
+ *                               uint64_t *visited --> a cleared bit per cell                          *
+ *                               struct solution *solution --> where to store the result               *
+ *                   Return value: none                                                                *
+ *                   Side effects: - modifies *visited and *solution                                   *
+ *                                 - terminates program if memory runs out                             *
+ *******************************************************************************************************/
+void solve_astar(const char *maze, const struct maze_header *header, uint64_t *visited, struct solution *solution)
+// Requires <stdlib.h> for malloc(), realloc(), and free(),
+//  requires "shared.h" for error_check(),
+//  & requires neighbours(), heuristic(), and entry_before()
+{
+    // Variable declarations:
+    uint64_t start = (uint64_t) header->start_y * header->x_dimension + header->start_x;
+    uint64_t end = (uint64_t) header->end_y * header->x_dimension + header->end_x;
+    size_t capacity = FRONTIER_MINIMUM, count = 0, hole, child;
+    struct frontier_entry *heap = malloc(capacity * sizeof(struct frontier_entry)), *grown, top, entry;
+    uint64_t next[4];
+    int found;
+
+    error_check("malloc()", 1, heap != NULL, NULL);
+    heap[count++] = (struct frontier_entry) {heuristic(header, start), 0, start};
+
+    while (count > 0)
+    {
+        // Pop the best entry, sifting the last one down into its place:
+        top = heap[0];
+        entry = heap[--count];
+        for (hole = 0; (child = 2 * hole + 1) < count; hole = child)
+        {
+            if (child + 1 < count && entry_before(&heap[child + 1], &heap[child]))
+                child++;
+            if (!entry_before(&heap[child], &entry))
+                break;
+            heap[hole] = heap[child];
+        }
+        heap[hole] = entry;
+
+        if (VISITED(visited, top.cell))
+            continue;
+        VISIT(visited, top.cell);
+        solution->expanded++;
+        if (top.cell == end)
+        {
+            solution->solved = true;
+            solution->path_length = top.length;
+            break;
+        }
+
+        found = neighbours(maze, header, top.cell, next);
+        for (int k = 0; k < found; k++)
+            if (!VISITED(visited, next[k]))
+            {
+                if (count == capacity)
+                {
+                    grown = realloc(heap, 2 * capacity * sizeof(struct frontier_entry));
+                    error_check("malloc()", 1, grown != NULL, NULL);
+                    heap = grown;
+                    capacity *= 2;
+                }
+                // Push, sifting up:
+                entry = (struct frontier_entry) {top.length + 1 + heuristic(header, next[k]), top.length + 1, next[k]};
+                for (hole = count++; hole > 0 && entry_before(&entry, &heap[(hole - 1) / 2]); hole = (hole - 1) / 2)
+                    heap[hole] = heap[(hole - 1) / 2];
+                heap[hole] = entry;
+            }
+    }
+
+    free(heap);
+    return;
+}
+
+
+/*****************************************************************************************************************
+ * solve_bidirectional():    Purpose: Searches from the Start and the End at once, a corridor at a time, in      *
+ *                                    a maze with no loops. Expanding a junction walks each way out of it        *
+ *                                    but the one it was entered by, cell by cell along the corridor, to         *
+ *                                    the next junction or dead end, and only junctions are queued. With         *
+ *                                    no loops, a walk never reaches a cell its own side has been to, so         *
+ *                                    no cell is marked; and the first walk to touch the other side ends         *
+ *                                    on a junction still in the other side's frontier, so each frontier         *
+ *                                    is indexed by cell and nothing else is kept. The path through a            *
+ *                                    tree is the only one, so its length is the sum of the two sides'           *
+ *                                    distances to that junction.                                                *
+ *                           Parameters: const char *maze --> the grid, with no loops and its edge closed        *
+ *                                                            but for the Start and End                          *
+ *                                       const struct maze_header *header --> its header                         *
+ *                                       struct solution *solution --> where to store the result                 *
+ *                           Return value: none                                                                  *
+ *                           Side effects: - modifies *solution                                                  *
+ *                                         - terminates program if memory runs out                               *
+ *****************************************************************************************************************/
+void solve_bidirectional(const char *maze, const struct maze_header *header, struct solution *solution)
+// Requires <stdlib.h> for malloc() and free(),
+//  requires "shared.h" for error_check(),
+//  & requires end_exits(), push_junction(), pop_junction(), pending_junction(), and index_junctions()
+{
+    // Variable declarations:
+    uint64_t x_dimension = header->x_dimension;
+    uint64_t ends[2] = {(uint64_t) header->start_y * x_dimension + header->start_x,
+                        (uint64_t) header->end_y * x_dimension + header->end_x};
+    const uint64_t step[DIRECTIONS] = {-x_dimension, x_dimension, (uint64_t) -1, 1}; // modulo 2^64
+    struct junction_queue queues[2];
+    struct junction junction;
+    uint64_t cell, length, other_distance;
+    unsigned ways, ahead;
+    int side, way, arrived;
+
+    for (side = 0; side < 2; side++)
+    {
+        queues[side] = (struct junction_queue) {malloc(FRONTIER_MINIMUM * sizeof(struct junction)), FRONTIER_MINIMUM,
+                                                0, 0, NULL, NULL, 0, 0};
+        error_check("malloc()", 1, queues[side].entries != NULL, NULL);
+        index_junctions(&queues[side], 2 * FRONTIER_MINIMUM);
+        push_junction(&queues[side], (struct junction) {ends[side], 0, DIRECTIONS});
+    }
+    solution->solved = ends[0] == ends[1];
+    solution->expanded = 2 - solution->solved;
+
+    while (!solution->solved && queues[0].count > 0 && queues[1].count > 0)
+    {
+        side = queues[0].count <= queues[1].count ? 0 : 1;
+        junction = pop_junction(&queues[side]);
+        ways = junction.cell == ends[0] || junction.cell == ends[1] ? end_exits(maze, header, junction.cell)
+                                                                  : EXITS(maze, junction.cell, x_dimension);
+        if (junction.from < DIRECTIONS)
+            ways &= ~(1u << junction.from);
+
+        for (way = 0; way < DIRECTIONS && !solution->solved; way++)
+        {
+            if (!((ways >> way) & 1))
+                continue;
+
+            // Along the corridor, leaving each cell by the one way it was not entered, to a junction or dead end:
+            cell = junction.cell + step[way];
+            arrived = way ^ 1;
+            ahead = 0;
+            for (length = 1; cell != ends[0] && cell != ends[1]; length++)
+            {
+                ahead = EXITS(maze, cell, x_dimension) & ~(1u << arrived);
+                if (ahead == 0 || (ahead & (ahead - 1)) != 0)
+                    break;
+                cell += step[__builtin_ctz(ahead)];
+                arrived = __builtin_ctz(ahead) ^ 1;
+            }
+            // The junction the searches meet at was counted when the other side reached it:
+            solution->solved = pending_junction(&queues[1 - side], cell, &other_distance);
+            solution->expanded += length - solution->solved;
+            if (solution->solved)
+                solution->path_length = junction.distance + length + other_distance;
+            else if (ahead != 0 || cell == ends[0] || cell == ends[1])
+                push_junction(&queues[side], (struct junction) {cell, junction.distance + length, arrived});
+        }
+    }
+
+    for (side = 0; side < 2; side++)
+    {
+        free(queues[side].entries);
+        free(queues[side].keys);
+        free(queues[side].distances);
+    }
+    return;
+}
+
+
+/**************************************************************************************************************
+ * loop_free():    Purpose: Tells whether a maze can be searched from both ends without visited bits: no      *
+ *                          loop anywhere among its open cells, and the edge of the grid closed but for       *
+ *                          the Start and End. It counts the open cells as it goes. The grid is read a        *
+ *                          row at a time, 64 cells to a word, as runs of open cells; each column open        *
+ *                          in two rows links a run to one in the row above, and the runs joined so           *
+ *                          far are sets in a union-find forest, renamed as they go as in Eller's             *
+ *                          algorithm. A link between two runs already in one set closes a loop.              *
+ *                 Parameters: const char *maze --> the grid                                                  *
+ *                             const struct maze_header *header --> its header                                *
+ *                             uint64_t *open_cells --> where to add the number of open cells                 *
+ *                 Return value: bool --> true if there is no loop and the edge is closed                     *
+ *                 Side effects: - modifies *open_cells                                                       *
+ *                               - terminates program if memory runs out                                      *
+ **************************************************************************************************************/
+bool loop_free(const char *maze, const struct maze_header *header, uint64_t *open_cells)
+// Requires <stdlib.h> for malloc(), calloc(), and free(),
+//  requires <string.h> for memset(),
+//  requires "shared.h" for error_check(),
+//  & requires open_row() and find_run_set()
+{
+    // Variable declarations:
+    uint64_t x_dimension = header->x_dimension, y_dimension = header->y_dimension;
+    uint64_t start = (uint64_t) header->start_y * x_dimension + header->start_x;
+    uint64_t end = (uint64_t) header->end_y * x_dimension + header->end_x;
+    size_t words = (size_t) (x_dimension + 63) / 64, set_capacity = (size_t) x_dimension + 2;
+    // Two of each, for this row and the one above: the open cells and where runs of them start, the runs
+    //  started before each word, and each run's set:
+    uint64_t *open[2] = {calloc(words, sizeof(uint64_t)), calloc(words, sizeof(uint64_t))};
+    uint64_t *starts[2] = {calloc(words, sizeof(uint64_t)), calloc(words, sizeof(uint64_t))};
+    uint32_t *ranks[2] = {calloc(words, sizeof(uint32_t)), calloc(words, sizeof(uint32_t))};
+    uint32_t *labels[2] = {malloc(x_dimension * sizeof(uint32_t)), malloc(x_dimension * sizeof(uint32_t))};
+    uint32_t *sets = malloc(set_capacity * sizeof(uint32_t)), *renamed = malloc(set_capacity * sizeof(uint32_t));
+    uint64_t links, below, carry;
+    uint32_t runs = 0, used = 0, named, run, above, root, other;
+    int now = 0, before = 1;
+    bool forest = true;
+
+    error_check("malloc()", 1, open[0] != NULL && open[1] != NULL && starts[0] != NULL && starts[1] != NULL
+                && ranks[0] != NULL && ranks[1] != NULL && labels[0] != NULL && labels[1] != NULL
+                && sets != NULL && renamed != NULL, NULL);
+
+    for (uint64_t i = 0; i < y_dimension; i++, now ^= 1, before ^= 1)
+    {
+        open_row(maze + i * x_dimension, x_dimension, open[now]);
+        for (size_t w = 0; w < words && (i == 0 || i + 1 == y_dimension); w++)
+            forest = forest && open[now][w] == 0;
+        forest = forest && !(open[now][0] & 1)
+                 && !((open[now][(x_dimension - 1) / 64] >> ((x_dimension - 1) % 64)) & 1);
+        if (start / x_dimension == i)
+            open[now][start % x_dimension / 64] |= (uint64_t) 1 << (start % x_dimension % 64);
+        if (end / x_dimension == i)
+            open[now][end % x_dimension / 64] |= (uint64_t) 1 << (end % x_dimension % 64);
+
+        carry = 0;
+        runs = 0;
+        for (size_t w = 0; w < words; w++)
+        {
+            starts[now][w] = open[now][w] & ~(open[now][w] << 1 | carry);
+            carry = open[now][w] >> 63;
+            ranks[now][w] = runs;
+            runs += (uint32_t) __builtin_popcountll(starts[now][w]);
+            *open_cells += (uint64_t) __builtin_popcountll(open[now][w]);
+        }
+        if (!forest)
+            continue;
+
+        // The run holding a column is the last to start at or before it, in this word or an earlier one:
+        (void) memset(labels[now], 0xFF, runs * sizeof(uint32_t));
+        for (size_t w = 0; w < words && i > 0 && forest; w++)
+            for (links = open[now][w] & open[before][w]; links != 0 && forest; links &= links - 1)
+            {
+                below = ((uint64_t) 2 << __builtin_ctzll(links)) - 1;
+                run = ranks[now][w] + (uint32_t) __builtin_popcountll(starts[now][w] & below) - 1;
+                above = ranks[before][w] + (uint32_t) __builtin_popcountll(starts[before][w] & below) - 1;
+                if (labels[now][run] == NO_SET)
+                    labels[now][run] = labels[before][above];
+                else
+                {
+                    root = find_run_set(sets, labels[now][run]);
+                    other = find_run_set(sets, labels[before][above]);
+                    forest = root != other;
+                    sets[other] = root;
+                }
+            }
+
+        // A new set for each run not joined to one above, renaming the sets in use first if they would run out:
+        if (used + runs > set_capacity)
+        {
+            (void) memset(renamed, 0xFF, used * sizeof(uint32_t));
+            named = 0;
+            for (run = 0; run < runs; run++)
+                if (labels[now][run] != NO_SET)
+                {
+                    root = find_run_set(sets, labels[now][run]);
+                    if (renamed[root] == NO_SET)
+                        renamed[root] = named++;
+                    labels[now][run] = renamed[root];
+                }
+            for (used = 0; used < named; used++)
+                sets[used] = used;
+        }
+        for (run = 0; run < runs; run++)
+        {
+            sets[used] = used;
+            other = labels[now][run] == NO_SET;
+            labels[now][run] = other ? used : labels[now][run];
+            used += other;
+        }
+    }
+
+    for (now = 0; now < 2; now++)
+    {
+        free(open[now]);
+        free(starts[now]);
+        free(ranks[now]);
+        free(labels[now]);
+    }
+    free(sets);
+    free(renamed);
+    return forest;
+}
+
+
+/*************************************************************************************************************
+ * open_row():    Purpose: Sets a bit for each FLOOR in a row of cells, eight cells at a time: XOR           *
+ *                         turns each FLOOR byte to 0, and the carry-free zero-byte test marks               *
+ *                         those bytes' top bits, which one multiply gathers into a byte.                    *
+ *                Parameters: const char *row --> the row's cells                                            *
+ *                            uint64_t x_dimension --> how many there are                                    *
+ *                            uint64_t *open --> where to store the bits, (x_dimension + 63) / 64 words      *
+ *                Return value: none                                                                         *
+ *                Side effects: modifies open[]                                                              *
+ *************************************************************************************************************/
+void open_row(const char *row, uint64_t x_dimension, uint64_t *open)
+// Requires <string.h> for memcpy() and memset(),
+//  & requires "shared.h" for macros
+{
+    // Variable declarations:
+    const uint64_t bytes = 0x0101010101010101ULL, low_bits = 0x7F * bytes;
+    uint64_t k, eight;
+
+    (void) memset(open, 0, (size_t) (x_dimension + 63) / 64 * sizeof(uint64_t));
+    for (k = 0; k + 8 <= x_dimension; k += 8)
+    {
+        (void) memcpy(&eight, row + k, 8); // the first cell in the low byte, on a little-endian machine
+        eight ^= FLOOR * bytes;
+        eight = ~(((eight & low_bits) + low_bits) | eight | low_bits);
+        open[k / 64] |= ((eight >> 7) * 0x0102040810204080ULL) >> 56 << (k % 64);
+    }
+    for (; k < x_dimension; k++)
+        open[k / 64] |= (uint64_t) (row[k] == FLOOR) << (k % 64);
+}
+
+
+/***************************************************************************************************************
+ * find_run_set():    Purpose: Finds the set a run of open cells belongs to, halving the path on the way.      *
+ *                    Parameters: uint32_t *sets --> the union-find forest over the sets                       *
+ *                                uint32_t set --> the run's set, as last named                                *
+ *                    Return value: uint32_t --> the set's root                                                *
+ *                    Side effects: modifies sets[]                                                            *
+ ***************************************************************************************************************/
+uint32_t find_run_set(uint32_t *sets, uint32_t set)
+{
+    while (sets[set] != set)
+    {
+        sets[set] = sets[sets[set]];
+        set = sets[set];
+    }
+    return set;
+}
+
+
+/************************************************************************************************************
+ * end_exits():    Purpose: Lists the directions open from the Start or End, which may lie on the edge      *
+ *                          of the grid, as bits in the order of EXITS().                                   *
+ *                 Parameters: const char *maze --> the grid                                                *
+ *                             const struct maze_header *header --> its header                              *
+ *                             uint64_t cell --> the Start or End                                           *
+ *                 Return value: unsigned --> a bit for each open direction                                 *
+ *                 Side effects: none                                                                       *
+ ************************************************************************************************************/
+unsigned end_exits(const char *maze, const struct maze_header *header, uint64_t cell)
+// Requires neighbours()
+{
+    // Variable declarations:
+    uint64_t next[4];
+    unsigned ways = 0;
+    int found = neighbours(maze, header, cell, next);
+
+    for (int k = 0; k < found; k++)
+        ways |= next[k] + header->x_dimension == cell ? 1u
+                : next[k] == cell + header->x_dimension ? 2u : next[k] + 1 == cell ? 4u : 8u;
+    return ways;
+}
+
+
+/******************************************************************************************************
+ * enqueue():    Purpose: Adds a cell to the back of a breadth-first frontier, doubling the ring      *
+ *                        (and unwrapping it into the new space) when full.                           *
+ *               Parameters: struct cell_queue *queue --> the frontier                                *
+ *                           uint64_t cell --> the cell to add                                        *
+ *               Return value: none                                                                   *
+ *               Side effects: - modifies *queue                                                      *
+ *                             - terminates program if memory runs out                                *
+ ******************************************************************************************************/
+void enqueue(struct cell_queue *queue, uint64_t cell)
+// Requires <stdlib.h> for realloc(),
+//  & requires "shared.h" for error_check()
+{
+    // Variable declarations:
+    uint64_t *grown;
+
+    if (queue->count == queue->capacity)
+    {
+        grown = realloc(queue->cells, 2 * queue->capacity * sizeof(uint64_t));
+        error_check("malloc()", 1, grown != NULL, NULL);
+        queue->cells = grown;
+        for (size_t moved = 0; moved < queue->head; moved++)
+            queue->cells[queue->capacity + moved] = queue->cells[moved];
+        queue->capacity *= 2;
+    }
+    queue->cells[(queue->head + queue->count) & (queue->capacity - 1)] = cell;
+    queue->count++;
+}
+
+
+/****************************************************************************************************
+ * dequeue():    Purpose: Removes the cell at the front of a non-empty breadth-first frontier.      *
+ *               Parameters: struct cell_queue *queue --> the frontier                              *
+ *               Return value: uint64_t --> the cell removed                                        *
+ *               Side effects: modifies *queue                                                      *
+ ****************************************************************************************************/
+uint64_t dequeue(struct cell_queue *queue)
+{
+    // Variable declarations:
+    uint64_t cell = queue->cells[queue->head];
+
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->count--;
+    return cell;
+}
+
+
+/***************************************************************************************************************
+ * push_junction():    Purpose: Adds a junction to the back of a corridor search's frontier, doubling the      *
+ *                              ring when full, and indexes it by cell, first rebuilding the index if         *
+ *                              freed and used slots would fill half of it.                                    *
+ *                     Parameters: struct junction_queue *queue --> the frontier                               *
+ *                                 struct junction junction --> the junction to add                            *
+ *                     Return value: none                                                                      *
+ *                     Side effects: - modifies *queue                                                         *
+ *                                   - terminates program if memory runs out                                   *
+ ***************************************************************************************************************/
+void push_junction(struct junction_queue *queue, struct junction junction)
+// Requires <stdlib.h> for realloc(),
+//  requires "shared.h" for error_check(),
+//  & requires index_junctions()
+{
+    // Variable declarations:
+    struct junction *grown;
+    size_t slot;
+
+    if (2 * (queue->used + 1) > queue->slots)
+        index_junctions(queue, 4 * (queue->count + 1) > queue->slots ? 2 * queue->slots : queue->slots);
+    if (queue->count == queue->capacity)
+    {
+        grown = realloc(queue->entries, 2 * queue->capacity * sizeof(struct junction));
+        error_check("malloc()", 1, grown != NULL, NULL);
+        queue->entries = grown;
+        for (size_t moved = 0; moved < queue->head; moved++)
+            queue->entries[queue->capacity + moved] = queue->entries[moved];
+        queue->capacity *= 2;
+    }
+    queue->entries[(queue->head + queue->count) & (queue->capacity - 1)] = junction;
+    queue->count++;
+
+    for (slot = SLOT(junction.cell, queue->slots); queue->keys[slot] != 0; slot = (slot + 1) & (queue->slots - 1))
+        ;
+    queue->keys[slot] = junction.cell + 1;
+    queue->distances[slot] = junction.distance;
+    queue->used++;
+}
+
+
+/*****************************************************************************************************
+ * pop_junction():    Purpose: Removes the junction at the front of a non-empty corridor search      *
+ *                             frontier, freeing its slot in the index.                              *
+ *                    Parameters: struct junction_queue *queue --> the frontier                      *
+ *                    Return value: struct junction --> the junction removed                         *
+ *                    Side effects: modifies *queue                                                  *
+ *****************************************************************************************************/
+struct junction pop_junction(struct junction_queue *queue)
+{
+    // Variable declarations:
+    struct junction junction = queue->entries[queue->head];
+    size_t slot = SLOT(junction.cell, queue->slots);
+
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->count--;
+    while (queue->keys[slot] != junction.cell + 1)
+        slot = (slot + 1) & (queue->slots - 1);
+    queue->keys[slot] = SLOT_FREED;
+    return junction;
+}
+
+
+/***********************************************************************************************************
+ * pending_junction():    Purpose: Looks a cell up among the junctions waiting in a corridor search's      *
+ *                                 frontier.                                                               *
+ *                        Parameters: const struct junction_queue *queue --> the frontier                  *
+ *                                    uint64_t cell --> the cell                                           *
+ *                                    uint64_t *distance --> where to store its distance, if found         *
+ *                        Return value: bool --> true if the cell is waiting in the frontier               *
+ *                        Side effects: modifies *distance                                                 *
+ ***********************************************************************************************************/
+bool pending_junction(const struct junction_queue *queue, uint64_t cell, uint64_t *distance)
+{
+    for (size_t slot = SLOT(cell, queue->slots); queue->keys[slot] != 0; slot = (slot + 1) & (queue->slots - 1))
+        if (queue->keys[slot] == cell + 1)
+        {
+            *distance = queue->distances[slot];
+            return true;
+        }
+    return false;
+}
+
+
+/*********************************************************************************************************
+ * index_junctions():    Purpose: Rebuilds a corridor search frontier's index from the junctions in      *
+ *                                its ring, dropping the slots freed since the last rebuild.             *
+ *                       Parameters: struct junction_queue *queue --> the frontier                       *
+ *                                   size_t slots --> the index's new size, a power of 2                 *
+ *                       Return value: none                                                              *
+ *                       Side effects: - modifies *queue                                                 *
+ *                                     - terminates program if memory runs out                           *
+ *********************************************************************************************************/
+void index_junctions(struct junction_queue *queue, size_t slots)
+// Requires <stdlib.h> for malloc(), calloc(), and free(),
+//  & requires "shared.h" for error_check()
+{
+    // Variable declarations:
+    struct junction *junction;
+    size_t slot;
+
+    free(queue->keys);
+    free(queue->distances);
+    queue->keys = calloc(slots, sizeof(uint64_t));
+    queue->distances = malloc(slots * sizeof(uint64_t));
+    error_check("malloc()", 1, queue->keys != NULL && queue->distances != NULL, NULL);
+    queue->slots = slots;
+    queue->used = queue->count;
+
+    for (size_t k = 0; k < queue->count; k++)
+    {
+        junction = &queue->entries[(queue->head + k) & (queue->capacity - 1)];
+        for (slot = SLOT(junction->cell, slots); queue->keys[slot] != 0; slot = (slot + 1) & (slots - 1))
+            ;
+        queue->keys[slot] = junction->cell + 1;
+        queue->distances[slot] = junction->distance;
+    }
+}
+
+
+
+/********************************************************************************************************
+ * load_distance_field():    Purpose: Reads a distance field from its cache, if the cache exists,       *
+ *                                    is complete, and was made from this maze file as it is now.       *
+ *                           Parameters: const char *cache_filename --> the cache's filename            *
+ *                                       FILE *maze_file --> the maze's file                            *
+ *                                       const struct maze_header *header --> the maze's header         *
+ *                                       struct distance_field *field --> where to store the field      *
+ *                           Return value: bool --> true if the field was loaded                        *
+ *                           Side effects: - modifies *field                                            *
+ *                                         - terminates program if memory runs out                      *
+ ********************************************************************************************************/
+bool load_distance_field(const char *cache_filename, FILE *maze_file, const struct maze_header *header,
+                         struct distance_field *field)
+// Requires <stdio.h> for the type "FILE *" and fopen(), fclose(), fread(), and fgetc(),
+//  requires <stdlib.h> for calloc() and free(),
+//  requires <string.h> for memcmp(),
+//  requires "shared.h" for error_check(),
+//  requires "maze_file.h" for get_u64(),
+//  & requires fingerprint_maze()
+{
+    // Variable declarations:
+    uint64_t cells = (uint64_t) header->y_dimension * header->x_dimension;
+    uint8_t expected[CACHE_HEADER_SIZE], found[CACHE_HEADER_SIZE];
+    FILE *cache_file = fopen(cache_filename, "rb");
+    bool loaded;
+
+    if (cache_file == NULL)
+        return false;
+    *field = (struct distance_field) {calloc(FIELD_BYTES(cells), 1), header->x_dimension, cells, false, 0};
+    error_check("malloc()", 1, field->steps != NULL, NULL);
+
+    // The reachability flag and the Start's distance are the only fields not fixed by the maze file:
+    fingerprint_maze(maze_file, header, field, expected);
+    loaded = fread(found, 1, CACHE_HEADER_SIZE, cache_file) == CACHE_HEADER_SIZE
+             && memcmp(found, expected, 5) == 0 && memcmp(found + 6, expected + 6, 34) == 0
+             && fread(field->steps, 1, FIELD_BYTES(cells), cache_file) == FIELD_BYTES(cells)
+             && fgetc(cache_file) == EOF;
+    (void) fclose(cache_file);
+    if (!loaded)
+    {
+        free_distance_field(field);
+        return false;
+    }
+    field->reachable = found[5] != 0;
+    field->start_distance = get_u64(found + 40);
+    return true;
+}
+
+
+/**********************************************************************************************************
+ * save_distance_field():    Purpose: Writes a distance field to its cache, for the next load of the      *
+ *                                    same maze file. The cache is only an optimization, so a             *
+ *                                    failure to write it is ignored (and a partial cache is              *
+ *                                    rejected on loading).                                               *
+ *                           Parameters: const char *cache_filename --> the cache's filename              *
+ *                                       FILE *maze_file --> the maze's file                              *
+ *                                       const struct maze_header *header --> the maze's header           *
+ *                                       const struct distance_field *field --> the field                 *
+ *                           Return value: none                                                           *
+ *                           Side effects: creates or overwrites the cache file                           *
+ **********************************************************************************************************/
+void save_distance_field(const char *cache_filename, FILE *maze_file, const struct maze_header *header,
+                         const struct distance_field *field)
+// Requires <stdio.h> for the type "FILE *" and fopen(), fclose(), and fwrite(),
+//  & requires fingerprint_maze()
+{
+    // Variable declarations:
+    uint8_t bytes[CACHE_HEADER_SIZE];
+    FILE *cache_file = fopen(cache_filename, "wb");
+
+    if (cache_file == NULL)
+        return;
+    fingerprint_maze(maze_file, header, field, bytes);
+    (void) fwrite(bytes, 1, CACHE_HEADER_SIZE, cache_file);
+    (void) fwrite(field->steps, 1, FIELD_BYTES(field->cells), cache_file);
+    (void) fclose(cache_file);
+}
+
+
+/*********************************************************************************************************
+ * fingerprint_maze():    Purpose: Fills in a distance cache header. It names the maze by its            *
+ *                                 dimensions and End, and its file by size and modification time,       *
+ *                                 so that a cache outlives neither an edit nor a regeneration.          *
+ *                        Parameters: FILE *maze_file --> the maze's file                                *
+ *                                    const struct maze_header *header --> the maze's header             *
+ *                                    const struct distance_field *field --> the field                   *
+ *                                    uint8_t *bytes --> where to store the CACHE_HEADER_SIZE bytes      *
+ *                        Return value: none                                                             *
+ *                        Side effects: modifies *bytes                                                  *
+ *********************************************************************************************************/
+void fingerprint_maze(FILE *maze_file, const struct maze_header *header, const struct distance_field *field,
+                      uint8_t *bytes)
+// Requires <stdio.h> for fileno(),
+//  requires <string.h> for memcpy() and memset(),
+//  requires <sys/stat.h> for fstat() and "struct stat",
+//  & requires "maze_file.h" for put_u16(), put_u32(), and put_u64()
+{
+    // Variable declarations:
+    struct stat status;
+
+    if (fstat(fileno(maze_file), &status) != 0)
+        (void) memset(&status, 0, sizeof(status));
+
+    (void) memcpy(bytes, CACHE_MAGIC, CACHE_MAGIC_SIZE);
+    bytes[4] = CACHE_VERSION;
+    bytes[5] = field->reachable;
+    put_u16(bytes + 6, CACHE_HEADER_SIZE);
+    put_u32(bytes + 8, header->x_dimension);
+    put_u32(bytes + 12, header->y_dimension);
+    put_u32(bytes + 16, header->end_x);
+    put_u32(bytes + 20, header->end_y);
+    put_u64(bytes + 24, (uint64_t) status.st_size);
+    put_u64(bytes + 32, (uint64_t) status.st_mtim.tv_sec * 1000000000 + (uint64_t) status.st_mtim.tv_nsec);
+    put_u64(bytes + 40, field->start_distance);
+}
+
+
+/**********************************************************************************************************
+ * neighbours():    Purpose: Lists the passable cells one step from a cell. Cells on the edge of the      *
+ *                           grid are never stepped off, even in a file whose border is damaged.          *
+ *                  Parameters: const char *maze --> the grid                                             *
+ *                              const struct maze_header *header --> its header                           *
+ *                              uint64_t cell --> the cell, as a row-major index                          *
+ *                              uint64_t *next --> where to store up to four neighbours                   *
+ *                  Return value: int --> how many neighbours were stored                                 *
+ *                  Side effects: modifies next[]                                                         *
+ **********************************************************************************************************/
+int neighbours(const char *maze, const struct maze_header *header, uint64_t cell, uint64_t *next)
+// Requires "shared.h" for macros
+{
+    // Variable declarations:
+    uint64_t x_dimension = header->x_dimension, j = cell % x_dimension;
+    uint64_t cells = x_dimension * header->y_dimension;
+    int found = 0;
+
+    if (cell >= x_dimension && PASSABLE(maze[cell - x_dimension]))
+        next[found++] = cell - x_dimension;
+    if (cell + x_dimension < cells && PASSABLE(maze[cell + x_dimension]))
+        next[found++] = cell + x_dimension;
+    if (j > 0 && PASSABLE(maze[cell - 1]))
+        next[found++] = cell - 1;
+    if (j + 1 < x_dimension && PASSABLE(maze[cell + 1]))
+        next[found++] = cell + 1;
+    return found;
+}
+
+
+/*******************************************************************************************
+ * heuristic():    Purpose: Manhattan distance from a cell to the End.                     *
+ *                 Parameters: const struct maze_header *header --> the maze's header      *
+ *                             uint64_t cell --> the cell, as a row-major index            *
+ *                 Return value: uint64_t --> the distance in steps                        *
+ *                 Side effects: none                                                      *
+ *******************************************************************************************/
+uint64_t heuristic(const struct maze_header *header, uint64_t cell)
+{
+    // Variable declarations:
+    uint64_t i = cell / header->x_dimension, j = cell % header->x_dimension;
+
+    return DISTANCE(i, (uint64_t) header->end_y) + DISTANCE(j, (uint64_t) header->end_x);
+}
+
+
+/**********************************************************************************************************
+ * entry_before():    Purpose: Orders the A* frontier: the shorter estimate first and, between equal      *
+ *                             estimates, the longer path so far, which is the closer to the End.         *
+ *                    Parameters: const struct frontier_entry *a, *b --> the entries to compare           *
+ *                    Return value: bool --> true if a should leave the frontier before b                 *
+ *                    Side effects: none                                                                  *
+ **********************************************************************************************************/
+bool entry_before(const struct frontier_entry *a, const struct frontier_entry *b)
+// Requires <stdbool.h> for the type "bool"
+{
+    return a->estimate < b->estimate || (a->estimate == b->estimate && a->length > b->length);
+}
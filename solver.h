@@ -0,0 +1,56 @@
+/****************************************************************************************************
+ * Name: solver.h                                                                                   *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for solver.c                                                                *
+ ****************************************************************************************************/
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stdbool.h> // for the type "bool"
+#include <stdint.h> // for the types "uint8_t" and "uint64_t"
+#include "maze_file.h" // for "struct maze_header"
+
+/* Object-Like Macros */
+// Search methods:
+#define SOLVER_BFS 0 // breadth-first, a layer of equal distance at a time
+#define SOLVER_ASTAR 1 // best-first on distance so far plus Manhattan distance to the End
+#define SOLVER_BIDIRECTIONAL 2 // from the Start and the End at once, a corridor at a time, if the maze has no loops
+// Distance fields:
+#define DISTANCE_CACHE_SUFFIX ".dist" // appended to a maze's filename to name its distance cache
+#define DISTANCE_CACHE_MINIMUM (1 << 20) // cells below which a field is rebuilt rather than cached
+
+/* Structures */
+struct solution
+{
+    bool solved; // whether the End can be reached from the Start
+    uint64_t path_length; // steps on a shortest path from Start to End
+    uint64_t expanded; // cells whose neighbours were examined before the End was reached
+    uint64_t open_cells; // cells a player could stand on, for scale
+    int method; // the SOLVER_ macro used: SOLVER_BFS for a bidirectional search of a maze with loops
+};
+
+// Every cell's distance to the End, modulo 4, in 2 bits (4 cells a byte). A grid's neighbours always lie
+//  one step nearer or one step further, so the residue alone tells them apart; the absolute distance is
+//  carried by whoever walks the field, starting from start_distance.
+struct distance_field
+{
+    uint8_t *steps;
+    uint64_t x_dimension;
+    uint64_t cells;
+    bool reachable; // whether the End can be reached from the Start
+    uint64_t start_distance; // steps from the Start to the End, when reachable
+};
+
+/* Function Prototypes */
+void solve_maze(const char *maze, const struct maze_header *header, int method, struct solution *solution);
+void open_distance_field(const char *maze, const struct maze_header *header, FILE *maze_file,
+                         const char *maze_filename, struct distance_field *field);
+void build_distance_field(const char *maze, const struct maze_header *header, struct distance_field *field);
+uint64_t next_step(const char *maze, const struct distance_field *field, uint64_t cell, uint64_t distance);
+uint64_t step_distance(const struct distance_field *field, uint64_t distance, uint64_t cell);
+void free_distance_field(struct distance_field *field);
+
+#endif
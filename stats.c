@@ -0,0 +1,131 @@
+/****************************************************************************************************
+ * Name: stats.c                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Implements clearing, merging, and reporting the counters and phase timers kept while    *
+ *          generating, and the clock they are timed with.                                          *
+ ****************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L // for clock_gettime() under -std=c99
+#include <stdio.h> // for the type "FILE *" and fprintf()
+#include <string.h> // for memset()
+#include <time.h> // for clock_gettime()
+#include "stats.h" // for "struct generation_stats" and macros
+
+/*************************************************************************************************
+ * stats_clear():    Purpose: Zeroes every counter and timer.                                    *
+ *                   Parameters: struct generation_stats *stats --> the statistics to clear      *
+ *                   Return value: none                                                          *
+ *                   Side effects: modifies *stats                                               *
+ *************************************************************************************************/
+void stats_clear(struct generation_stats *stats)
+// Requires <string.h> for memset(),
+//  & requires "stats.h" for "struct generation_stats"
+{
+    (void) memset(stats, 0, sizeof(struct generation_stats));
+}
+
+
+/*********************************************************************************************************
+ * stats_merge():    Purpose: Adds one set of statistics into another (a tile's into its maze's, or      *
+ *                            a maze's into a batch's).                                                  *
+ *                   Parameters: struct generation_stats *into --> the statistics to add to              *
+ *                               const struct generation_stats *from --> the statistics to add           *
+ *                   Return value: none                                                                  *
+ *                   Side effects: modifies *into                                                        *
+ *********************************************************************************************************/
+void stats_merge(struct generation_stats *into, const struct generation_stats *from)
+// Requires "stats.h" for "struct generation_stats" and macros
+{
+    into->mazes += from->mazes;
+    into->find_move_calls += from->find_move_calls;
+    into->dead_end_passes += from->dead_end_passes;
+    into->dead_end_carves += from->dead_end_carves;
+    for (int k = 0; k < STATS_PASSES; k++)
+        into->pass_carves[k] += from->pass_carves[k];
+    into->critical_path_length += from->critical_path_length;
+    into->bytes_written += from->bytes_written;
+    into->bytes_read += from->bytes_read;
+    into->border_s += from->border_s;
+    into->critical_path_s += from->critical_path_s;
+    into->dead_ends_s += from->dead_ends_s;
+    into->write_s += from->write_s;
+    into->read_s += from->read_s;
+    into->total_s += from->total_s;
+}
+
+
+/******************************************************************************************
+ * stats_clock():    Purpose: Reads a monotonic clock, for the phase timers.              *
+ *                   Parameters: none                                                     *
+ *                   Return value: double --> seconds since an arbitrary fixed point      *
+ *                   Side effects: none                                                   *
+ ******************************************************************************************/
+double stats_clock(void)
+// Requires <time.h> for clock_gettime() and "struct timespec"
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/******************************************************************************************************
+ * stats_report():    Purpose: Prints statistics as lines of text or as one JSON object. If they      *
+ *                             were compiled out, says so instead.                                    *
+ *                    Parameters: FILE *stream --> where to print them                                *
+ *                                const struct generation_stats *stats --> the statistics             *
+ *                                int format --> STATS_TEXT or STATS_JSON                             *
+ *                    Return value: none                                                              *
+ *                    Side effects: prints to stream                                                  *
+ ******************************************************************************************************/
+void stats_report(FILE *stream, const struct generation_stats *stats, int format)
+// Requires <stdio.h> for the type "FILE *" and fprintf(),
+//  & requires "stats.h" for "struct generation_stats" and macros
+{
+    // Variable declarations:
+    int passes = stats->dead_end_passes < STATS_PASSES ? (int) stats->dead_end_passes : STATS_PASSES;
+    double mazes = stats->mazes > 0 ? (double) stats->mazes : 1;
+
+#ifdef MAZE_NO_STATS
+    if (format == STATS_JSON)
+        (void) fprintf(stream, "{\"enabled\": false}\n");
+    else
+        (void) fprintf(stream, "Statistics: not kept (built with MAZE_NO_STATS)\n");
+    return;
+#endif
+
+    if (format == STATS_JSON)
+    {
+        (void) fprintf(stream, "{\"enabled\": true, \"mazes\": %llu, \"find_move_calls\": %llu, "
+                               "\"dead_end_passes\": %llu, \"dead_end_carves\": %llu, \"pass_carves\": [",
+                       (unsigned long long) stats->mazes, (unsigned long long) stats->find_move_calls,
+                       (unsigned long long) stats->dead_end_passes, (unsigned long long) stats->dead_end_carves);
+        for (int k = 0; k < passes; k++)
+            (void) fprintf(stream, "%s%llu", k > 0 ? ", " : "", (unsigned long long) stats->pass_carves[k]);
+        (void) fprintf(stream, "], \"critical_path_length\": %llu, \"bytes_written\": %llu, \"bytes_read\": %llu, "
+                               "\"seconds\": {\"border\": %.6f, \"critical_path\": %.6f, \"dead_ends\": %.6f, "
+                               "\"write\": %.6f, \"read\": %.6f, \"total\": %.6f}}\n",
+                       (unsigned long long) stats->critical_path_length, (unsigned long long) stats->bytes_written,
+                       (unsigned long long) stats->bytes_read, stats->border_s, stats->critical_path_s,
+                       stats->dead_ends_s, stats->write_s, stats->read_s, stats->total_s);
+        return;
+    }
+
+    (void) fprintf(stream, "Statistics for %llu mazes:\n", (unsigned long long) stats->mazes);
+    (void) fprintf(stream, "  find_move():        %llu calls (%.0f per maze)\n",
+                   (unsigned long long) stats->find_move_calls, stats->find_move_calls / mazes);
+    (void) fprintf(stream, "  dead ends:          %llu passes, %llu carves%s",
+                   (unsigned long long) stats->dead_end_passes, (unsigned long long) stats->dead_end_carves,
+                   passes > 0 ? "; first passes:" : "");
+    for (int k = 0; k < passes; k++)
+        (void) fprintf(stream, " %llu", (unsigned long long) stats->pass_carves[k]);
+    (void) fprintf(stream, "\n  critical path:      %llu steps (%.0f per maze)\n",
+                   (unsigned long long) stats->critical_path_length, stats->critical_path_length / mazes);
+    (void) fprintf(stream, "  bytes:              %llu written, %llu read\n", (unsigned long long) stats->bytes_written,
+                   (unsigned long long) stats->bytes_read);
+    (void) fprintf(stream, "  seconds:            border %.6f, critical path %.6f, dead ends %.6f, write %.6f,"
+                           " read %.6f, total %.6f\n", stats->border_s, stats->critical_path_s, stats->dead_ends_s,
+                   stats->write_s, stats->read_s, stats->total_s);
+}
@@ -0,0 +1,58 @@
+/****************************************************************************************************
+ * Name: stats.h                                                                                    *
+ * Date created: 2026-10-16                                                                         *
+ * Author: Ryan Wells                                                                               *
+ * Purpose: Header file for stats.c. The counting macros cost one add each; building with           *
+ *          -DMAZE_NO_STATS turns them (and the clock reads) into nothing.                          *
+ ****************************************************************************************************/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h> // for the type "FILE *"
+#include <stdint.h> // for the type "uint64_t"
+
+/* Object-Like Macros */
+#define STATS_PASSES 16 // dead-end passes whose carves are recorded one by one
+// Report formats:
+#define STATS_NONE -1 // no report wanted
+#define STATS_TEXT 0
+#define STATS_JSON 1
+
+/* Parameterized Macros */
+// Adds to a counter, notes the wall time since a STATS_CLOCK() reading, or reads the clock:
+// (With MAZE_NO_STATS, the arguments are still evaluated, once, so nothing they name goes unused.)
+#ifndef MAZE_NO_STATS
+#define STATS_COUNT(stats, counter, amount) ((stats)->counter += (amount))
+#define STATS_TIME(stats, phase, since) ((stats)->phase += stats_clock() - (since))
+#define STATS_CLOCK() stats_clock()
+#else
+#define STATS_COUNT(stats, counter, amount) ((void) (amount))
+#define STATS_TIME(stats, phase, since) ((void) (since))
+#define STATS_CLOCK() 0.0
+#endif
+
+/* Structures */
+// What generation (and, in the game, reading) spent its time on. Tiles are counted in full, so
+// on several threads their phase times add up to more than the wall time of the whole maze.
+struct generation_stats
+{
+    uint64_t mazes; // mazes generated (or, when verifying, read)
+    uint64_t find_move_calls;
+    uint64_t dead_end_passes;
+    uint64_t dead_end_carves;
+    uint64_t pass_carves[STATS_PASSES]; // carves in each of the first passes, summed over mazes
+    uint64_t critical_path_length; // steps taken from the Start to the End
+    uint64_t bytes_written;
+    uint64_t bytes_read;
+    // Wall time of each phase (Eller's algorithm writes as it goes, so only counts towards total_s):
+    double border_s, critical_path_s, dead_ends_s, write_s, read_s, total_s;
+};
+
+/* Function Prototypes */
+void stats_clear(struct generation_stats *stats);
+void stats_merge(struct generation_stats *into, const struct generation_stats *from);
+double stats_clock(void);
+void stats_report(FILE *stream, const struct generation_stats *stats, int format);
+
+#endif